@@ -9,6 +9,7 @@
  */
 
 import axios, { AxiosInstance, AxiosError } from "axios";
+import { createHash } from "crypto";
 import { z } from "zod";
 
 // ============================================================================
@@ -27,6 +28,7 @@ const HeartbeatResponseSchema = z.object({
   hardware_id: z.string(),
   signature: z.string(),
   algorithm: z.string(),
+  sequence: z.string().optional(), // u64 signed with the payload
   resin_remaining: z.number(),
   mode: z.enum(["ECO", "TURBO"]).optional(),
 });
@@ -35,6 +37,7 @@ const SignResponseSchema = z.object({
   signed: z.boolean(),
   signature: z.string(),
   algorithm: z.string(),
+  sequence: z.string().optional(),
   amount_sol: z.number(),
   daily_remaining_sol: z.number(),
 });
@@ -62,6 +65,31 @@ const StatusResponseSchema = z.object({
   clawhub: z.string(),
 });
 
+const SkillVerifyResultSchema = z.object({
+  valid: z.boolean(),
+  content_hash: z.string().optional(),
+  cached: z.boolean().optional(),
+  error: z.string().optional(),
+});
+
+const SkillBatchResponseSchema = z.object({
+  results: z.array(SkillVerifyResultSchema),
+  valid: z.number(),
+  total: z.number(),
+});
+
+const PolicyEvaluationSchema = z.object({
+  allowed: z.boolean(),
+  reason: z.string().optional(), // POLICY_VIOLATION, AGENT_DEAD, ...
+  remaining_sol: z.number().optional(),
+});
+
+const PolicyEvaluateResponseSchema = z.object({
+  results: z.array(PolicyEvaluationSchema),
+  allowed: z.number(),
+  total: z.number(),
+});
+
 const ErrorResponseSchema = z.object({
   error: z.string(),
   message: z.string(),
@@ -75,8 +103,16 @@ const ErrorResponseSchema = z.object({
 export type HeartbeatResponse = z.infer<typeof HeartbeatResponseSchema>;
 export type SignResponse = z.infer<typeof SignResponseSchema>;
 export type StatusResponse = z.infer<typeof StatusResponseSchema>;
+export type SkillVerifyResult = z.infer<typeof SkillVerifyResultSchema>;
+export type PolicyEvaluation = z.infer<typeof PolicyEvaluationSchema>;
 export type HeartbeatMode = "ECO" | "TURBO";
 
+export interface SkillBundle {
+  code: string;
+  signature: string; // Base64 Ed25519 signature over code
+  developerKey: string; // "Prefix:ed25519:base64key"
+}
+
 export interface SignTransactionRequest {
   tx: string; // Base64-encoded transaction
   amount: number; // Amount in SOL
@@ -138,6 +174,8 @@ export interface KytinClientConfig {
   host?: string;
   port?: number;
   timeout?: number;
+  /** Sent as X-Kytin-Client; the Sentinel rate-limits per client */
+  clientId?: string;
 }
 
 /**
@@ -174,6 +212,7 @@ export class KytinClient {
       timeout: config.timeout || 10000,
       headers: {
         "Content-Type": "application/json",
+        ...(config.clientId ? { "X-Kytin-Client": config.clientId } : {}),
       },
     });
   }
@@ -215,6 +254,84 @@ export class KytinClient {
     }
   }
 
+  /**
+   * Ask which candidate transactions /sign would accept right now, without
+   * signing anything or using up the daily allowance
+   *
+   * @param cumulative - Judge in order, as if each allowed one were signed
+   * @returns Per-candidate results, in input order
+   */
+  async evaluatePolicy(
+    candidates: Array<number | SignTransactionRequest>,
+    cumulative = false,
+  ): Promise<PolicyEvaluation[]> {
+    try {
+      const response = await this.client.post("/policy/evaluate", {
+        items: candidates,
+        cumulative,
+      });
+      return PolicyEvaluateResponseSchema.parse(response.data).results;
+    } catch (error) {
+      throw this.handleError(error);
+    }
+  }
+
+  /**
+   * Verify a skill bundle's signature in the Sentinel
+   *
+   * Sends only the code's SHA-256 first; the code itself is uploaded only
+   * if the Sentinel has not verified this bundle before.
+   *
+   * @throws {KytinError} - UNTRUSTED_SOURCE, SIGNATURE_INVALID, ...
+   */
+  async verifySkill(skill: SkillBundle): Promise<SkillVerifyResult> {
+    const contentHash = createHash("sha256").update(skill.code).digest("hex");
+    try {
+      const response = await this.client.post("/verify-skill", {
+        content_hash: contentHash,
+        signature: skill.signature,
+        developer_key: skill.developerKey,
+      });
+      return SkillVerifyResultSchema.parse(response.data);
+    } catch (error) {
+      if (!axios.isAxiosError(error) || error.response?.status !== 404) {
+        throw this.handleError(error);
+      }
+    }
+
+    try {
+      const response = await this.client.post("/verify-skill", {
+        code: skill.code,
+        signature: skill.signature,
+        developer_key: skill.developerKey,
+      });
+      return SkillVerifyResultSchema.parse(response.data);
+    } catch (error) {
+      throw this.handleError(error);
+    }
+  }
+
+  /**
+   * Verify every bundle of a skill directory in one request (warms the
+   * Sentinel's cache so later verifySkill() calls are hash-only)
+   *
+   * @returns Per-bundle results, in input order
+   */
+  async verifySkills(skills: SkillBundle[]): Promise<SkillVerifyResult[]> {
+    try {
+      const response = await this.client.post("/verify-skill", {
+        skills: skills.map((skill) => ({
+          code: skill.code,
+          signature: skill.signature,
+          developer_key: skill.developerKey,
+        })),
+      });
+      return SkillBatchResponseSchema.parse(response.data).results;
+    } catch (error) {
+      throw this.handleError(error);
+    }
+  }
+
   /**
    * Get Sentinel status and health information
    */
@@ -280,6 +397,12 @@ export class KytinClient {
 
       // 403 Forbidden = Policy violation or Daily limit
       if (status === 403) {
+        if (
+          data?.error === "UNTRUSTED_SOURCE" ||
+          data?.error === "SIGNATURE_INVALID"
+        ) {
+          return new KytinError(data.message, data.error, status);
+        }
         if (data?.error === "POLICY_VIOLATION") {
           return new DailyLimitExceededError(data.message);
         }
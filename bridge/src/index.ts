@@ -29,6 +29,8 @@ export {
   type HeartbeatMode,
   type KytinClientConfig,
   type SignTransactionRequest,
+  type SkillBundle,
+  type SkillVerifyResult,
 } from './client';
 
 // ============================================================================
@@ -67,6 +67,14 @@ export interface DeadAgentError {
 
 export type AgentState = 'online' | 'offline' | 'dead';
 
+export type SentinelEventType = 'heartbeat' | 'sign' | 'resin' | 'soul_transfer' | 'overrun';
+
+export interface SentinelEvent {
+  id?: string;
+  type: SentinelEventType;
+  data: Record<string, unknown>;
+}
+
 // ============================================================================
 // API CLIENT
 // ============================================================================
@@ -148,6 +156,26 @@ export class KytinAPI {
     return res.json();
   }
 
+  /**
+   * Subscribe to the Sentinel's /events stream (Server-Sent Events).
+   * The browser reconnects automatically and resumes from Last-Event-ID.
+   * On 'overrun' events were missed; refetch /status to resync.
+   * Returns a function that closes the stream.
+   */
+  subscribe(onEvent: (event: SentinelEvent) => void): () => void {
+    const source = new EventSource(`${this.baseUrl}/events`);
+    const types: SentinelEventType[] = ['heartbeat', 'sign', 'resin', 'soul_transfer', 'overrun'];
+
+    for (const type of types) {
+      source.addEventListener(type, (e) => {
+        const msg = e as MessageEvent<string>;
+        onEvent({ id: msg.lastEventId || undefined, type, data: JSON.parse(msg.data) });
+      });
+    }
+
+    return () => source.close();
+  }
+
   /**
    * Check if Sentinel is reachable
    */
@@ -154,6 +154,8 @@ namespace http {
     constexpr int BAD_REQUEST = 400;
     constexpr int PAYMENT_REQUIRED = 402;  // No Resin!
     constexpr int FORBIDDEN = 403;
+    constexpr int REQUEST_TIMEOUT = 408;
+    constexpr int PAYLOAD_TOO_LARGE = 413;
     constexpr int LIMIT_EXCEEDED = 429;
 }
 
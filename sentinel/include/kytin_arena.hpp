@@ -0,0 +1,111 @@
+/*
+ * Kytin Protocol - Per-Request Memory Arena
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ *
+ * A signing request's transient memory (request body, parsed JSON, signing
+ * buffer, base64 text, response DOM and its serialization) comes from a
+ * std::pmr::monotonic_buffer_resource owned by the worker thread. Nothing
+ * is freed piecemeal: when the request's outermost Scope closes, the arena
+ * is released in one step and its initial buffer is reused by the thread's
+ * next request.
+ *
+ *   RequestArena::Scope scope;      // open for the whole request
+ *   ArenaString body;               // grows inside this thread's arena
+ *
+ * ArenaAllocator is stateless: it allocates from whichever arena is current
+ * on the calling thread, or from the heap outside any Scope. A container
+ * that uses it must therefore be created and destroyed on one thread,
+ * inside one Scope or entirely outside any (in practice: a local of the
+ * request). Anything that outlives the request uses std::allocator.
+ */
+
+#ifndef KYTIN_ARENA_HPP
+#define KYTIN_ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace kytin {
+
+/**
+ * In-place buffer of each thread's arena, allocated once per thread. A
+ * heartbeat or sign round trip fits in a fraction of it; larger requests
+ * spill into heap chunks that are returned when the request ends.
+ */
+constexpr size_t ARENA_INITIAL_BYTES = 16384;
+
+/**
+ * @brief Thread-local monotonic arenas, recycled per request
+ */
+class RequestArena {
+public:
+    /**
+     * @brief Makes this thread's arena current until destroyed
+     *
+     * Scopes nest; only the outermost one releases the arena.
+     */
+    class Scope {
+    public:
+        Scope();
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    /**
+     * @brief This thread's arena while a Scope is open, else the default
+     * (heap) resource
+     */
+    static std::pmr::memory_resource* resource();
+
+    struct Stats {
+        uint64_t requests = 0;          // Outermost scopes closed
+        uint64_t allocations = 0;       // Served by arenas
+        uint64_t bytes = 0;
+        uint64_t heap_chunks = 0;       // Arena growth beyond the buffer
+        uint64_t peak_bytes = 0;        // Largest single request
+    };
+    static Stats stats();
+};
+
+/**
+ * @brief Standard allocator over RequestArena::resource()
+ *
+ * Default-constructible, so it also fits containers that cannot carry
+ * allocator state (nlohmann::basic_json's AllocatorType).
+ */
+template <typename T>
+struct ArenaAllocator {
+    using value_type = T;
+
+    ArenaAllocator() = default;
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(
+            RequestArena::resource()->allocate(n * sizeof(T), alignof(T)));
+    }
+    void deallocate(T* p, size_t n) {
+        RequestArena::resource()->deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>&) const { return true; }
+};
+
+using ArenaString =
+    std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+using ArenaBytes = std::vector<uint8_t, ArenaAllocator<uint8_t>>;
+
+} // namespace kytin
+
+#endif // KYTIN_ARENA_HPP
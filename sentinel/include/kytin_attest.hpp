@@ -0,0 +1,150 @@
+/*
+ * Kytin Protocol - Batched TPM Attestation
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ *
+ * Proves to remote verifiers that the Sentinel's key lives in a TPM. A
+ * TPM2_Quote takes tens of milliseconds and holds the TPM, so verifiers are
+ * not quoted one by one: nonces arriving within `batch_window_ms` become
+ * the leaves of a Merkle tree and a single quote covers its root.
+ *
+ *   leaf = SHA-256(0x00 || nonce)
+ *   node = SHA-256(0x01 || left || right)    (odd node moves up unchanged)
+ *
+ * Each verifier receives the quote, the root (the quote's extraData) and
+ * the sibling hashes from its leaf up to the root, so it can check that its
+ * own nonce is covered without seeing anyone else's.
+ */
+
+#ifndef KYTIN_ATTEST_HPP
+#define KYTIN_ATTEST_HPP
+
+#include "kytin_sha256.hpp"
+#include "kytin_tpm.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace kytin {
+
+class SentinelCore;
+
+struct AttestOptions {
+    uint32_t batch_window_ms = 20;      // Collect nonces this long per quote
+    uint32_t max_batch = 1024;          // Quote early once this many wait
+    uint32_t freshness_s = 30;          // Max age of the cached quote
+};
+
+// ============================================================================
+// MERKLE TREE
+// ============================================================================
+
+struct MerkleStep {
+    Sha256::Digest sibling;
+    bool sibling_left;                  // Sibling is hashed first
+};
+
+Sha256::Digest merkle_leaf(const std::vector<uint8_t>& nonce);
+
+/**
+ * @brief Recompute the root from a leaf and its path
+ */
+Sha256::Digest merkle_fold(const Sha256::Digest& leaf,
+                           const std::vector<MerkleStep>& path);
+
+// ============================================================================
+// ATTESTOR
+// ============================================================================
+
+/**
+ * @brief Coalesces verifier nonces into one TPM quote per batch window
+ *
+ * The first nonce of a batch makes its caller the leader: it waits out the
+ * window (or until `max_batch` nonces are queued), builds the tree and
+ * quotes the root while later callers wait on the result. Thread-safe.
+ */
+class Attestor {
+public:
+    struct Evidence {
+        TPMInterface::Quote quote;
+        Sha256::Digest root;            // Quote's qualifying data
+        uint64_t quoted_unix = 0;
+    };
+
+    struct Proof {
+        std::shared_ptr<const Evidence> evidence;
+        Sha256::Digest leaf;
+        std::vector<MerkleStep> path;   // Leaf to root
+        uint32_t index = 0;             // Leaf position in the batch
+        uint32_t batch_size = 0;
+    };
+
+    explicit Attestor(SentinelCore& core);
+
+    Attestor(const Attestor&) = delete;
+    Attestor& operator=(const Attestor&) = delete;
+
+    /**
+     * @brief Quote covering `nonce` (blocks for up to one batch window
+     *        plus the quote itself)
+     * @return nullopt if the TPM is not ready or the quote failed
+     */
+    std::optional<Proof> attest(const std::vector<uint8_t>& nonce,
+                                std::string* error = nullptr);
+
+    /**
+     * @brief Latest quote if younger than `freshness_s`, else a new one
+     *
+     * For callers that only need recent evidence, not their own nonce.
+     */
+    std::shared_ptr<const Evidence> latest(std::string* error = nullptr);
+
+    struct Stats {
+        uint64_t quotes = 0;
+        uint64_t nonces = 0;
+        uint64_t cache_hits = 0;
+        uint64_t failures = 0;
+        uint32_t largest_batch = 0;
+    };
+    Stats stats() const;
+
+private:
+    struct Batch {
+        std::vector<Sha256::Digest> leaves;
+        std::chrono::steady_clock::time_point deadline;
+        bool sealed = false;            // No more leaves accepted
+        bool done = false;              // levels/evidence final
+        std::vector<std::vector<Sha256::Digest>> levels; // Leaves .. root
+        std::shared_ptr<const Evidence> evidence;        // null on failure
+        std::string error;
+    };
+
+    void complete(Batch& batch);
+
+    SentinelCore& m_core;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::shared_ptr<Batch> m_open;      // Batch accepting nonces
+    std::shared_ptr<const Evidence> m_latest;
+
+    std::atomic<uint64_t> m_quotes{0};
+    std::atomic<uint64_t> m_nonces{0};
+    std::atomic<uint64_t> m_cache_hits{0};
+    std::atomic<uint64_t> m_failures{0};
+    std::atomic<uint32_t> m_largest_batch{0};
+};
+
+} // namespace kytin
+
+#endif // KYTIN_ATTEST_HPP
@@ -0,0 +1,157 @@
+/*
+ * Kytin Protocol - Signature Audit Log
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ *
+ * Append-only record of every signature the Sentinel produces.
+ *
+ * Layout on disk (one directory):
+ *   audit-<first_seq>.seg   Hot segment: 4 KiB header + fixed 256-byte
+ *                           records, memory-mapped; the newest is appended to
+ *   audit-<first_seq>.segz  Cold segment: zlib-compressed blocks of records
+ *                           with a per-block (seq, time) index
+ *
+ * Sequence numbers and timestamps are both non-decreasing, so a range query
+ * binary-searches the segment list, then the blocks/records inside the
+ * matching segments, and never scans data outside the requested range.
+ */
+
+#ifndef KYTIN_AUDIT_HPP
+#define KYTIN_AUDIT_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace kytin {
+
+// ============================================================================
+// RECORDS
+// ============================================================================
+
+enum class AuditKind : uint8_t {
+    HEARTBEAT = 1,
+    SIGN = 2,
+    MIGRATE = 3
+};
+
+const char* audit_kind_name(AuditKind kind);
+
+/**
+ * @brief One signature, exactly as stored on disk (256 bytes)
+ */
+struct AuditRecord {
+    uint64_t seq;                   // Assigned by the log, starts at 1
+    uint64_t timestamp_us;          // Unix microseconds (clamped monotonic)
+    uint8_t kind;                   // AuditKind
+    uint8_t mode;                   // HeartbeatMode for heartbeats
+    uint8_t signature_len;
+    uint8_t reserved[5];
+    uint64_t resin_after;           // Resin balance after this operation
+    double amount_sol;              // /sign amount
+    uint8_t payload_sha256[32];     // Digest of the signed payload
+    uint8_t signature[80];
+    char detail[104];               // NUL-padded (child key for MIGRATE)
+};
+
+static_assert(sizeof(AuditRecord) == 256, "audit record layout is fixed");
+
+struct AuditOptions {
+    std::string dir;                    // Empty = audit log disabled
+    uint32_t segment_records = 65536;   // 16 MiB hot segments
+    uint32_t hot_segments = 2;          // Sealed segments kept uncompressed
+};
+
+struct AuditQuery {
+    uint64_t from_us = 0;
+    uint64_t to_us = UINT64_MAX;
+    uint64_t after_seq = 0;             // Paging cursor (exclusive)
+    size_t limit = 100;
+};
+
+// ============================================================================
+// AUDIT LOG
+// ============================================================================
+
+/**
+ * @brief Segmented, memory-mapped append-only audit log
+ *
+ * append() is single-writer (the core calls it under its state mutex) and
+ * costs one 256-byte copy into the mapped segment plus a release store of
+ * the record count. Segment rotation happens once per segment_records
+ * appends; compression runs on a background thread.
+ */
+class AuditLog {
+public:
+    AuditLog();
+    ~AuditLog();
+
+    AuditLog(const AuditLog&) = delete;
+    AuditLog& operator=(const AuditLog&) = delete;
+
+    /**
+     * @brief Open (or create) the log directory and recover existing segments
+     */
+    bool open(const AuditOptions& options, std::string* error = nullptr);
+
+    /**
+     * @brief Append a record; seq and (monotonic) timestamp are filled in
+     * @return Assigned sequence number, or 0 if the log is not writable
+     */
+    uint64_t append(AuditRecord record);
+
+    /**
+     * @brief Records in [from_us, to_us] with seq > after_seq, oldest first
+     */
+    std::vector<AuditRecord> query(const AuditQuery& query) const;
+
+    uint64_t last_seq() const { return m_next_seq.load() - 1; }
+
+    /**
+     * @brief Stop the compactor and unmap all segments
+     */
+    void close();
+
+private:
+    struct Segment;
+
+    bool open_segment_file(const std::string& path, bool compressed);
+    bool start_segment(uint64_t first_seq);
+    void seal_active();
+    void schedule_compaction();
+    void compactor_loop();
+    bool compress_segment(const std::shared_ptr<Segment>& segment);
+    void scan_segment(const Segment& segment, const AuditQuery& query,
+                      std::vector<AuditRecord>& out) const;
+
+    AuditOptions m_options;
+
+    // Segment index, oldest first; the last entry is the active segment
+    mutable std::shared_mutex m_index_mutex;
+    std::vector<std::shared_ptr<Segment>> m_segments;
+    std::shared_ptr<Segment> m_active;
+
+    std::atomic<uint64_t> m_next_seq{1};
+    uint64_t m_last_timestamp_us = 0;
+
+    // Background compaction of sealed segments
+    std::thread m_compactor;
+    std::mutex m_compact_mutex;
+    std::condition_variable m_compact_cv;
+    std::deque<std::shared_ptr<Segment>> m_compact_queue;
+    bool m_stopping = false;
+};
+
+} // namespace kytin
+
+#endif // KYTIN_AUDIT_HPP
@@ -0,0 +1,124 @@
+/*
+ * Kytin Protocol - Traffic Capture
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ *
+ * Compact binary trace of the requests a Sentinel served, for replay with
+ * tools/kytin_replay. Bodies are stored verbatim (transactions included),
+ * so treat trace files like the audit log.
+ *
+ * File layout:
+ *   "KYTTRC01"   8-byte magic
+ *   u32          format version
+ *   u32          reserved
+ *   u64          capture start (unix microseconds)
+ *   records...   until EOF, each:
+ *     varint     arrival offset from capture start (microseconds)
+ *     u8         method (TraceMethod)
+ *     varint+[]  request target (path + query)
+ *     varint+[]  request body
+ *     varint     response status
+ *     varint     server latency (microseconds)
+ *
+ * Records are written in completion order; arrival offsets are therefore
+ * only approximately sorted.
+ */
+
+#ifndef KYTIN_CAPTURE_HPP
+#define KYTIN_CAPTURE_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+namespace kytin {
+
+enum class TraceMethod : uint8_t {
+    GET = 0,
+    POST = 1,
+    OTHER = 2
+};
+
+TraceMethod parse_trace_method(const std::string& method);
+const char* trace_method_name(TraceMethod method);
+
+struct TraceRecord {
+    uint64_t offset_us = 0;     // Arrival time relative to capture start
+    TraceMethod method = TraceMethod::GET;
+    std::string target;         // "/sign" or "/history?from=..."
+    std::string body;
+    uint32_t status = 0;        // Status the capturing Sentinel returned
+    uint64_t latency_us = 0;    // Time the capturing Sentinel spent on it
+};
+
+// ============================================================================
+// WRITER
+// ============================================================================
+
+/**
+ * @brief Appends request records to a trace file (thread-safe)
+ */
+class TraceWriter {
+public:
+    TraceWriter() = default;
+    ~TraceWriter();
+
+    TraceWriter(const TraceWriter&) = delete;
+    TraceWriter& operator=(const TraceWriter&) = delete;
+
+    bool open(const std::string& path, std::string* error = nullptr);
+    bool is_open() const { return m_file != nullptr; }
+
+    /**
+     * @brief Microseconds since open() on a monotonic clock
+     */
+    uint64_t now_us() const;
+
+    /**
+     * @param arrival_us now_us() when the request arrived
+     */
+    void record(const std::string& method, const std::string& target,
+                const std::string& body, int status, uint64_t arrival_us);
+
+    void close();
+
+private:
+    std::mutex m_mutex;
+    FILE* m_file = nullptr;
+    std::string m_buffer;       // Encoding scratch, guarded by m_mutex
+    uint64_t m_epoch_ns = 0;    // steady_clock at open()
+};
+
+// ============================================================================
+// READER
+// ============================================================================
+
+class TraceReader {
+public:
+    bool open(const std::string& path, std::string* error = nullptr);
+
+    /**
+     * @return false at end of file or on a truncated record (see error())
+     */
+    bool next(TraceRecord& record);
+
+    uint64_t start_unix_us() const { return m_start_unix_us; }
+    const std::string& error() const { return m_error; }
+
+private:
+    bool read_varint(uint64_t& value);
+    bool read_bytes(std::string& out);
+
+    std::ifstream m_in;
+    uint64_t m_start_unix_us = 0;
+    std::string m_error;
+};
+
+} // namespace kytin
+
+#endif // KYTIN_CAPTURE_HPP
@@ -0,0 +1,210 @@
+/*
+ * Kytin Protocol - Sentinel Core C API
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ *
+ * Stable C ABI for embedding the Sentinel in-process: co-located agent
+ * runtimes call the core directly instead of going through HTTP + JSON.
+ *
+ * ABI rules: functions and enum values are only ever added, never changed.
+ * Structs carry no pointers into library memory and are filled by value;
+ * their layouts are frozen, except that size-prefixed (*_ext_t) structs may
+ * grow at the end. Each addition bumps KYTIN_CORE_ABI_VERSION: check at
+ * startup that kytin_core_abi_version() is at least the header's.
+ */
+
+#ifndef KYTIN_CORE_H
+#define KYTIN_CORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#define KYTIN_API __declspec(dllexport)
+#elif defined(__GNUC__)
+#define KYTIN_API __attribute__((visibility("default")))
+#else
+#define KYTIN_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define KYTIN_CORE_ABI_VERSION 3
+
+/* Large enough for an ECDSA (r || s) or DER-encoded P-256 signature */
+#define KYTIN_SIGNATURE_MAX 80
+
+/* Uncompressed P-256 public key (0x04 || X || Y) */
+#define KYTIN_PUBLIC_KEY_MAX 65
+
+/* Hardware ID, NUL included */
+#define KYTIN_HARDWARE_ID_MAX 64
+
+/* ========================================================================== */
+/* TYPES                                                                      */
+/* ========================================================================== */
+
+typedef struct kytin_core kytin_core_t;
+
+typedef enum {
+    KYTIN_OK = 0,
+    KYTIN_ERR_INVALID_ARGUMENT = 1,
+    KYTIN_ERR_DEAD = 2,             /* Soul Transfer executed (HTTP 410) */
+    KYTIN_ERR_RESIN_DEPLETED = 3,   /* HTTP 402 */
+    KYTIN_ERR_POLICY_VIOLATION = 4, /* HTTP 403 */
+    KYTIN_ERR_TPM_UNAVAILABLE = 5,  /* HTTP 403 */
+    KYTIN_ERR_SIGNING_FAILED = 6,   /* HTTP 500 */
+    KYTIN_ERR_CONFIG = 7,           /* Config file missing or invalid */
+    KYTIN_ERR_INTERNAL = 8
+} kytin_result_t;
+
+typedef enum {
+    KYTIN_MODE_ECO = 0,
+    KYTIN_MODE_TURBO = 1
+} kytin_heartbeat_mode_t;
+
+typedef struct {
+    uint8_t data[KYTIN_SIGNATURE_MAX];
+    uint32_t length;
+    uint64_t timestamp;             /* Unix seconds */
+    char algorithm[16];             /* NUL-terminated, e.g. "Secp256r1" */
+} kytin_signature_t;
+
+/*
+ * Signature fields added after kytin_signature_t was frozen, filled by the
+ * *_ex calls. Set size to sizeof(kytin_signature_ext_t) first: the library
+ * fills only the fields that fit, so older callers keep working as the
+ * struct grows.
+ */
+typedef struct {
+    uint32_t size;
+    uint64_t sequence;              /* Signed as an 8-byte big-endian prefix
+                                       of the payload */
+    uint32_t device;                /* TPM that signed (0 = identity TPM);
+                                       kytin_core_device_public_key() */
+} kytin_signature_ext_t;
+
+typedef struct {
+    char hardware_id[KYTIN_HARDWARE_ID_MAX]; /* NUL-terminated */
+    uint8_t public_key[KYTIN_PUBLIC_KEY_MAX];
+    uint32_t public_key_length;
+} kytin_device_key_t;
+
+typedef struct {
+    uint64_t resin_balance;
+    uint64_t resin_lifetime_burned;
+    uint64_t resin_daily_limit;
+    uint64_t resin_daily_consumed;
+    double daily_spent_sol;
+    double daily_limit_sol;
+    uint64_t policy_generation;
+    int32_t tpm_available;
+    int32_t tpm_mock_mode;
+    int32_t is_dead;
+} kytin_core_status_t;
+
+/* ========================================================================== */
+/* LIFECYCLE                                                                  */
+/* ========================================================================== */
+
+/** ABI version of the loaded library (compare with KYTIN_CORE_ABI_VERSION) */
+KYTIN_API uint32_t kytin_core_abi_version(void);
+
+/**
+ * Create a core and initialize the TPM backend.
+ * @param config_path JSON config file, or NULL for built-in defaults
+ * @param out         Receives the handle on success
+ */
+KYTIN_API kytin_result_t kytin_core_create(const char *config_path,
+                                           kytin_core_t **out);
+
+/** Shut down the TPM context and free the handle (NULL is a no-op) */
+KYTIN_API void kytin_core_destroy(kytin_core_t *core);
+
+/** Re-read the config file passed to kytin_core_create() */
+KYTIN_API kytin_result_t kytin_core_reload(kytin_core_t *core);
+
+/* ========================================================================== */
+/* OPERATIONS (thread-safe)                                                   */
+/* ========================================================================== */
+
+/**
+ * Consume Resin and sign a heartbeat payload.
+ * KYTIN_ERR_RESIN_DEPLETED if the tank is short or the day's heartbeats have
+ * used up the policy's resin.daily_limit.
+ * @param resin_remaining Optional; receives the balance after the debit
+ */
+KYTIN_API kytin_result_t kytin_heartbeat(kytin_core_t *core,
+                                         kytin_heartbeat_mode_t mode,
+                                         const uint8_t *payload,
+                                         size_t payload_len,
+                                         kytin_signature_t *signature,
+                                         uint64_t *resin_remaining);
+
+/**
+ * Policy-checked transaction signing.
+ * @param amount_sol          KYTIN_ERR_INVALID_ARGUMENT if NaN, infinite or
+ *                            negative
+ * @param daily_remaining_sol Optional; receives the remaining daily budget
+ */
+KYTIN_API kytin_result_t kytin_sign(kytin_core_t *core, const uint8_t *tx,
+                                    size_t tx_len, double amount_sol,
+                                    kytin_signature_t *signature,
+                                    double *daily_remaining_sol);
+
+/** kytin_heartbeat(), also filling *ext (optional) */
+KYTIN_API kytin_result_t kytin_heartbeat_ex(kytin_core_t *core,
+                                            kytin_heartbeat_mode_t mode,
+                                            const uint8_t *payload,
+                                            size_t payload_len,
+                                            kytin_signature_t *signature,
+                                            kytin_signature_ext_t *ext,
+                                            uint64_t *resin_remaining);
+
+/** kytin_sign(), also filling *ext (optional) */
+KYTIN_API kytin_result_t kytin_sign_ex(kytin_core_t *core, const uint8_t *tx,
+                                       size_t tx_len, double amount_sol,
+                                       kytin_signature_t *signature,
+                                       kytin_signature_ext_t *ext,
+                                       double *daily_remaining_sol);
+
+/**
+ * Soul Transfer: sign "MIGRATE_AUTHORITY_TO:<child_key>" and die.
+ * IRREVERSIBLE - every later heartbeat/sign returns KYTIN_ERR_DEAD.
+ */
+KYTIN_API kytin_result_t kytin_migrate(kytin_core_t *core,
+                                       const char *child_key,
+                                       kytin_signature_t *signature);
+
+/** Copy all counters into *status */
+KYTIN_API kytin_result_t kytin_core_status(kytin_core_t *core,
+                                           kytin_core_status_t *status);
+
+/** Number of TPMs in the signing farm (>= 1) */
+KYTIN_API kytin_result_t kytin_core_device_count(kytin_core_t *core,
+                                                 uint32_t *count);
+
+/**
+ * Identity and public key of the TPM that made a signature, for checking it:
+ * pass kytin_signature_ext_t.device.
+ * @return KYTIN_ERR_INVALID_ARGUMENT past the last device (see
+ *         kytin_core_device_count()), KYTIN_ERR_TPM_UNAVAILABLE for a device
+ *         that has never come up
+ */
+KYTIN_API kytin_result_t kytin_core_device_public_key(kytin_core_t *core,
+                                                      uint32_t device,
+                                                      kytin_device_key_t *key);
+
+/** Static, human-readable name of a result code */
+KYTIN_API const char *kytin_result_name(kytin_result_t result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* KYTIN_CORE_H */
@@ -0,0 +1,373 @@
+/*
+ * Kytin Protocol - Sentinel Core
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ *
+ * Resin accounting, policy enforcement, TPM signing and Soul Transfer state,
+ * independent of any transport. The HTTP daemon (main.cpp) and the C ABI
+ * (kytin_core.h) are both thin layers over SentinelCore.
+ */
+
+#ifndef KYTIN_CORE_HPP
+#define KYTIN_CORE_HPP
+
+#include "kytin.hpp"
+#include "kytin_arena.hpp"
+#include "kytin_audit.hpp"
+#include "kytin_events.hpp"
+#include "kytin_handoff.hpp"
+#include "kytin_policy.hpp"
+#include "kytin_sequence.hpp"
+#include "kytin_sha256.hpp"
+#include "kytin_status_page.hpp"
+#include "kytin_timeseries.hpp"
+#include "kytin_tpm.hpp"
+#include "kytin_tpm_farm.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace kytin {
+
+// ============================================================================
+// HEARTBEAT MODES
+// ============================================================================
+
+enum class HeartbeatMode {
+    ECO,    // 1 Resin per 4 hours
+    TURBO   // 240 Resin per 4 hours (1 per minute)
+};
+
+uint64_t get_resin_cost(HeartbeatMode mode);
+HeartbeatMode parse_heartbeat_mode(std::string_view mode_str);
+const char* heartbeat_mode_name(HeartbeatMode mode);
+
+/**
+ * @brief Standard base64 encoding (signatures on the wire)
+ */
+std::string base64_encode(const std::vector<uint8_t>& data);
+
+/**
+ * @brief Append the base64 encoding of data to out (request-arena text)
+ */
+void base64_encode(std::span<const uint8_t> data, ArenaString& out);
+
+/**
+ * @brief Decimal text of a sequence number (JSON carries them as strings:
+ * they can exceed 2^53)
+ */
+ArenaString sequence_string(uint64_t sequence);
+
+// ============================================================================
+// SENTINEL CORE
+// ============================================================================
+
+/**
+ * @brief The Sentinel's state machine, shared by every front end
+ *
+ * All operations are thread-safe. Policy limits are read from the active
+ * PolicyStore snapshot; mutable state is guarded by an internal mutex.
+ */
+class SentinelCore {
+public:
+    enum class Status {
+        OK,
+        INVALID_ARGUMENT,
+        DEAD,               // Soul Transfer executed
+        RESIN_DEPLETED,
+        POLICY_VIOLATION,
+        TPM_UNAVAILABLE,
+        SIGNING_FAILED,
+        NOT_READY           // initialize() still running
+    };
+
+    struct HeartbeatResult {
+        Status status = Status::OK;
+        TPMInterface::Signature signature;
+        uint64_t sequence = 0;              // Signed with the payload
+        uint64_t resin_remaining = 0;
+        bool daily_limit = false;           // RESIN_DEPLETED by the policy's
+                                            // resin.daily_limit, not balance
+    };
+
+    struct SignResult {
+        Status status = Status::OK;
+        TPMInterface::Signature signature;
+        uint64_t sequence = 0;              // Signed with the tx
+        double daily_spent_sol = 0.0;       // After this request
+        double daily_limit_sol = 0.0;
+    };
+
+    /**
+     * @brief Verdict on one candidate /sign amount (see evaluate())
+     */
+    struct Evaluation {
+        Status status = Status::OK;         // What sign() would return
+        double remaining_sol = 0.0;         // Daily allowance left after it
+    };
+
+    struct EvaluateResult {
+        std::vector<Evaluation> items;      // In input order
+        double daily_spent_sol = 0.0;       // Window they were judged against
+        double daily_limit_sol = 0.0;
+        uint64_t policy_generation = 0;
+    };
+
+    struct MigrateResult {
+        Status status = Status::OK;
+        TPMInterface::Signature signature;
+        std::string payload;                // "MIGRATE_AUTHORITY_TO:<key>"
+    };
+
+    /**
+     * @brief Soul Transfer record, present once the Sentinel is dead
+     */
+    struct DeathCertificate {
+        std::string child_key;
+        std::string last_will_signature;    // base64
+    };
+
+    /**
+     * @brief Consistent copy of all counters (for /status and friends)
+     */
+    struct Snapshot {
+        ResinTank resin;
+        double daily_spent_sol = 0.0;
+        PolicyStore::SnapshotPtr policy;
+        TPMInterface::HardwareInfo hardware;
+        bool tpm_available = false;
+        bool is_dead = false;
+    };
+
+    /**
+     * @param initial_resin Starting Resin balance
+     */
+    explicit SentinelCore(uint64_t initial_resin = 22000);
+
+    /**
+     * @brief Initialize the TPM devices (the identity TPM falls back to
+     * mock if configured) and open the audit log if the policy names a
+     * directory
+     *
+     * Both run concurrently. May be called on a background thread while a
+     * front end is already serving: until it returns true, operations fail
+     * with NOT_READY and is_ready() is false.
+     */
+    bool initialize(bool open_audit = true);
+
+    /**
+     * @brief True once initialize() has succeeded (signing is possible)
+     */
+    bool is_ready() const { return m_ready.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Wall time initialize() took, in milliseconds
+     */
+    double startup_ms() const { return m_startup_ms; }
+
+    /**
+     * @brief Release the TPM context and close the audit log
+     */
+    void shutdown();
+
+    /**
+     * @brief Open the audit log named by the policy (no-op without one)
+     *
+     * For a process started with initialize(false), once the process it
+     * replaces has closed the log.
+     */
+    bool open_audit();
+
+    /**
+     * @brief Flush and close the audit log, leaving the TPM up
+     */
+    void close_audit();
+
+    /**
+     * @brief Publish state to the shared-memory page named by the policy
+     * (no-op without one); updated on every state change from then on
+     */
+    bool open_status_page();
+
+    /**
+     * @brief Mark the status page closed and remove it
+     */
+    void close_status_page();
+
+    /**
+     * @brief Consistent copy of the mutable state
+     */
+    CoreState export_state() const;
+
+    /**
+     * @brief Adopt another process's state (before serving any request)
+     */
+    void import_state(const CoreState& state);
+
+    /**
+     * @brief Load a config file and apply it to all components
+     */
+    bool load_policy(const std::string& path, std::string* error = nullptr);
+
+    /**
+     * @brief Re-read the config file and apply it to all components
+     */
+    bool reload_policy(std::string* error = nullptr);
+
+    PolicyStore::SnapshotPtr policy() const { return m_policy.current(); }
+
+    /**
+     * @brief Consume Resin and sign a heartbeat payload
+     *
+     * RESIN_DEPLETED when the tank is short of the cost, or when the day's
+     * heartbeats have consumed resin.daily_limit (the window restarts 24
+     * hours after it began).
+     *
+     * The signed message is the next sequence number (8 bytes, big-endian)
+     * followed by the payload; sign() does the same for transactions. The
+     * Resin is set aside before the TPM is asked and refunded if signing
+     * fails, so signatures on different farm devices proceed in parallel.
+     *
+     * @param payload_digest SHA-256 of payload if the caller already has it
+     *        (e.g. hashed while it was received); saves hashing it for the
+     *        audit log under the state lock
+     */
+    HeartbeatResult heartbeat(HeartbeatMode mode,
+                              std::span<const uint8_t> payload,
+                              const Sha256::Digest* payload_digest = nullptr);
+
+    /**
+     * @brief Policy-checked transaction signing
+     *
+     * A NaN, infinite or negative amount is INVALID_ARGUMENT: it would slip
+     * past the limit check and poison or lower the day's spend.
+     *
+     * @param tx_digest SHA-256 of tx if already known (see heartbeat())
+     */
+    SignResult sign(std::span<const uint8_t> tx, double amount_sol,
+                    const Sha256::Digest* tx_digest = nullptr);
+
+    /**
+     * @brief What-if policy check of candidate transaction amounts
+     *
+     * Every amount is judged against one snapshot of the limits and spend
+     * window, as sign() would judge it right now; with `cumulative`, in
+     * order, as if each allowed amount had been signed before the next.
+     * Amounts sign() would refuse as INVALID_ARGUMENT get that status and
+     * take no allowance.
+     * Never touches the TPM or the accounting. Large batches are split
+     * across cores.
+     */
+    EvaluateResult evaluate(const std::vector<double>& amounts_sol,
+                            bool cumulative = false) const;
+
+    /**
+     * @brief Add Resin minted by an on-chain burn (see BurnSync)
+     */
+    void credit_resin(uint64_t amount);
+
+    /**
+     * @brief Soul Transfer: sign the Last Will and die (IRREVERSIBLE)
+     */
+    MigrateResult migrate(const std::string& child_key);
+
+    bool is_dead() const { return m_is_dead.load(); }
+    std::optional<DeathCertificate> death_certificate() const;
+
+    Snapshot snapshot() const;
+
+    /**
+     * @brief The identity TPM (farm device 0)
+     */
+    TPMInterface& tpm() { return m_tpm; }
+    const TPMInterface& tpm() const { return m_tpm; }
+
+    /**
+     * @brief Every signing device, the identity TPM included
+     */
+    const TPMFarm& farm() const { return m_farm; }
+
+    SequenceAllocator::Stats sequence_stats() const {
+        return m_sequence.stats();
+    }
+
+    /**
+     * @brief Heartbeat, sign, resin and soul-transfer notifications
+     */
+    const EventBus& events() const { return m_events; }
+
+    /**
+     * @brief Resin burn and SOL spend per second, minute and hour
+     */
+    const Timeseries& timeseries() const { return m_timeseries; }
+
+    /**
+     * @brief Every signature produced so far (nullptr when auditing is off)
+     */
+    const AuditLog* audit() const {
+        return is_ready() ? m_audit.get() : nullptr;
+    }
+
+private:
+    void apply_policy(const PolicyStore::SnapshotPtr& policy);
+    std::unique_lock<std::mutex> lock_state();
+    std::optional<TPMInterface::Signature>
+    sign_sequenced(std::span<const uint8_t> payload, uint64_t& sequence);
+    void roll_daily_window_locked();
+    void publish_resin_locked();
+    void publish_status_locked();
+    void audit_locked(AuditKind kind, std::span<const uint8_t> payload,
+                      const Sha256::Digest* payload_digest,
+                      const TPMInterface::Signature& signature,
+                      uint8_t mode = 0, double amount_sol = 0.0,
+                      std::string_view detail = {});
+
+    PolicyStore m_policy;
+    TPMInterface m_tpm;
+    SequenceAllocator m_sequence{m_tpm};
+    TPMFarm m_farm{m_tpm};
+    EventBus m_events;
+    std::unique_ptr<AuditLog> m_audit;
+
+    // Written by initialize() before m_ready is released
+    std::atomic<bool> m_ready{false};
+    double m_startup_ms = 0.0;
+
+    mutable std::mutex m_state_mutex;
+    ResinTank m_resin;
+    double m_daily_spent_sol = 0.0;
+
+    // SOL of signatures still at the TPM, counted against the daily limit
+    double m_reserved_sol = 0.0;
+    uint32_t m_signs_in_flight = 0;
+
+    // Soul Transfer: once true, this Sentinel can never sign again
+    std::atomic<bool> m_is_dead{false};
+    std::string m_death_signature;  // Last Will signature (base64)
+    std::string m_child_key;        // Successor's public key
+
+    // Shared-memory mirror of the above (written under m_state_mutex)
+    StatusPageWriter m_status_page;
+    StatusSnapshot m_status;
+    uint64_t m_heartbeats = 0;
+    uint64_t m_signs = 0;
+
+    // Debits over time (written under m_state_mutex, read lock-free)
+    Timeseries m_timeseries;
+};
+
+const char* core_status_name(SentinelCore::Status status);
+
+} // namespace kytin
+
+#endif // KYTIN_CORE_HPP
@@ -0,0 +1,115 @@
+/*
+ * Kytin Protocol - Sentinel Event Bus
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ *
+ * Fan-out ring buffer of sentinel events (heartbeat, sign, resin change,
+ * soul transfer). Publishers overwrite the oldest slot and never wait for
+ * subscribers; each subscriber keeps its own cursor, so a slow consumer
+ * only loses its own backlog.
+ */
+
+#ifndef KYTIN_EVENTS_HPP
+#define KYTIN_EVENTS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace kytin {
+
+// ============================================================================
+// EVENTS
+// ============================================================================
+
+enum class EventType {
+    HEARTBEAT,
+    SIGN,
+    RESIN,          // Resin balance changed
+    SOUL_TRANSFER
+};
+
+const char* event_type_name(EventType type);
+
+struct SentinelEvent {
+    uint64_t id = 0;            // Monotonic, starts at 1
+    EventType type = EventType::HEARTBEAT;
+    std::string data;           // JSON object (already serialized)
+};
+
+// ============================================================================
+// EVENT BUS
+// ============================================================================
+
+/**
+ * @brief Bounded multi-subscriber event ring
+ *
+ * publish() is O(1) and holds the ring mutex only long enough to move one
+ * event into its slot. Readers copy out under the same mutex and block on
+ * a condition variable between events.
+ */
+class EventBus {
+public:
+    /**
+     * @param capacity Events retained for replay (rounded up to a power of 2)
+     */
+    explicit EventBus(size_t capacity = 1024);
+
+    /**
+     * @brief Append an event, overwriting the oldest one if the ring is full
+     * @return The event id
+     */
+    uint64_t publish(EventType type, std::string data);
+
+    struct ReadResult {
+        uint64_t next_cursor = 0;   // Pass back as after_id on the next read
+        uint64_t dropped = 0;       // Events overwritten before being read
+    };
+
+    /**
+     * @brief Copy events with id > after_id into out (appends, up to max)
+     *
+     * If the subscriber fell behind by more than the ring capacity, reading
+     * resumes at the oldest retained event and dropped reports the gap.
+     * Consecutive RESIN events are coalesced into the latest one.
+     */
+    ReadResult read(uint64_t after_id, std::vector<SentinelEvent>& out,
+                    size_t max) const;
+
+    /**
+     * @brief Block until an event with id > after_id exists or timeout
+     * @return true if such an event is available
+     */
+    bool wait(uint64_t after_id, std::chrono::milliseconds timeout) const;
+
+    uint64_t last_id() const { return m_last_id.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Continue another process's numbering (hot upgrade), so
+     *        subscribers resuming with its Last-Event-ID see no gap
+     *
+     * Only valid before the first publish(). Ids up to last_id are
+     * reported as dropped to anyone who asks for them.
+     */
+    void continue_after(uint64_t last_id);
+
+private:
+    std::vector<SentinelEvent> m_ring;
+    size_t m_mask;
+
+    mutable std::mutex m_mutex;
+    mutable std::condition_variable m_cv;
+    std::atomic<uint64_t> m_last_id{0};
+    uint64_t m_first_id = 1;        // Oldest id this process can hold
+};
+
+} // namespace kytin
+
+#endif // KYTIN_EVENTS_HPP
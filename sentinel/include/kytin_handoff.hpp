@@ -0,0 +1,87 @@
+/*
+ * Kytin Protocol - Hot Upgrade Handoff
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ *
+ * On SIGUSR2 the running Sentinel starts a new copy of its binary and hands
+ * it the listening socket and its in-memory state over a socketpair, so the
+ * port never closes and no Resin or spend accounting is lost:
+ *
+ *   old                                   new (KYTIN_UPGRADE_FD=<fd>)
+ *   spawn ------------------------------> initialize TPM, no audit log
+ *         <------------------------------ "READY"
+ *   stop accepting, drain requests,
+ *   park scheduler, close audit log
+ *   state + listening socket -----------> import state, open audit log
+ *         <------------------------------ "OK"
+ *   exit                                  serve on the inherited socket
+ *
+ * Connections that arrive meanwhile wait in the socket's backlog. If the
+ * new process fails before "OK", the old one takes everything back and
+ * keeps serving.
+ *
+ * Frames are a 4-byte big-endian length followed by the payload; a file
+ * descriptor travels as SCM_RIGHTS ancillary data on its frame.
+ */
+
+#ifndef KYTIN_HANDOFF_HPP
+#define KYTIN_HANDOFF_HPP
+
+#include "kytin.hpp"
+#include "kytin_scheduler.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace kytin {
+
+struct ShutdownOptions {
+    uint32_t drain_timeout_s = 30;      // Exit anyway after this long
+    uint32_t upgrade_timeout_s = 120;   // Wait for the new process's READY
+};
+
+/**
+ * @brief The core's mutable state (SentinelCore::export_state)
+ */
+struct CoreState {
+    ResinTank resin{};
+    double daily_spent_sol = 0.0;
+    bool is_dead = false;
+    std::string child_key;
+    std::string last_will_signature;    // base64
+    uint64_t last_event_id = 0;
+};
+
+/**
+ * @brief State passed from the old process to the new one
+ */
+struct Handoff {
+    CoreState core;
+    std::vector<ParkedBeat> beats;      // Scheduler position per agent
+};
+
+std::string encode_handoff(const Handoff& handoff);
+bool decode_handoff(const std::string& payload, Handoff& handoff,
+                    std::string* error = nullptr);
+
+/**
+ * @brief Send one frame, with `fd` attached when >= 0
+ */
+bool handoff_send(int channel, const std::string& payload, int fd = -1);
+
+/**
+ * @brief Receive one frame
+ * @param fd Receives an attached descriptor, or -1 (may be nullptr)
+ * @param timeout_ms Give up after this long (0 = wait forever)
+ * @return false on timeout, EOF or a malformed frame
+ */
+bool handoff_recv(int channel, std::string& payload, int* fd,
+                  uint32_t timeout_ms, std::string* error = nullptr);
+
+} // namespace kytin
+
+#endif // KYTIN_HANDOFF_HPP
@@ -0,0 +1,213 @@
+/*
+ * Kytin Protocol - Asynchronous Logging
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ *
+ * Request threads never touch stdout. A log statement copies its arguments
+ * in binary form into a per-thread single-producer ring; a background thread
+ * drains all rings, formats the records and writes them out. When a ring is
+ * full the record is dropped and counted, never waited for.
+ *
+ *   KYTIN_LOG_INFO("KYTIN-TPM", "Hardware ID: ", id);
+ *   KYTIN_LOG_ERROR("KYTIN", "Signing failed after ", ms, " ms");
+ *
+ * Arguments may be integers, floating point, bool, char, C strings,
+ * std::string and std::string_view. Tags must be string literals.
+ *
+ * KYTIN_LOG_MIN_LEVEL (0 = DEBUG ... 3 = ERROR) removes statements below
+ * that level at compile time; set_log_level() filters at runtime.
+ */
+
+#ifndef KYTIN_LOG_HPP
+#define KYTIN_LOG_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#ifndef KYTIN_LOG_MIN_LEVEL
+#define KYTIN_LOG_MIN_LEVEL 0
+#endif
+
+namespace kytin {
+
+// ============================================================================
+// LEVELS & FORMAT
+// ============================================================================
+
+// DBG/ERR rather than DEBUG/ERROR: both are predefined macros on some
+// builds (-DDEBUG in Debug, wingdi.h on Windows)
+enum class LogLevel : uint8_t {
+    DBG = 0,
+    INFO = 1,
+    WARN = 2,
+    ERR = 3,
+    OFF = 4
+};
+
+enum class LogFormat : uint8_t {
+    TEXT,   // "[KYTIN-TPM] WARNING: message" (WARN/ERROR go to stderr)
+    JSON    // One JSON object per line on stdout
+};
+
+const char* log_level_name(LogLevel level);
+bool parse_log_level(const std::string& name, LogLevel& level);
+bool parse_log_format(const std::string& name, LogFormat& format);
+
+/**
+ * @brief Runtime level filter (records below it are not captured)
+ */
+void set_log_level(LogLevel level);
+LogLevel log_level();
+
+void set_log_format(LogFormat format);
+
+namespace detail {
+extern std::atomic<uint8_t> g_log_level;
+}
+
+inline bool log_enabled(LogLevel level) {
+    return static_cast<uint8_t>(level) >=
+           detail::g_log_level.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Block until everything logged so far has been written
+ */
+void log_flush();
+
+// ============================================================================
+// RECORD CAPTURE (internal)
+// ============================================================================
+
+namespace detail {
+
+constexpr size_t LOG_PAYLOAD_SIZE = 488;
+
+enum class LogArg : uint8_t { I64, U64, F64, BOOL, CHAR, STR };
+
+struct LogRecord {
+    uint64_t timestamp_ns;
+    const char* tag;
+    LogLevel level;
+    bool truncated;
+    uint16_t size;
+    uint8_t payload[LOG_PAYLOAD_SIZE];
+};
+
+/**
+ * @brief Claim the next free slot in this thread's ring
+ * @return nullptr if the ring is full (the drop is counted)
+ */
+LogRecord* log_claim();
+
+/**
+ * @brief Publish the slot returned by log_claim()
+ */
+void log_commit();
+
+class LogEncoder {
+public:
+    explicit LogEncoder(LogRecord& rec) : m_rec(rec) {}
+
+    template <typename T>
+    void put(const T& value) {
+        using V = std::decay_t<T>;
+        if constexpr (std::is_same_v<V, bool>) {
+            scalar(LogArg::BOOL, static_cast<uint8_t>(value));
+        } else if constexpr (std::is_same_v<V, char>) {
+            scalar(LogArg::CHAR, value);
+        } else if constexpr (std::is_integral_v<V> && std::is_signed_v<V>) {
+            scalar(LogArg::I64, static_cast<int64_t>(value));
+        } else if constexpr (std::is_integral_v<V>) {
+            scalar(LogArg::U64, static_cast<uint64_t>(value));
+        } else if constexpr (std::is_floating_point_v<V>) {
+            scalar(LogArg::F64, static_cast<double>(value));
+        } else if constexpr (std::is_convertible_v<const V&, std::string_view>) {
+            str(std::string_view(value));
+        } else {
+            static_assert(sizeof(V) == 0, "unsupported log argument type");
+        }
+    }
+
+private:
+    template <typename S>
+    void scalar(LogArg type, S value) {
+        if (m_rec.size + 1 + sizeof(S) > LOG_PAYLOAD_SIZE) {
+            m_rec.truncated = true;
+            return;
+        }
+        m_rec.payload[m_rec.size++] = static_cast<uint8_t>(type);
+        std::memcpy(m_rec.payload + m_rec.size, &value, sizeof(S));
+        m_rec.size += sizeof(S);
+    }
+
+    void str(std::string_view s) {
+        if (m_rec.size + 3u > LOG_PAYLOAD_SIZE) {
+            m_rec.truncated = true;
+            return;
+        }
+        size_t room = LOG_PAYLOAD_SIZE - m_rec.size - 3;
+        uint16_t n = static_cast<uint16_t>(std::min(s.size(), room));
+        m_rec.truncated |= n < s.size();
+        m_rec.payload[m_rec.size++] = static_cast<uint8_t>(LogArg::STR);
+        std::memcpy(m_rec.payload + m_rec.size, &n, sizeof(n));
+        std::memcpy(m_rec.payload + m_rec.size + sizeof(n), s.data(), n);
+        m_rec.size += sizeof(n) + n;
+    }
+
+    LogRecord& m_rec;
+};
+
+uint64_t log_timestamp_ns();
+
+constexpr bool log_compiled_in(int level) {
+    return level >= KYTIN_LOG_MIN_LEVEL;
+}
+
+template <typename... Args>
+void log_write(LogLevel level, const char* tag, const Args&... args) {
+    LogRecord* rec = log_claim();
+    if (!rec)
+        return;
+    rec->timestamp_ns = log_timestamp_ns();
+    rec->tag = tag;
+    rec->level = level;
+    rec->truncated = false;
+    rec->size = 0;
+    LogEncoder enc(*rec);
+    (enc.put(args), ...);
+    log_commit();
+}
+
+} // namespace detail
+
+} // namespace kytin
+
+// ============================================================================
+// LOG MACROS
+// ============================================================================
+
+#define KYTIN_LOG(level, tag, ...)                                          \
+    do {                                                                    \
+        if constexpr (::kytin::detail::log_compiled_in(                     \
+                          static_cast<int>(level))) {                       \
+            if (::kytin::log_enabled(level))                                \
+                ::kytin::detail::log_write(level, tag, __VA_ARGS__);        \
+        }                                                                   \
+    } while (0)
+
+#define KYTIN_LOG_DEBUG(tag, ...) KYTIN_LOG(::kytin::LogLevel::DBG, tag, __VA_ARGS__)
+#define KYTIN_LOG_INFO(tag, ...)  KYTIN_LOG(::kytin::LogLevel::INFO, tag, __VA_ARGS__)
+#define KYTIN_LOG_WARN(tag, ...)  KYTIN_LOG(::kytin::LogLevel::WARN, tag, __VA_ARGS__)
+#define KYTIN_LOG_ERROR(tag, ...) KYTIN_LOG(::kytin::LogLevel::ERR, tag, __VA_ARGS__)
+
+#endif // KYTIN_LOG_HPP
@@ -0,0 +1,164 @@
+/*
+ * Kytin Protocol - Hot-Reloadable Policy Snapshots
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ *
+ * Policy limits and daemon configuration are loaded from a JSON file and
+ * published as immutable snapshots. A reload builds a new snapshot and swaps
+ * it in atomically; requests already in flight keep the snapshot they
+ * started with until they drop their reference.
+ */
+
+#ifndef KYTIN_POLICY_HPP
+#define KYTIN_POLICY_HPP
+
+#include "kytin.hpp"
+#include "kytin_attest.hpp"
+#include "kytin_audit.hpp"
+#include "kytin_handoff.hpp"
+#include "kytin_log.hpp"
+#include "kytin_ratelimit.hpp"
+#include "kytin_resin_sync.hpp"
+#include "kytin_scheduler.hpp"
+#include "kytin_sequence.hpp"
+#include "kytin_skill.hpp"
+#include "kytin_status_page.hpp"
+#include "kytin_tpm.hpp"
+#include "kytin_tpm_farm.hpp"
+#include "kytin_trace.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace kytin {
+
+// ============================================================================
+// POLICY SNAPSHOT
+// ============================================================================
+
+/**
+ * @brief Largest request body accepted per endpoint, in bytes
+ *
+ * Checked against Content-Length before any of the body is read, and again
+ * while a chunked body streams in. The largest value also becomes the HTTP
+ * server's hard cap at startup, so raising it takes a restart.
+ */
+struct BodyLimits {
+    uint32_t heartbeat = 4096;
+    uint32_t sign = 4096;               // base64 of a 1232-byte tx + JSON
+    uint32_t migrate = 4096;
+    uint32_t attest = 1024;
+    uint32_t verify_skill = 16u << 20;  // Whole skill directories
+    uint32_t evaluate = 1u << 20;       // Hundreds of candidate txs
+    uint32_t other = 65536;             // Any other POST
+    uint32_t timeout_ms = 10000;        // Whole body must arrive by then
+};
+
+/**
+ * @brief Immutable view of policy limits and daemon configuration
+ *
+ * Never modified after publication. Listener settings (host/port), the
+ * audit log location and the TPM devices are only read at startup;
+ * changing them requires a restart.
+ */
+struct PolicySnapshot {
+    SentinelConfig config;
+    uint64_t resin_daily_limit = 1000;  // Resin heartbeats may use a day
+    double daily_limit_sol = 10.0;      // SOL signable per day via /sign
+    TPMInterface::MockProfile mock_tpm; // Mock backend timing model
+    TPMFarmOptions tpm;                 // Signing devices (read at startup)
+    AuditOptions audit;                 // Signature audit log
+    ScheduleOptions heartbeat;          // In-daemon heartbeat schedule
+    BurnSyncOptions burn_sync;          // On-chain burns -> Resin credits
+    RateLimitOptions rate_limit;        // Per-client buckets on signing
+    TraceOptions trace;                 // Span sampling (GET /admin/trace)
+    AttestOptions attest;               // Quote batching for /attest
+    SkillVerifyOptions skills;          // Trusted keys for /verify-skill
+    ShutdownOptions shutdown;           // Drain and hot-upgrade timeouts
+    BodyLimits body_limits;             // Request body caps per endpoint
+    SequenceOptions sequence;           // NV counter behind signed seq numbers
+    StatusPageOptions status_page;      // Shared-memory status for monitors
+    LogLevel log_level = LogLevel::INFO;
+    LogFormat log_format = LogFormat::TEXT;
+
+    uint64_t generation = 0;            // Incremented on every install
+    std::string source;                 // Config file path ("" = defaults)
+};
+
+/**
+ * @brief Parse a sentinel config file into a snapshot
+ *
+ * Keys missing from the file keep their defaults.
+ *
+ * @param path  JSON config file
+ * @param error Receives a human-readable reason on failure
+ * @return Parsed snapshot or nullopt if the file is unreadable or invalid
+ */
+std::optional<PolicySnapshot> load_policy_file(const std::string& path,
+                                               std::string* error = nullptr);
+
+// ============================================================================
+// POLICY STORE
+// ============================================================================
+
+/**
+ * @brief RCU-style holder for the active policy snapshot
+ *
+ * Readers call current() once per request and use the returned pointer for
+ * the rest of that request; they never take a lock. Writers (reload) are
+ * serialized among themselves only.
+ */
+class PolicyStore {
+public:
+    using SnapshotPtr = std::shared_ptr<const PolicySnapshot>;
+
+    PolicyStore();
+
+    /**
+     * @brief Get the active snapshot (lock-free for readers)
+     */
+    SnapshotPtr current() const noexcept;
+
+    /**
+     * @brief Load a config file and install it as the active snapshot
+     * @return false (and keep the previous snapshot) if the file is invalid
+     */
+    bool load(const std::string& path, std::string* error = nullptr);
+
+    /**
+     * @brief Re-read the file passed to load()
+     * @return false if no file was loaded or the file is invalid
+     */
+    bool reload(std::string* error = nullptr);
+
+    /**
+     * @brief Publish a snapshot, assigning it the next generation number
+     */
+    void install(PolicySnapshot snapshot);
+
+    /**
+     * @brief Path of the loaded config file ("" when running on defaults)
+     */
+    std::string path() const;
+
+private:
+#if defined(__cpp_lib_atomic_shared_ptr)
+    std::atomic<SnapshotPtr> m_current;
+#else
+    SnapshotPtr m_current;  // Accessed via std::atomic_load/atomic_store
+#endif
+    mutable std::mutex m_writer_mutex;
+    std::string m_path;
+    uint64_t m_generation = 0;
+};
+
+} // namespace kytin
+
+#endif // KYTIN_POLICY_HPP
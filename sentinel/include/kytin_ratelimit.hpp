@@ -0,0 +1,140 @@
+/*
+ * Kytin Protocol - Per-Client Rate Limiting
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ *
+ * One token bucket per client, so a single misbehaving skill cannot drain
+ * the daily Resin budget or keep the TPM busy for everyone else. A client
+ * is its socket peer address. A header (API key or skill ID) names it only
+ * when `key_header` is configured, and then only on requests from
+ * `trusted_proxies` if any are listed: a caller who can set the header
+ * picks its own bucket, so configure it alone only behind a gateway that
+ * overwrites it.
+ *
+ * Each bucket is a single 64-bit word: its theoretical arrival time (GCRA,
+ * the virtual-scheduling form of a token bucket). A request is allowed if
+ * the bucket's TAT is at most `burst` emission intervals ahead of now, and
+ * pushes it one interval further. Refill is implicit - it happens when the
+ * clock passes TAT - so a lookup is one hash, a short probe and one CAS.
+ */
+
+#ifndef KYTIN_RATELIMIT_HPP
+#define KYTIN_RATELIMIT_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace kytin {
+
+struct RateLimitOptions {
+    struct Limit {
+        double rate = 5.0;              // Sustained requests per second
+                                        // (0 = unlimited)
+        double burst = 20.0;            // Bucket depth
+
+        // Slowest configurable rate: one request a day
+        static constexpr double MIN_RATE = 1.0 / 86400.0;
+    };
+
+    // Lets clients.find() take a string_view without allocating
+    struct KeyHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view s) const {
+            return std::hash<std::string_view>{}(s);
+        }
+    };
+
+    bool enabled = false;
+    Limit limit;                        // Every client not listed below
+    std::unordered_map<std::string, Limit, KeyHash, std::equal_to<>>
+        clients;                        // Per-client overrides
+    std::string key_header;             // "" = key on the peer address
+    std::vector<std::string> trusted_proxies; // Peers allowed to send
+                                              // key_header; empty = any
+    uint32_t capacity = 65536;          // Tracked clients (table size)
+
+    const Limit& limit_for(std::string_view client) const {
+        auto it = clients.find(client);
+        return it == clients.end() ? limit : it->second;
+    }
+
+    /**
+     * @brief Whether a request from `peer` may name its client in key_header
+     */
+    bool trusts_key_header(std::string_view peer) const {
+        return !key_header.empty() &&
+               (trusted_proxies.empty() ||
+                std::find(trusted_proxies.begin(), trusted_proxies.end(),
+                          peer) != trusted_proxies.end());
+    }
+};
+
+/**
+ * @brief Sharded, lock-free table of per-client token buckets
+ *
+ * Buckets live in fixed open-addressed arrays (one per shard, each shard
+ * on its own cache lines); clients are never erased, but a slot whose
+ * bucket has refilled completely may be taken over by a new client when
+ * its probe window is full. Thread-safe; limits are passed per call so a
+ * policy reload applies without rebuilding the table.
+ */
+class RateLimiter {
+public:
+    struct Decision {
+        bool allowed = true;
+        uint64_t retry_after_ms = 0;    // When rejected: until one token
+    };
+
+    explicit RateLimiter(uint32_t capacity = 65536);
+
+    RateLimiter(const RateLimiter&) = delete;
+    RateLimiter& operator=(const RateLimiter&) = delete;
+
+    /**
+     * @brief Take one token from `client`'s bucket
+     */
+    Decision acquire(std::string_view client,
+                     const RateLimitOptions::Limit& limit);
+
+    /**
+     * @brief Same, with an explicit clock (nanoseconds, monotonic)
+     */
+    Decision acquire(std::string_view client,
+                     const RateLimitOptions::Limit& limit, uint64_t now_ns);
+
+    uint32_t capacity() const { return m_shard_slots * SHARDS; }
+    uint64_t rejected() const { return m_rejected.load(); }
+
+private:
+    static constexpr uint32_t SHARDS = 64;
+    static constexpr uint32_t PROBE_LIMIT = 16;
+
+    struct alignas(16) Slot {
+        std::atomic<uint64_t> key{0};   // Client hash; 0 = empty
+        std::atomic<uint64_t> tat{0};   // Theoretical arrival time (ns)
+    };
+
+    struct alignas(64) Shard {
+        std::unique_ptr<Slot[]> slots;
+    };
+
+    Slot* find_slot(uint64_t key, uint64_t now_ns);
+
+    Shard m_shards[SHARDS];
+    uint32_t m_shard_slots;             // Power of two
+    std::atomic<uint64_t> m_rejected{0};
+};
+
+} // namespace kytin
+
+#endif // KYTIN_RATELIMIT_HPP
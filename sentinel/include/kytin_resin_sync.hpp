@@ -0,0 +1,150 @@
+/*
+ * Kytin Protocol - On-Chain Burn Sync
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ *
+ * Credits the Resin tank for RESIN burned on Solana. A background thread
+ * polls the configured `solana_rpc` endpoint:
+ *
+ *   1. getSignaturesForAddress(address, until = cursor), paged 1000 at a
+ *      time, newest first
+ *   2. getTransaction for the new signatures, oldest first, sent as JSON-RPC
+ *      batches of `batch_size` calls per HTTP request
+ *   3. every SPL-Token burn / burnChecked of `mint` whose token account or
+ *      authority is `address` (or any burn of the mint when `address` is
+ *      the mint itself) is converted to Resin and credited
+ *
+ * The cursor (last processed signature) and the running total are written
+ * to `cache_file` before the tank is credited, so a restart resumes where
+ * the previous run stopped and re-credits exactly what was synced. Requests
+ * never wait on RPC: they only see the tank the sync thread has updated.
+ */
+
+#ifndef KYTIN_RESIN_SYNC_HPP
+#define KYTIN_RESIN_SYNC_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace kytin {
+
+class SentinelCore;
+
+struct BurnSyncOptions {
+    std::string address;                // Polled account; empty = disabled
+    std::string mint;                   // RESIN mint
+    uint64_t units_per_resin = 1000000000; // Raw token units per Resin
+    uint32_t poll_interval_s = 30;
+    uint32_t batch_size = 50;           // getTransaction calls per request
+    std::string commitment = "finalized";
+    std::string cache_file;             // Cursor + totals ("" = memory only)
+};
+
+/**
+ * @brief POST a JSON-RPC body to `url`
+ * @return false (with a reason in error) on transport failure or non-200
+ */
+using RpcTransport = std::function<bool(const std::string& url,
+                                        const std::string& body,
+                                        std::string& response,
+                                        std::string& error)>;
+
+/**
+ * @brief Background poller that turns on-chain burns into Resin credits
+ */
+class BurnSync {
+public:
+    BurnSync(SentinelCore& core, RpcTransport transport);
+    ~BurnSync();
+
+    BurnSync(const BurnSync&) = delete;
+    BurnSync& operator=(const BurnSync&) = delete;
+
+    /**
+     * @brief Start the polling thread
+     *
+     * Cycles are no-ops while the policy has no burn_sync.address, so a
+     * reload that sets one is picked up without a restart. The first
+     * enabled cycle credits the total recorded in the cache file, unless
+     * `credit_cached` is false (the tank was handed over from a process
+     * that had already credited it).
+     */
+    void start(bool credit_cached = true);
+    void stop();
+
+    /**
+     * @brief Run one poll cycle on the calling thread
+     * @return false if an RPC call failed; burns synced before the failure
+     *         are kept
+     */
+    bool sync_once(std::string* error = nullptr);
+
+    struct Stats {
+        bool enabled = false;
+        std::string last_signature;     // Cursor
+        uint64_t last_slot = 0;
+        uint64_t burns = 0;             // Burn instructions credited
+        uint64_t credited_resin = 0;    // Total credited for this cursor
+        uint64_t rpc_requests = 0;
+        uint64_t rpc_errors = 0;
+        uint64_t last_sync_unix = 0;    // Last successful cycle
+    };
+    Stats stats() const;
+
+private:
+    struct Cursor {
+        std::string address;
+        std::string mint;
+        std::string signature;
+        uint64_t slot = 0;
+        uint64_t burns = 0;
+        uint64_t credited_resin = 0;
+        uint64_t remainder_units = 0;   // Burned units not yet a whole Resin
+    };
+
+    struct PendingSignature {
+        std::string signature;
+        uint64_t slot = 0;
+        bool failed = false;            // Transaction itself errored
+    };
+
+    void run();
+    bool call(const std::string& url, const std::string& body,
+              std::string& response, std::string& error);
+    bool fetch_signatures(const std::string& url,
+                          const BurnSyncOptions& options,
+                          std::vector<PendingSignature>& out,
+                          std::string& error);
+    bool load_cache(const BurnSyncOptions& options);
+    bool save_cache(const Cursor& cursor, const std::string& path);
+
+    SentinelCore& m_core;
+    RpcTransport m_transport;
+
+    std::mutex m_mutex;                 // Thread control
+    std::condition_variable m_wake;
+    std::thread m_thread;
+    bool m_stopping = false;
+
+    mutable std::mutex m_cursor_mutex;  // Guards m_cursor for stats()
+    Cursor m_cursor;
+    bool m_cache_applied = false;       // Cached total credited at startup
+    bool m_credit_cached = true;        // Credit it at all (see start())
+
+    std::atomic<uint64_t> m_rpc_requests{0};
+    std::atomic<uint64_t> m_rpc_errors{0};
+    std::atomic<uint64_t> m_last_sync_unix{0};
+};
+
+} // namespace kytin
+
+#endif // KYTIN_RESIN_SYNC_HPP
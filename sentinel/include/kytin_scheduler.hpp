@@ -0,0 +1,218 @@
+/*
+ * Kytin Protocol - Heartbeat Scheduler
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Runs agent heartbeats inside the Sentinel instead of waiting for an
+ * external process to POST /heartbeat. Each configured agent gets a timer
+ * in a hierarchical timing wheel; when it fires, the Sentinel signs a
+ * heartbeat through SentinelCore (same Resin accounting, audit log and
+ * events as the HTTP path) and pushes the result to a local sink.
+ *
+ * Sink lines (one JSON object per heartbeat):
+ *   {"agent":"a1","seq":7,"mode":"ECO","timestamp":...,"signature":"...",
+ *    "algorithm":"...","hardware_id":"...","resin_remaining":21993}
+ *   {"agent":"a1","seq":8,"mode":"ECO","timestamp":...,"error":"RESIN_DEPLETED"}
+ */
+
+#ifndef KYTIN_SCHEDULER_HPP
+#define KYTIN_SCHEDULER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace kytin {
+
+class SentinelCore;
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+struct ScheduledAgent {
+    std::string id;
+    bool turbo = false;                 // TURBO schedule instead of ECO
+};
+
+struct ScheduleOptions {
+    std::vector<ScheduledAgent> agents; // Empty = scheduler idle
+    std::string sink;                   // "file:PATH", "unix:PATH" or ""
+    uint32_t eco_interval_s = 0;        // 0 = HEARTBEAT_INTERVAL_ECO
+    uint32_t turbo_interval_s = 0;      // 0 = HEARTBEAT_INTERVAL_TURBO
+    double jitter = 0.05;               // +/- fraction of the interval
+};
+
+// ============================================================================
+// TIMING WHEEL
+// ============================================================================
+
+/**
+ * @brief Hierarchical timing wheel (4 levels x 64 slots)
+ *
+ * Timers are intrusive list nodes, so arm() and cancel() are O(1) and
+ * advancing one tick touches one level-0 slot (plus, every 64^n ticks, one
+ * slot of level n, whose timers cascade down). Level n holds timers due
+ * within 64^(n+1) ticks; later deadlines are clamped to the wheel's range.
+ *
+ * Not thread-safe: the owner serializes access.
+ */
+class TimerWheel {
+public:
+    static constexpr int LEVELS = 4;
+    static constexpr int SLOT_BITS = 6;
+    static constexpr uint64_t SLOTS = 1u << SLOT_BITS;
+    static constexpr uint64_t MAX_DELTA = (1ull << (LEVELS * SLOT_BITS)) - 1;
+
+    struct Timer {
+        Timer* prev = nullptr;
+        Timer* next = nullptr;
+        uint64_t expires = 0;           // Absolute tick
+
+        bool armed() const { return prev != nullptr; }
+    };
+
+    explicit TimerWheel(uint64_t now = 0);
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    uint64_t now() const { return m_now; }
+    size_t size() const { return m_size; }
+
+    /**
+     * @brief Schedule a timer (re-arming moves it); deadlines in the past
+     * fire on the next tick
+     */
+    void arm(Timer& timer, uint64_t expires);
+    void cancel(Timer& timer);
+
+    /**
+     * @brief Advance to tick `now`, unlinking every timer that expires on
+     * the way and appending it to `expired` in deadline order
+     */
+    void advance(uint64_t now, std::vector<Timer*>& expired);
+
+private:
+    void link(Timer& timer);
+    void cascade(int level);
+
+    // Sentinel-headed circular lists, one per slot
+    Timer m_slots[LEVELS][SLOTS];
+    uint64_t m_now;
+    size_t m_size = 0;
+};
+
+// ============================================================================
+// SCHEDULER
+// ============================================================================
+
+/**
+ * @brief Where one agent's schedule stood when the scheduler stopped
+ */
+struct ParkedBeat {
+    std::string id;
+    bool turbo = false;
+    uint64_t seq = 0;                   // Last sequence number fired
+    uint64_t due_unix_ms = 0;           // Next heartbeat, wall clock
+};
+
+/**
+ * @brief Background thread that fires scheduled agent heartbeats
+ *
+ * Ticks every 100 ms. Follows policy reloads on its own: when the active
+ * snapshot's generation changes, agents are added, removed or moved between
+ * ECO and TURBO and the sink is reopened if it changed. An agent's first
+ * heartbeat is offset by a hash of its id (stable across restarts), and
+ * each period is jittered, so thousands of agents spread evenly over the
+ * interval instead of firing in the same second.
+ */
+class HeartbeatScheduler {
+public:
+    static constexpr uint32_t TICK_MS = 100;
+
+    explicit HeartbeatScheduler(SentinelCore& core);
+    ~HeartbeatScheduler();
+
+    HeartbeatScheduler(const HeartbeatScheduler&) = delete;
+    HeartbeatScheduler& operator=(const HeartbeatScheduler&) = delete;
+
+    void start();
+    void stop();
+
+    /**
+     * @brief Agent schedules as of the last stop()
+     */
+    std::vector<ParkedBeat> parked() const;
+
+    /**
+     * @brief Continue parked schedules (from another process) instead of
+     *        starting agents at their hash offset; call before start()
+     */
+    void resume(const std::vector<ParkedBeat>& beats);
+
+    struct Stats {
+        size_t agents = 0;
+        uint64_t fired = 0;             // Heartbeats signed
+        uint64_t failed = 0;            // Refused by the core
+        uint64_t sink_errors = 0;       // Lines the sink did not accept
+    };
+    Stats stats() const;
+
+private:
+    struct Agent : TimerWheel::Timer {
+        std::string id;
+        bool turbo = false;
+        uint64_t seq = 0;
+    };
+
+    void run();
+    void reconcile(const ScheduleOptions& options, uint64_t now_tick);
+    void fire(Agent& agent);
+    uint64_t interval_ticks(bool turbo) const;
+    uint64_t next_deadline(const Agent& agent, uint64_t from_tick);
+    bool open_sink(const std::string& spec);
+    void close_sink();
+    bool write_sink(const std::string& line);
+
+    SentinelCore& m_core;
+
+    std::mutex m_mutex;                 // Thread control
+    std::condition_variable m_wake;
+    std::thread m_thread;
+    bool m_stopping = false;
+
+    // Scheduler thread only
+    TimerWheel m_wheel;
+    std::unordered_map<std::string, std::unique_ptr<Agent>> m_agents;
+    uint64_t m_generation = 0;          // Policy generation last applied
+    uint32_t m_eco_ticks = 0;
+    uint32_t m_turbo_ticks = 0;
+    double m_jitter = 0.0;
+    uint64_t m_rng;
+    std::string m_sink_spec;
+    int m_sink_fd = -1;
+    bool m_sink_socket = false;
+    bool m_sink_datagram = false;
+    uint64_t m_sink_retry_tick = 0;     // Earliest reconnect attempt
+    std::unordered_map<std::string, ParkedBeat> m_resume; // First reconcile
+
+    mutable std::mutex m_parked_mutex;
+    std::vector<ParkedBeat> m_parked;
+
+    std::atomic<size_t> m_agent_count{0};
+    std::atomic<uint64_t> m_fired{0};
+    std::atomic<uint64_t> m_failed{0};
+    std::atomic<uint64_t> m_sink_errors{0};
+};
+
+} // namespace kytin
+
+#endif // KYTIN_SCHEDULER_HPP
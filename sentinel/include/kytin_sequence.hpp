@@ -0,0 +1,96 @@
+/*
+ * Kytin Protocol - Signature Sequence Numbers
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ *
+ * Every heartbeat and transaction signature covers a strictly increasing
+ * 64-bit sequence number, so a verifier that remembers the highest number
+ * it has seen rejects replayed payloads.
+ *
+ * The numbers are backed by a TPM NV counter, but incrementing it per
+ * signature would be slow and would wear out the NV storage. Instead each
+ * increment reserves a block of SEQUENCE_BLOCK numbers: counter value c
+ * owns [c * SEQUENCE_BLOCK, (c + 1) * SEQUENCE_BLOCK). Numbers within the
+ * block are handed out from memory. After a crash or restart the rest of
+ * the block is skipped: the counter only moves forward, so a number is
+ * never issued twice.
+ */
+
+#ifndef KYTIN_SEQUENCE_HPP
+#define KYTIN_SEQUENCE_HPP
+
+#include "kytin_tpm.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+namespace kytin {
+
+/**
+ * Numbers per NV increment. Fixed rather than configurable: a smaller block
+ * after a config change would map new counter values onto numbers that were
+ * already issued.
+ */
+constexpr uint64_t SEQUENCE_BLOCK = 65536;
+
+struct SequenceOptions {
+    uint32_t nv_index = 0x01500020;     // TPM NV counter (owner hierarchy)
+};
+
+/**
+ * @brief Lock-free in-block allocation of TPM-backed sequence numbers
+ *
+ * Thread-safe. The first block is reserved on first use rather than at
+ * startup, so during a hot upgrade the new process's block comes after
+ * every number the old process issued.
+ */
+class SequenceAllocator {
+public:
+    explicit SequenceAllocator(TPMInterface& tpm);
+
+    SequenceAllocator(const SequenceAllocator&) = delete;
+    SequenceAllocator& operator=(const SequenceAllocator&) = delete;
+
+    /**
+     * @brief Counter to reserve blocks from (applies to the next block)
+     */
+    void set_nv_index(uint32_t nv_index) { m_nv_index.store(nv_index); }
+
+    /**
+     * @brief Next sequence number
+     * @return nullopt if a new block was needed and the TPM refused it
+     */
+    std::optional<uint64_t> next();
+
+    struct Stats {
+        uint64_t issued = 0;            // Numbers handed out
+        uint64_t blocks = 0;            // NV increments
+        uint64_t failures = 0;          // Failed NV increments
+    };
+    Stats stats() const;
+
+private:
+    static constexpr uint64_t NO_BLOCK = ~uint64_t{0};
+
+    bool reserve_block();
+
+    TPMInterface& m_tpm;
+    std::atomic<uint32_t> m_nv_index{SequenceOptions{}.nv_index};
+
+    std::atomic<uint64_t> m_next{0};
+    std::atomic<uint64_t> m_block{NO_BLOCK};    // Current block number
+    std::mutex m_reserve_mutex;
+
+    std::atomic<uint64_t> m_issued{0};
+    std::atomic<uint64_t> m_blocks{0};
+    std::atomic<uint64_t> m_failures{0};
+};
+
+} // namespace kytin
+
+#endif // KYTIN_SEQUENCE_HPP
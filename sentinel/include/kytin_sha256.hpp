@@ -0,0 +1,58 @@
+/*
+ * Kytin Protocol - SHA-256
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ *
+ * Dependency-free incremental SHA-256 (FIPS 180-4) for payload digests.
+ */
+
+#ifndef KYTIN_SHA256_HPP
+#define KYTIN_SHA256_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace kytin {
+
+/**
+ * @brief Incremental SHA-256
+ *
+ * Feed bytes with update() as they arrive, then call finish() once.
+ */
+class Sha256 {
+public:
+    using Digest = std::array<uint8_t, 32>;
+
+    Sha256() { reset(); }
+
+    void reset();
+    void update(const void* data, size_t len);
+    Digest finish();
+
+    /**
+     * @brief One-shot digest of a buffer
+     */
+    static Digest hash(const void* data, size_t len);
+
+private:
+    void transform(const uint8_t* block);
+
+    uint32_t m_state[8];
+    uint64_t m_length;      // Total bytes hashed
+    uint8_t m_buffer[64];
+    size_t m_buffered;
+};
+
+/**
+ * @brief Lowercase hex encoding of a digest
+ */
+std::string digest_hex(const Sha256::Digest& digest);
+
+} // namespace kytin
+
+#endif // KYTIN_SHA256_HPP
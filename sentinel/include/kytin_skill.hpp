@@ -0,0 +1,150 @@
+/*
+ * Kytin Protocol - Skill Signature Verification
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ *
+ * Native counterpart of verifySkillSignature() in bridge/src/policy.ts: a
+ * skill bundle is runnable if its developer key is trusted and the key's
+ * Ed25519 signature over the bundle verifies.
+ *
+ * The bridge checks the same bundles before every execution, so verdicts
+ * are cached by content: SHA-256(code) together with the signature and the
+ * developer key. Once a bundle has been verified, the bridge can send just
+ * its hash and get the cached verdict without shipping the code again.
+ * Trust is checked on every call (not cached) so a config reload that drops
+ * a key takes effect immediately.
+ */
+
+#ifndef KYTIN_SKILL_HPP
+#define KYTIN_SKILL_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace kytin {
+
+struct SkillVerifyOptions {
+    // "Prefix:ed25519:<base64 key>", as in the bridge's TrustedDevelopers
+    std::vector<std::string> trusted_keys = {
+        "ClawhubSigner:ed25519:5Ky7iN2o3F1c14L5H3LL4G3nT5K1LLz",
+        "KytinCore:ed25519:7R00t0fTru5T5t4T3L0ck3dPr0t0c0L",
+    };
+    uint32_t cache_entries = 4096;      // Cached verdicts (fixed at startup)
+};
+
+/**
+ * @brief One skill bundle to check
+ *
+ * Either `code` is set, or only `content_hash` (SHA-256 of the code) for a
+ * bundle that was verified before.
+ */
+struct SkillCheck {
+    std::string code;
+    bool has_code = true;
+    std::array<uint8_t, 32> content_hash{}; // Filled in from code if present
+    std::string signature;              // base64 Ed25519 signature
+    std::string developer_key;
+};
+
+enum class SkillVerdict {
+    VALID,
+    UNTRUSTED_SOURCE,       // Developer key not in trusted_keys
+    INVALID_KEY_FORMAT,     // Not "Prefix:ed25519:base64key"
+    INVALID_KEY,            // Key does not decode to <= 32 bytes
+    INVALID_SIGNATURE,      // Signature does not decode to 64 bytes
+    SIGNATURE_INVALID,      // Well-formed, but does not verify
+    NOT_CACHED              // Hash-only check of an unknown bundle
+};
+
+const char* skill_verdict_name(SkillVerdict verdict);
+
+/**
+ * @brief Ed25519 skill verification with a bounded verdict cache
+ *
+ * The cache is split into shards, each an LRU list under its own mutex.
+ * Thread-safe; the trusted key list is passed per call so reloads apply
+ * without rebuilding the cache.
+ */
+class SkillVerifier {
+public:
+    struct Result {
+        SkillVerdict verdict = SkillVerdict::VALID;
+        bool cached = false;            // Answered without verifying
+        std::array<uint8_t, 32> content_hash{};
+    };
+
+    explicit SkillVerifier(uint32_t cache_entries = 4096);
+
+    SkillVerifier(const SkillVerifier&) = delete;
+    SkillVerifier& operator=(const SkillVerifier&) = delete;
+
+    Result verify(SkillCheck check, const std::vector<std::string>& trusted);
+
+    /**
+     * @brief Check a whole skill directory; results are in input order
+     *
+     * Each signature is still verified on its own, in sequence; the only
+     * shared work is that consecutive bundles from the same developer reuse
+     * one decoded key.
+     */
+    std::vector<Result> verify_each(std::vector<SkillCheck> checks,
+                                    const std::vector<std::string>& trusted);
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        uint32_t capacity = 0;
+    };
+    Stats stats() const;
+
+private:
+    static constexpr uint32_t SHARDS = 16;
+
+    using Key = std::array<uint8_t, 32>;
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            size_t h;
+            static_assert(sizeof(h) <= sizeof(Key));
+            std::memcpy(&h, key.data(), sizeof(h));
+            return h;
+        }
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        std::list<std::pair<Key, bool>> lru;     // Front = most recent
+        std::unordered_map<Key, std::list<std::pair<Key, bool>>::iterator,
+                           KeyHash> index;
+    };
+
+    struct KeyDecoder;
+
+    Result check_one(SkillCheck& check, const std::vector<std::string>& trusted,
+                     KeyDecoder& decoder);
+    bool lookup(const Key& key, bool& valid);
+    void remember(const Key& key, bool valid);
+
+    std::unique_ptr<Shard[]> m_shards;
+    uint32_t m_shard_capacity;
+
+    std::atomic<uint64_t> m_hits{0};
+    std::atomic<uint64_t> m_misses{0};
+    std::atomic<uint64_t> m_evictions{0};
+};
+
+} // namespace kytin
+
+#endif // KYTIN_SKILL_HPP
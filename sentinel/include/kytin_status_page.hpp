@@ -0,0 +1,164 @@
+/*
+ * Kytin Protocol - Shared-Memory Status Page
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ *
+ * The Sentinel publishes its counters in a small POSIX shared-memory
+ * segment (default "/kytin-status", i.e. /dev/shm/kytin-status), rewritten
+ * on every state change. Local monitors (watchdog, dashboard, bridge) map
+ * it read-only and take consistent snapshots without a syscall, a lock or
+ * any contention with signing:
+ *
+ *   page:  magic | version | seq | StatusSnapshot as 64-bit words
+ *
+ * The single writer bumps seq to odd, stores the words and bumps it to
+ * even (a seqlock). A reader copies the words and retries if seq was odd
+ * or changed meanwhile. All accesses are atomic, so the protocol is
+ * race-free across processes.
+ *
+ * On exit, and before a hot upgrade hands over, the page is marked closed
+ * and unlinked; StatusReader then reopens the name to find the new page.
+ */
+
+#ifndef KYTIN_STATUS_PAGE_HPP
+#define KYTIN_STATUS_PAGE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <type_traits>
+
+namespace kytin {
+
+struct StatusPageOptions {
+    std::string name = "/kytin-status";     // shm_open name ("" = off)
+};
+
+/**
+ * @brief One consistent copy of the published counters
+ *
+ * Fixed layout: fields are only ever appended, with STATUS_PAGE_VERSION
+ * bumped, so older readers keep working.
+ */
+struct StatusSnapshot {
+    uint64_t updated_unix_ms = 0;       // Time of the last state change
+    uint64_t pid = 0;                   // Writing process
+    uint64_t flags = 0;                 // STATUS_* bits below
+    uint64_t resin_balance = 0;
+    uint64_t resin_lifetime_burned = 0;
+    uint64_t resin_daily_limit = 0;
+    uint64_t resin_daily_consumed = 0;
+    double daily_spent_sol = 0.0;
+    double daily_limit_sol = 0.0;
+    uint64_t policy_generation = 0;
+    uint64_t heartbeats = 0;            // Signed since this process started
+    uint64_t signs = 0;
+    uint64_t last_event_id = 0;         // Latest /events id
+    char hardware_id[72] = {};          // NUL-terminated
+    char manufacturer[32] = {};
+    char firmware_version[32] = {};
+
+    static constexpr uint64_t STATUS_READY = 1;         // Can sign
+    static constexpr uint64_t STATUS_TPM_AVAILABLE = 2;
+    static constexpr uint64_t STATUS_TPM_MOCK = 4;
+    static constexpr uint64_t STATUS_DEAD = 8;          // Soul Transfer done
+    static constexpr uint64_t STATUS_CLOSED = 16;       // Writer has exited
+
+    bool has(uint64_t flag) const { return (flags & flag) != 0; }
+};
+
+static_assert(std::is_trivially_copyable_v<StatusSnapshot>);
+static_assert(sizeof(StatusSnapshot) % sizeof(uint64_t) == 0);
+
+constexpr uint32_t STATUS_PAGE_MAGIC = 0x5453594B;     // "KYST"
+constexpr uint32_t STATUS_PAGE_VERSION = 1;
+
+/**
+ * @brief In-memory layout of the segment
+ */
+struct StatusPageLayout {
+    static constexpr size_t WORDS = sizeof(StatusSnapshot) / sizeof(uint64_t);
+
+    std::atomic<uint32_t> magic;        // Set last, once the page is valid
+    uint32_t version;
+    std::atomic<uint64_t> seq;          // Odd while a write is in progress
+    std::atomic<uint64_t> words[WORDS];
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "the seqlock needs address-free 64-bit atomics");
+
+/**
+ * @brief Owner side: creates the segment and publishes snapshots
+ *
+ * Not thread-safe: callers serialize publish() (the core does so under its
+ * state mutex).
+ */
+class StatusPageWriter {
+public:
+    StatusPageWriter() = default;
+    ~StatusPageWriter() { close(); }
+
+    StatusPageWriter(const StatusPageWriter&) = delete;
+    StatusPageWriter& operator=(const StatusPageWriter&) = delete;
+
+    /**
+     * @brief Replace any page of that name with a fresh one (mode 0644)
+     */
+    bool open(const std::string& name, std::string* error = nullptr);
+
+    bool is_open() const { return m_page != nullptr; }
+
+    void publish(const StatusSnapshot& snapshot);
+
+    /**
+     * @brief Mark the page closed and unlink it
+     */
+    void close();
+
+private:
+    StatusPageLayout* m_page = nullptr;
+    std::string m_name;
+    StatusSnapshot m_last;
+};
+
+/**
+ * @brief Monitor side: maps the page read-only and takes snapshots
+ *
+ * Not thread-safe; use one reader per thread.
+ */
+class StatusReader {
+public:
+    explicit StatusReader(std::string name = StatusPageOptions{}.name);
+    ~StatusReader();
+
+    StatusReader(const StatusReader&) = delete;
+    StatusReader& operator=(const StatusReader&) = delete;
+
+    /**
+     * @brief Current snapshot
+     *
+     * Maps the page on first use and remaps it after the writer closed it
+     * (restart or hot upgrade). The returned snapshot has STATUS_CLOSED set
+     * if no Sentinel currently publishes under this name.
+     *
+     * @return nullopt if the page does not exist or is not a status page
+     */
+    std::optional<StatusSnapshot> read(std::string* error = nullptr);
+
+private:
+    bool map(std::string* error);
+    void unmap();
+    bool try_read(StatusSnapshot& out) const;
+
+    std::string m_name;
+    const StatusPageLayout* m_page = nullptr;
+};
+
+} // namespace kytin
+
+#endif // KYTIN_STATUS_PAGE_HPP
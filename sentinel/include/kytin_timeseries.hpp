@@ -0,0 +1,130 @@
+/*
+ * Kytin Protocol - Burn and Spend Time Series
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ *
+ * Resin burned and SOL spent, rolled up per second, per minute and per hour
+ * in fixed rings of buckets aligned to Unix time:
+ *
+ *   second   300 buckets    last 5 minutes
+ *   minute   1440 buckets   last 24 hours
+ *   hour     168 buckets    last 7 days
+ *
+ * The core records every debit under its state mutex, so each ring has a
+ * single writer. Readers copy buckets without a lock: a bucket carries the
+ * period it currently holds, and a copy counts only if that period was the
+ * wanted one both before and after the counters were read. Buckets that
+ * were never written, or were recycled since, read as zero.
+ */
+
+#ifndef KYTIN_TIMESERIES_HPP
+#define KYTIN_TIMESERIES_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace kytin {
+
+enum class Resolution {
+    SECOND,
+    MINUTE,
+    HOUR
+};
+
+std::optional<Resolution> parse_resolution(const std::string& name);
+const char* resolution_name(Resolution resolution);
+
+/**
+ * @brief Consecutive periods of one ring, oldest first
+ */
+struct Series {
+    Resolution resolution = Resolution::SECOND;
+    uint64_t width_s = 1;               // Seconds per point
+    uint64_t start = 0;                 // Unix time the first point begins
+    std::vector<uint64_t> resin;        // Resin burned in each period
+    std::vector<uint64_t> lamports;     // SOL signed for, in lamports
+    std::vector<uint64_t> heartbeats;
+    std::vector<uint64_t> signs;
+};
+
+/**
+ * @brief Average burn and spend over a window of whole periods
+ */
+struct Rate {
+    uint64_t window_s = 0;
+    double resin_per_s = 0.0;
+    double sol_per_s = 0.0;
+};
+
+class Timeseries {
+public:
+    Timeseries();
+
+    Timeseries(const Timeseries&) = delete;
+    Timeseries& operator=(const Timeseries&) = delete;
+
+    /**
+     * @brief Add a debit to the current period of every ring
+     *
+     * Single writer: callers serialize record() (the core does so under its
+     * state mutex). A clock that steps backwards is held at the latest
+     * second recorded.
+     */
+    void record(uint64_t unix_s, uint64_t resin, uint64_t lamports,
+                uint64_t heartbeats, uint64_t signs);
+
+    /**
+     * @brief The last `points` periods, ending with the one holding unix_s
+     * (clamped to the ring's depth)
+     */
+    Series series(Resolution resolution, size_t points, uint64_t unix_s) const;
+
+    /**
+     * @brief Average over the `periods` complete periods before unix_s
+     */
+    Rate rate(Resolution resolution, size_t periods, uint64_t unix_s) const;
+
+    static size_t capacity(Resolution resolution);
+
+private:
+    struct Bucket {
+        std::atomic<uint64_t> period{NO_PERIOD};  // unix_s / width
+        std::atomic<uint64_t> resin{0};
+        std::atomic<uint64_t> lamports{0};
+        std::atomic<uint64_t> heartbeats{0};
+        std::atomic<uint64_t> signs{0};
+    };
+
+    struct Counts {
+        uint64_t resin = 0;
+        uint64_t lamports = 0;
+        uint64_t heartbeats = 0;
+        uint64_t signs = 0;
+    };
+
+    struct Ring {
+        uint64_t width_s = 1;
+        size_t size = 0;
+        std::unique_ptr<Bucket[]> buckets;
+    };
+
+    static constexpr uint64_t NO_PERIOD = ~uint64_t{0};
+
+    const Ring& ring(Resolution resolution) const;
+    static Counts read(const Ring& ring, uint64_t period);
+
+    Ring m_rings[3];
+    uint64_t m_latest_s = 0;            // Writer only
+};
+
+} // namespace kytin
+
+#endif // KYTIN_TIMESERIES_HPP
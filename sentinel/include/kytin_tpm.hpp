@@ -14,8 +14,12 @@
 #define KYTIN_TPM_HPP
 
 #include <cstdint>
+#include <mutex>
 #include <optional>
+#include <random>
+#include <span>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace kytin {
@@ -44,6 +48,17 @@ public:
         std::vector<uint8_t> data;
         std::string algorithm;  // "Secp256r1" (ECDSA) or "RSA-2048"
         uint64_t timestamp;
+        uint32_t device = 0;    // TPMFarm slot that signed (0 = identity TPM)
+    };
+
+    /**
+     * @brief TPM2_Quote output: a signed statement of PCR state that
+     *        embeds caller-chosen qualifying data
+     */
+    struct Quote {
+        std::vector<uint8_t> attest;    // Marshaled TPMS_ATTEST (what is signed)
+        Signature signature;            // Over attest
+        std::string pcr_selection;      // e.g. "sha256:0-7"
     };
 
     struct HardwareInfo {
@@ -53,18 +68,70 @@ public:
         bool is_mock;                   // True if running in mock mode
     };
 
+    /**
+     * @brief Timing and failure model for the mock backend
+     *
+     * Lets mock-mode load tests see the same bottleneck as real hardware,
+     * where an ECDSA sign takes 20-100 ms and commands are serialized.
+     */
+    struct MockProfile {
+        enum class Latency {
+            NONE,    // Sign instantly (default)
+            FIXED,   // Always fixed_ms
+            NORMAL,  // Normal(mean_ms, stddev_ms), clamped at 0
+            TRACE    // Replay trace_ms in order, wrapping around
+        };
+
+        Latency latency = Latency::NONE;
+        double fixed_ms = 0.0;
+        double mean_ms = 0.0;
+        double stddev_ms = 0.0;
+        std::vector<double> trace_ms;   // Recorded per-command latencies
+        double error_rate = 0.0;        // Fraction of commands that fail
+        bool serialize = true;          // One command at a time, like a TPM
+    };
+
+    /**
+     * @brief Select the TCTI to open, e.g. "device:/dev/tpmrm1" or
+     *        "swtpm:host=127.0.0.1,port=2321" (before initialize())
+     *
+     * Empty (the default) uses the TSS's default TCTI. A device named
+     * explicitly never falls back to mock mode: it is up or it is not.
+     */
+    void set_tcti(std::string tcti) { m_tcti = std::move(tcti); }
+    const std::string& tcti() const { return m_tcti; }
+
     /**
      * @brief Initialize TPM context and verify hardware presence
      * @return true if TPM 2.0 is available and initialized (or mock mode active)
      */
     bool initialize();
 
+    /**
+     * @brief Cheap round trip (TPM2_GetCapability) to check the device
+     *        still answers; in mock mode, subject to the injected error rate
+     */
+    bool probe();
+
+    /**
+     * @brief Drop the TPM context and open it again, e.g. after the device
+     *        was reset or its swtpm restarted
+     *
+     * Identity (hardware ID) is kept. A device whose initialize() failed
+     * is initialized from scratch.
+     */
+    bool reopen();
+
     /**
      * @brief Sign payload using TPM-bound key (Secp256r1/ECDSA)
+     *
+     * The TPM signs the SHA-256 of the whole payload, the digest kytin_verify
+     * recomputes from an audit record (VerifyItem::digest).
+     *
      * @param payload Data to sign
      * @return Signature or nullopt if signing failed
      */
-    std::optional<Signature> sign(const std::vector<uint8_t>& payload);
+    std::optional<Signature> sign(std::span<const uint8_t> payload);
 
     /**
      * @brief Sign a transaction hash for Solana (specifically)
@@ -73,6 +140,28 @@ public:
      */
     std::optional<std::string> sign_transaction(const std::string& tx_hash);
 
+    /**
+     * @brief Quote PCRs 0-7 (SHA-256 bank) with the signing key
+     * @param qualifying_data Up to 64 bytes, embedded as extraData
+     * @return Quote or nullopt if the TPM refused
+     *
+     * Takes the same command slot as sign(), so quotes queue behind
+     * signatures on real hardware and in the mock timing model alike.
+     */
+    std::optional<Quote> quote(const std::vector<uint8_t>& qualifying_data);
+
+    /**
+     * @brief TPM2_NV_Increment an NV counter, defining it on first use
+     * @param nv_index Owner-hierarchy NV index (0x01xxxxxx)
+     * @return The counter's new value, or nullopt on failure
+     *
+     * NV writes are slow and wear the chip: callers should increment
+     * rarely (see SequenceAllocator). In mock mode the counter lives in
+     * memory, seeded from the Unix time in milliseconds so restarts
+     * keep climbing.
+     */
+    std::optional<uint64_t> increment_counter(uint32_t nv_index);
+
     /**
      * @brief Get the public key for external verification
      * @return DER-encoded Secp256r1 public key (65 bytes, uncompressed)
@@ -97,7 +186,18 @@ public:
     /**
      * @brief Get unique hardware identifier (EK hash)
      */
-    std::string get_hardware_id() const { return m_hardware_id; }
+    const std::string& get_hardware_id() const { return m_hardware_id; }
+
+    /**
+     * @brief Install the mock timing/failure model (ignored on real hardware)
+     */
+    void set_mock_profile(MockProfile profile);
+
+    /**
+     * @brief Set a mock NV counter's current value (ignored on real
+     *        hardware); tests use it to reach the end of the counter range
+     */
+    void set_mock_counter(uint32_t nv_index, uint64_t value);
 
     /**
      * @brief Shutdown TPM context and cleanup resources
@@ -113,17 +213,40 @@ private:
     std::string m_manufacturer;
     std::string m_firmware_version;
 
+    std::string m_tcti;             // "" = default TCTI
+
     // TPM context handle (platform-specific)
     // In real mode: points to ESYS_CONTEXT*
     // In mock mode: nullptr
     void* m_tpm_context = nullptr;
+    void* m_tcti_context = nullptr; // TSS2_TCTI_CONTEXT* when m_tcti is set
+
+    // A TPM executes one command at a time (and an ESYS context is not
+    // thread-safe), so commands are serialized through this mutex
+    std::mutex m_command_mutex;
+
+    // Mock timing model; m_mock_mutex guards the profile, RNG and cursor
+    std::mutex m_mock_mutex;
+    MockProfile m_mock_profile;
+    std::mt19937_64 m_mock_rng{std::random_device{}()};
+    size_t m_mock_trace_pos = 0;
+    std::unordered_map<uint32_t, uint64_t> m_mock_counters;
 
     // Internal helpers
     bool init_real_tpm();
     bool init_mock_tpm();
+    bool open_context();
+    void close_context();
     std::string generate_mock_signature(const std::vector<uint8_t>& payload);
+    bool sample_mock_command(double& latency_ms, bool& serialize);
 };
 
+/**
+ * @brief Load a recorded latency trace (one value in ms per line, '#' comments)
+ * @return false if the file cannot be read or contains no samples
+ */
+bool load_latency_trace(const std::string& path, std::vector<double>& out);
+
 } // namespace kytin
 
 #endif // KYTIN_TPM_HPP
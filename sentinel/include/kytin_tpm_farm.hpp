@@ -0,0 +1,172 @@
+/*
+ * Kytin Protocol - TPM Signing Farm
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ *
+ * One TPM signs one command at a time, so a single chip caps signing
+ * throughput. The farm spreads signatures over several TPMs, each reached
+ * through its own TCTI:
+ *
+ *   "tpm": { "devices": [ "device:/dev/tpmrm0", "device:/dev/tpmrm1",
+ *                         "swtpm:host=127.0.0.1,port=2321" ] }
+ *
+ * Device 0 is the Sentinel's identity: its hardware ID names the Sentinel,
+ * and quotes, NV sequence blocks and the Soul Transfer Last Will always use
+ * it. Heartbeats and transactions go to whichever healthy device has the
+ * fewest commands in flight (ties rotate), and each signature records the
+ * device that made it, whose key verifies it.
+ *
+ * Health: a device that fails `down_after` commands in a row is marked down
+ * and gets no more traffic, unless it is the last one up (a farm of one
+ * behaves exactly like a single TPM). A checker thread probes idle devices
+ * every `health_interval_ms`, and reopens and probes down ones, putting
+ * them back in rotation as soon as they answer again.
+ */
+
+#ifndef KYTIN_TPM_FARM_HPP
+#define KYTIN_TPM_FARM_HPP
+
+#include "kytin_tpm.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace kytin {
+
+/**
+ * Largest farm (dispatch tracks the devices tried for one signature in a
+ * 64-bit mask)
+ */
+constexpr size_t TPM_FARM_MAX_DEVICES = 64;
+
+/**
+ * @brief Farm members and health checking, read once at startup
+ */
+struct TPMFarmOptions {
+    std::vector<std::string> devices;   // TCTI configs; empty = default TCTI
+    uint32_t health_interval_ms = 2000; // Probe period
+    uint32_t down_after = 3;            // Consecutive failures
+};
+
+/**
+ * @brief Least-loaded signing across several TPMs, with health checks
+ *
+ * Thread-safe. Device bookkeeping is guarded by one mutex that is never
+ * held across a TPM command.
+ */
+class TPMFarm {
+public:
+    /**
+     * @param primary Identity TPM, owned by the caller; becomes device 0
+     */
+    explicit TPMFarm(TPMInterface& primary);
+    ~TPMFarm();
+
+    TPMFarm(const TPMFarm&) = delete;
+    TPMFarm& operator=(const TPMFarm&) = delete;
+
+    /**
+     * @brief Bring up every device, in parallel
+     * @return true if the primary is up; other devices that fail start out
+     *         down and are retried by the health checker
+     */
+    bool initialize(const TPMFarmOptions& options);
+
+    /**
+     * @brief Stop health checks and release every device (primary too)
+     */
+    void shutdown();
+
+    /**
+     * @brief Install the mock timing/failure model on every device
+     */
+    void set_mock_profile(const TPMInterface::MockProfile& profile);
+
+    /**
+     * @brief Sign on the least-loaded healthy device
+     *
+     * A failed attempt is retried once on each other healthy device before
+     * giving up. The returned signature's `device` names the signer.
+     */
+    std::optional<TPMInterface::Signature>
+    sign(std::span<const uint8_t> payload);
+
+    /**
+     * @brief True while at least one device is up
+     */
+    bool is_available() const;
+
+    size_t size() const { return m_devices.size(); }
+
+    /**
+     * @brief Hardware ID of a device ("" until it first comes up; fixed
+     *        from then on, so safe to read for any Signature::device)
+     */
+    const std::string& hardware_id(uint32_t device) const;
+
+    struct DeviceStats {
+        std::string tcti;               // "" = default TCTI
+        std::string hardware_id;
+        std::vector<uint8_t> public_key;
+        bool up = false;
+        uint32_t in_flight = 0;
+        uint64_t signs = 0;
+        uint64_t failures = 0;
+        uint64_t downs = 0;             // Times marked down
+        double latency_ms = 0.0;        // Moving average of good signatures
+    };
+    std::vector<DeviceStats> stats() const;
+
+private:
+    struct Device {
+        TPMInterface* tpm = nullptr;
+        std::unique_ptr<TPMInterface> owned;    // All but the primary
+        std::string hardware_id;
+        std::vector<uint8_t> public_key;    // Set with hardware_id
+        bool up = false;
+        bool checking = false;          // Health checker owns it right now
+        uint32_t in_flight = 0;
+        uint32_t consecutive_failures = 0;
+        uint64_t signs = 0;
+        uint64_t failures = 0;
+        uint64_t downs = 0;
+        double latency_ms = 0.0;
+        std::chrono::steady_clock::time_point last_ok;
+    };
+
+    std::optional<size_t> acquire(uint64_t tried);
+    void release(size_t index, bool ok, double latency_ms);
+    void failed_locked(size_t index);
+    size_t up_count_locked() const;
+    void run();
+    void check(size_t index);
+
+    TPMInterface& m_primary;
+    std::vector<Device> m_devices;      // Fixed after initialize()
+    TPMFarmOptions m_options;
+
+    mutable std::mutex m_mutex;         // Guards Device bookkeeping
+    size_t m_next = 0;                  // Rotates ties between devices
+    TPMInterface::MockProfile m_mock_profile;   // For devices yet to start
+
+    std::mutex m_thread_mutex;          // Health checker control
+    std::condition_variable m_wake;
+    std::thread m_thread;
+    bool m_stopping = false;
+};
+
+} // namespace kytin
+
+#endif // KYTIN_TPM_FARM_HPP
@@ -0,0 +1,158 @@
+/*
+ * Kytin Protocol - Span Tracing
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ *
+ * Per-request timing of the signing path (JSON parsing, core lock wait,
+ * TPM command, audit append, serialization) for answering "where did this
+ * slow heartbeat spend its time".
+ *
+ *   void handle_sign(...) {
+ *     KYTIN_TRACE_REQUEST("POST /sign");   // Sampling decision + root span
+ *     { KYTIN_TRACE_SPAN("parse"); ... }
+ *   }
+ *
+ * Only sampled requests record anything. Spans go into a per-thread ring
+ * (the newest `buffer_spans` survive) and are exported on demand as Chrome
+ * trace JSON, which chrome://tracing and ui.perfetto.dev both open.
+ *
+ * Cost when tracing is off: one relaxed atomic load per request and one
+ * thread-local flag test per span. Configuring with -DKYTIN_TRACE=OFF
+ * compiles the macros out entirely.
+ */
+
+#ifndef KYTIN_TRACE_HPP
+#define KYTIN_TRACE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace kytin {
+
+struct TraceOptions {
+    double sample_rate = 0.0;           // Fraction of requests; 0 = off
+    uint32_t buffer_spans = 4096;       // Per thread, oldest overwritten
+};
+
+/**
+ * @brief Apply sampling rate and buffer size (buffers already allocated
+ * keep their size)
+ */
+void set_trace_options(const TraceOptions& options);
+
+/**
+ * @brief Every buffered span as Chrome trace JSON ("traceEvents" array,
+ * complete "X" events with microsecond timestamps)
+ *
+ * @param clear Drop the exported spans from the buffers
+ */
+std::string trace_dump_chrome_json(bool clear = false);
+
+namespace detail {
+
+// Sample when the per-thread random draw is below this; 0 = tracing off
+extern std::atomic<uint64_t> g_trace_threshold;
+
+struct TraceThreadState {
+    bool active;                        // Current request is sampled
+    uint64_t trace_id;                  // Shared by its spans
+};
+
+// Trivially destructible so spans in late destructors stay safe
+extern thread_local TraceThreadState t_trace;
+
+uint64_t trace_now_ns();
+bool trace_begin_request();
+void trace_end_request();
+void trace_record(const char* name, uint64_t start_ns, uint64_t end_ns);
+
+} // namespace detail
+
+// ============================================================================
+// RAII SPANS
+// ============================================================================
+
+/**
+ * @brief Times its scope (or up to end()) if the current request is sampled
+ *
+ * `name` must outlive the trace buffers (use a string literal).
+ */
+class TraceSpan {
+public:
+    explicit TraceSpan(const char* name)
+        : m_name(name),
+          m_start(detail::t_trace.active ? detail::trace_now_ns() : 0) {}
+
+    ~TraceSpan() { end(); }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    void end() {
+        if (m_start) {
+            detail::trace_record(m_name, m_start, detail::trace_now_ns());
+            m_start = 0;
+        }
+    }
+
+private:
+    const char* m_name;
+    uint64_t m_start;
+};
+
+/**
+ * @brief Root span of one request; decides whether the request is sampled
+ *
+ * Inside an already sampled request (one handler delegating to another)
+ * it is just a child span.
+ */
+class TraceRequest {
+public:
+    explicit TraceRequest(const char* name)
+        : m_name(name), m_start(0), m_root(false) {
+        if (detail::t_trace.active) {
+            m_start = detail::trace_now_ns();
+        } else if (detail::g_trace_threshold.load(std::memory_order_relaxed) &&
+                   detail::trace_begin_request()) {
+            m_start = detail::trace_now_ns();
+            m_root = true;
+        }
+    }
+
+    ~TraceRequest() {
+        if (m_start) {
+            detail::trace_record(m_name, m_start, detail::trace_now_ns());
+            if (m_root)
+                detail::trace_end_request();
+        }
+    }
+
+    TraceRequest(const TraceRequest&) = delete;
+    TraceRequest& operator=(const TraceRequest&) = delete;
+
+private:
+    const char* m_name;
+    uint64_t m_start;
+    bool m_root;
+};
+
+} // namespace kytin
+
+#define KYTIN_TRACE_CONCAT_(a, b) a##b
+#define KYTIN_TRACE_CONCAT(a, b) KYTIN_TRACE_CONCAT_(a, b)
+
+#if !defined(KYTIN_TRACE) || KYTIN_TRACE
+#define KYTIN_TRACE_REQUEST(name) \
+    ::kytin::TraceRequest KYTIN_TRACE_CONCAT(kytin_trace_req_, __LINE__)(name)
+#define KYTIN_TRACE_SPAN(name) \
+    ::kytin::TraceSpan KYTIN_TRACE_CONCAT(kytin_trace_span_, __LINE__)(name)
+#else
+#define KYTIN_TRACE_REQUEST(name) ((void)0)
+#define KYTIN_TRACE_SPAN(name) ((void)0)
+#endif
+
+#endif // KYTIN_TRACE_HPP
@@ -0,0 +1,155 @@
+/*
+ * Kytin Protocol - Batch Signature Verification
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ *
+ * Offline verification of Secp256r1 (NIST P-256) signatures produced by the
+ * Sentinel's /heartbeat, /sign and /migrate endpoints. Designed for auditing
+ * large archives: records stream in as JSONL, are verified in batches that
+ * share a single modular inversion, and batches run in parallel across cores.
+ */
+
+#ifndef KYTIN_VERIFY_HPP
+#define KYTIN_VERIFY_HPP
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace kytin {
+
+// ============================================================================
+// VERIFICATION RECORDS
+// ============================================================================
+
+/**
+ * @brief One signature to verify
+ *
+ * The digest is SHA-256 over the signed message: the request body for
+ * /heartbeat and the "tx" string for /sign, each prefixed with its sequence
+ * number (8 bytes, big-endian), and "MIGRATE_AUTHORITY_TO:<key>" for
+ * /migrate.
+ */
+struct VerifyItem {
+    std::vector<uint8_t> public_key;    // SEC1 point (65-byte uncompressed)
+    std::array<uint8_t, 32> digest{};   // SHA-256 of the signed payload
+    std::vector<uint8_t> signature;     // r || s, 32 bytes each
+};
+
+enum class VerifyStatus {
+    VALID,
+    INVALID,    // Well-formed, but the signature does not match
+    MALFORMED   // Bad key encoding, r/s out of range, unparsable record
+};
+
+const char* verify_status_name(VerifyStatus status);
+
+/**
+ * @brief Parse one JSONL audit record
+ *
+ * Record fields:
+ *   "signature"   base64 r||s (as returned by the Sentinel)          required
+ *   "public_key"  hex SEC1 point; falls back to default_public_key   optional
+ *   "payload"     signed payload as a string, or
+ *   "payload_b64" signed payload as base64, or
+ *   "digest"      hex SHA-256 of the signed message             one required
+ *   "sequence"    sequence number signed with the payload      optional
+ *                 (decimal string, as the Sentinel returns it, or number)
+ *
+ * /migrate responses can be appended to the archive as-is: their "payload"
+ * and "last_will_signature" fields are recognized.
+ *
+ * @return false (with a reason in error) if the record is unusable
+ */
+bool parse_verify_record(const std::string& line,
+                         const std::vector<uint8_t>& default_public_key,
+                         VerifyItem& out, std::string& error);
+
+// ============================================================================
+// BATCH VERIFIER
+// ============================================================================
+
+/**
+ * @brief Verifies batches of P-256 ECDSA signatures
+ *
+ * The s^-1 mod n inversions of a batch are computed with Montgomery's trick
+ * (one inversion plus 3(n-1) multiplications for the whole batch), and the
+ * last decoded public key is reused while consecutive records share it.
+ *
+ * Not thread-safe; use one instance per thread.
+ */
+class BatchVerifier {
+public:
+    BatchVerifier();
+    ~BatchVerifier();
+
+    BatchVerifier(const BatchVerifier&) = delete;
+    BatchVerifier& operator=(const BatchVerifier&) = delete;
+
+    /**
+     * @brief Verify a batch; results are in input order
+     */
+    std::vector<VerifyStatus> verify(const std::vector<VerifyItem>& batch);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+// ============================================================================
+// STREAMING AUDIT
+// ============================================================================
+
+struct VerifyStreamOptions {
+    unsigned threads = 0;               // 0 = hardware concurrency
+    size_t batch_size = 1024;           // Records per batch
+    std::vector<uint8_t> default_public_key;
+};
+
+struct VerifyStreamReport {
+    uint64_t total = 0;
+    uint64_t valid = 0;
+    uint64_t invalid = 0;
+    uint64_t malformed = 0;
+    double elapsed_seconds = 0.0;
+};
+
+/**
+ * @brief Called for every record that is not VALID (serialized by caller)
+ * @param line_no 1-based line number in the input stream
+ */
+using VerifyFailureCallback = std::function<void(
+    uint64_t line_no, VerifyStatus status, const std::string& reason)>;
+
+/**
+ * @brief Verify a JSONL stream using a pool of worker threads
+ *
+ * The calling thread reads lines; workers parse and verify whole batches.
+ * At most two batches per worker are buffered, so memory stays bounded no
+ * matter how large the archive is. Blank lines are skipped.
+ */
+VerifyStreamReport verify_stream(std::istream& in,
+                                 const VerifyStreamOptions& options,
+                                 const VerifyFailureCallback& on_failure);
+
+/**
+ * @brief Decode a hex string (no separators); empty result on bad input
+ */
+std::vector<uint8_t> hex_decode(const std::string& hex);
+
+/**
+ * @brief Decode standard base64 (padding optional)
+ * @return false on characters outside the alphabet
+ */
+bool base64_decode(const std::string& in, std::vector<uint8_t>& out);
+
+} // namespace kytin
+
+#endif // KYTIN_VERIFY_HPP
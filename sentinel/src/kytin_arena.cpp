@@ -0,0 +1,128 @@
+/*
+ * Kytin Protocol - Per-Request Memory Arena
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ */
+
+#include "kytin_arena.hpp"
+
+#include <atomic>
+#include <memory>
+
+namespace kytin {
+
+namespace {
+
+/**
+ * The heap behind an arena, counting the chunks it hands out
+ */
+class ChunkCounter : public std::pmr::memory_resource {
+public:
+  uint64_t chunks = 0;
+
+private:
+  void *do_allocate(size_t bytes, size_t align) override {
+    chunks++;
+    return std::pmr::new_delete_resource()->allocate(bytes, align);
+  }
+  void do_deallocate(void *p, size_t bytes, size_t align) override {
+    std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+  }
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+};
+
+/**
+ * One worker thread's arena, with the counters of the request in progress
+ */
+class ThreadArena : public std::pmr::memory_resource {
+public:
+  ThreadArena() : m_arena(m_initial, sizeof(m_initial), &m_heap) {}
+
+  int depth = 0; // Open scopes
+  uint64_t allocations = 0;
+  uint64_t bytes = 0;
+
+  uint64_t heap_chunks() const { return m_heap.chunks; }
+
+  // Everything allocated since the last release goes at once
+  void release() {
+    m_arena.release();
+    m_heap.chunks = 0;
+    allocations = 0;
+    bytes = 0;
+  }
+
+private:
+  void *do_allocate(size_t size, size_t align) override {
+    allocations++;
+    bytes += size;
+    return m_arena.allocate(size, align);
+  }
+  void do_deallocate(void *, size_t, size_t) override {
+    // Monotonic: reclaimed by release()
+  }
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+
+  alignas(std::max_align_t) std::byte m_initial[ARENA_INITIAL_BYTES];
+  ChunkCounter m_heap;
+  std::pmr::monotonic_buffer_resource m_arena;
+};
+
+thread_local std::unique_ptr<ThreadArena> t_arena;
+thread_local std::pmr::memory_resource *t_current = nullptr;
+
+std::atomic<uint64_t> g_requests{0};
+std::atomic<uint64_t> g_allocations{0};
+std::atomic<uint64_t> g_bytes{0};
+std::atomic<uint64_t> g_heap_chunks{0};
+std::atomic<uint64_t> g_peak_bytes{0};
+
+} // namespace
+
+RequestArena::Scope::Scope() {
+  if (!t_arena)
+    t_arena = std::make_unique<ThreadArena>();
+  if (t_arena->depth++ == 0)
+    t_current = t_arena.get();
+}
+
+RequestArena::Scope::~Scope() {
+  ThreadArena &arena = *t_arena;
+  if (--arena.depth > 0)
+    return;
+  t_current = nullptr;
+
+  g_requests.fetch_add(1, std::memory_order_relaxed);
+  g_allocations.fetch_add(arena.allocations, std::memory_order_relaxed);
+  g_bytes.fetch_add(arena.bytes, std::memory_order_relaxed);
+  g_heap_chunks.fetch_add(arena.heap_chunks(), std::memory_order_relaxed);
+  uint64_t peak = g_peak_bytes.load(std::memory_order_relaxed);
+  while (arena.bytes > peak &&
+         !g_peak_bytes.compare_exchange_weak(peak, arena.bytes,
+                                             std::memory_order_relaxed))
+    ;
+  arena.release();
+}
+
+std::pmr::memory_resource *RequestArena::resource() {
+  return t_current ? t_current : std::pmr::get_default_resource();
+}
+
+RequestArena::Stats RequestArena::stats() {
+  Stats s;
+  s.requests = g_requests.load();
+  s.allocations = g_allocations.load();
+  s.bytes = g_bytes.load();
+  s.heap_chunks = g_heap_chunks.load();
+  s.peak_bytes = g_peak_bytes.load();
+  return s;
+}
+
+} // namespace kytin
@@ -0,0 +1,224 @@
+/*
+ * Kytin Protocol - Batched TPM Attestation
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ */
+
+#include "kytin_attest.hpp"
+#include "kytin_core.hpp"
+#include "kytin_log.hpp"
+
+#include <algorithm>
+
+namespace kytin {
+
+// ============================================================================
+// MERKLE TREE
+// ============================================================================
+
+Sha256::Digest merkle_leaf(const std::vector<uint8_t> &nonce) {
+  Sha256 h;
+  const uint8_t prefix = 0x00;
+  h.update(&prefix, 1);
+  h.update(nonce.data(), nonce.size());
+  return h.finish();
+}
+
+static Sha256::Digest merkle_node(const Sha256::Digest &left,
+                                  const Sha256::Digest &right) {
+  Sha256 h;
+  const uint8_t prefix = 0x01;
+  h.update(&prefix, 1);
+  h.update(left.data(), left.size());
+  h.update(right.data(), right.size());
+  return h.finish();
+}
+
+Sha256::Digest merkle_fold(const Sha256::Digest &leaf,
+                           const std::vector<MerkleStep> &path) {
+  Sha256::Digest node = leaf;
+  for (const auto &step : path)
+    node = step.sibling_left ? merkle_node(step.sibling, node)
+                             : merkle_node(node, step.sibling);
+  return node;
+}
+
+/**
+ * All levels of the tree, leaves first; the last level holds the root
+ */
+static std::vector<std::vector<Sha256::Digest>>
+merkle_levels(std::vector<Sha256::Digest> leaves) {
+  std::vector<std::vector<Sha256::Digest>> levels;
+  levels.push_back(std::move(leaves));
+  while (levels.back().size() > 1) {
+    const auto &below = levels.back();
+    std::vector<Sha256::Digest> above;
+    above.reserve((below.size() + 1) / 2);
+    for (size_t i = 0; i + 1 < below.size(); i += 2)
+      above.push_back(merkle_node(below[i], below[i + 1]));
+    if (below.size() % 2)
+      above.push_back(below.back());
+    levels.push_back(std::move(above));
+  }
+  return levels;
+}
+
+static std::vector<MerkleStep>
+merkle_path(const std::vector<std::vector<Sha256::Digest>> &levels,
+            size_t index) {
+  std::vector<MerkleStep> path;
+  for (size_t level = 0; level + 1 < levels.size(); level++) {
+    size_t sibling = index ^ 1;
+    if (sibling < levels[level].size())
+      path.push_back({levels[level][sibling], (index & 1) != 0});
+    index >>= 1;
+  }
+  return path;
+}
+
+static uint64_t unix_now() {
+  return std::chrono::duration_cast<std::chrono::seconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+// ============================================================================
+// ATTESTOR
+// ============================================================================
+
+Attestor::Attestor(SentinelCore &core) : m_core(core) {}
+
+std::optional<Attestor::Proof>
+Attestor::attest(const std::vector<uint8_t> &nonce, std::string *error) {
+  if (!m_core.is_ready()) {
+    if (error)
+      *error = "Sentinel is still initializing";
+    return std::nullopt;
+  }
+
+  const auto policy = m_core.policy();
+  const AttestOptions &options = policy->attest;
+  const Sha256::Digest leaf = merkle_leaf(nonce);
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  bool leader = false;
+  if (!m_open) {
+    m_open = std::make_shared<Batch>();
+    m_open->deadline = std::chrono::steady_clock::now() +
+                       std::chrono::milliseconds(options.batch_window_ms);
+    leader = true;
+  }
+  std::shared_ptr<Batch> batch = m_open;
+  uint32_t index = static_cast<uint32_t>(batch->leaves.size());
+  batch->leaves.push_back(leaf);
+  if (batch->leaves.size() >= std::max<uint32_t>(1, options.max_batch)) {
+    batch->sealed = true;
+    m_open.reset();
+    m_cv.notify_all();
+  }
+
+  if (leader) {
+    m_cv.wait_until(lock, batch->deadline, [&] { return batch->sealed; });
+    if (m_open == batch)
+      m_open.reset();
+    batch->sealed = true;
+
+    // Quote outside the lock: the next batch fills up meanwhile
+    lock.unlock();
+    complete(*batch);
+    lock.lock();
+    batch->done = true;
+    if (batch->evidence)
+      m_latest = batch->evidence;
+    m_cv.notify_all();
+  } else {
+    m_cv.wait(lock, [&] { return batch->done; });
+  }
+  lock.unlock();
+
+  if (!batch->evidence) {
+    if (error)
+      *error = batch->error;
+    return std::nullopt;
+  }
+
+  Proof proof;
+  proof.evidence = batch->evidence;
+  proof.leaf = leaf;
+  proof.path = merkle_path(batch->levels, index);
+  proof.index = index;
+  proof.batch_size = static_cast<uint32_t>(batch->leaves.size());
+  return proof;
+}
+
+/**
+ * Build the tree and quote its root (leader only; the batch is sealed)
+ */
+void Attestor::complete(Batch &batch) {
+  batch.levels = merkle_levels(batch.leaves);
+  const Sha256::Digest &root = batch.levels.back().front();
+
+  m_nonces.fetch_add(batch.leaves.size(), std::memory_order_relaxed);
+  uint32_t size = static_cast<uint32_t>(batch.leaves.size());
+  uint32_t largest = m_largest_batch.load(std::memory_order_relaxed);
+  while (size > largest &&
+         !m_largest_batch.compare_exchange_weak(largest, size))
+    ;
+
+  auto quote =
+      m_core.tpm().quote(std::vector<uint8_t>(root.begin(), root.end()));
+  if (!quote) {
+    m_failures.fetch_add(1, std::memory_order_relaxed);
+    batch.error = "TPM quote failed";
+    KYTIN_LOG_WARN("KYTIN", "Attestation: quote failed for a batch of ",
+                   size, " nonces");
+    return;
+  }
+
+  auto evidence = std::make_shared<Evidence>();
+  evidence->quote = std::move(*quote);
+  evidence->root = root;
+  evidence->quoted_unix = unix_now();
+  batch.evidence = std::move(evidence);
+  m_quotes.fetch_add(1, std::memory_order_relaxed);
+
+  KYTIN_LOG_DEBUG("KYTIN", "Attestation: quoted root ", digest_hex(root),
+                  " for ", size, " nonces");
+}
+
+std::shared_ptr<const Attestor::Evidence>
+Attestor::latest(std::string *error) {
+  const auto policy = m_core.policy();
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_latest &&
+        unix_now() < m_latest->quoted_unix + policy->attest.freshness_s) {
+      m_cache_hits.fetch_add(1, std::memory_order_relaxed);
+      return m_latest;
+    }
+  }
+
+  // Stale: quote a nonce of our own (the current time), joining any batch
+  // that is already forming
+  uint64_t now = unix_now();
+  std::vector<uint8_t> nonce(8);
+  for (int i = 0; i < 8; i++)
+    nonce[i] = static_cast<uint8_t>(now >> (56 - 8 * i));
+  auto proof = attest(nonce, error);
+  return proof ? proof->evidence : nullptr;
+}
+
+Attestor::Stats Attestor::stats() const {
+  Stats s;
+  s.quotes = m_quotes.load();
+  s.nonces = m_nonces.load();
+  s.cache_hits = m_cache_hits.load();
+  s.failures = m_failures.load();
+  s.largest_batch = m_largest_batch.load();
+  return s;
+}
+
+} // namespace kytin
@@ -0,0 +1,625 @@
+/*
+ * Kytin Protocol - Signature Audit Log
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ *
+ * KYTIN_AUDIT_ZLIB: when defined, sealed segments beyond the hot window are
+ * compressed in the background. Without it they simply stay as mapped
+ * .seg files.
+ */
+
+#include "kytin_audit.hpp"
+#include "kytin_log.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef KYTIN_AUDIT_ZLIB
+#include <zlib.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace kytin {
+
+// ============================================================================
+// ON-DISK FORMAT
+// ============================================================================
+
+namespace {
+
+constexpr char HOT_MAGIC[8] = {'K', 'Y', 'T', 'A', 'U', 'D', '0', '1'};
+constexpr char COLD_MAGIC[8] = {'K', 'Y', 'T', 'A', 'U', 'D', 'Z', '1'};
+constexpr uint32_t FORMAT_VERSION = 1;
+constexpr size_t HOT_HEADER_SIZE = 4096;
+constexpr uint32_t COLD_BLOCK_RECORDS = 1024; // 256 KiB per block
+
+struct HotHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t record_size;
+  uint64_t first_seq;
+  uint64_t capacity;
+  uint64_t count;
+  uint64_t sealed;
+};
+
+struct ColdHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t record_size;
+  uint64_t first_seq;
+  uint64_t count;
+  uint32_t block_count;
+  uint32_t reserved;
+};
+
+struct ColdBlock {
+  uint64_t offset;
+  uint64_t compressed_size;
+  uint64_t first_seq;
+  uint64_t first_ts;
+  uint64_t last_ts;
+  uint32_t count;
+  uint32_t reserved;
+};
+
+std::string segment_path(const std::string &dir, uint64_t first_seq,
+                         bool compressed) {
+  char name[40];
+  std::snprintf(name, sizeof(name), "audit-%016llx.%s",
+                static_cast<unsigned long long>(first_seq),
+                compressed ? "segz" : "seg");
+  return (fs::path(dir) / name).string();
+}
+
+uint64_t now_us() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+} // namespace
+
+const char *audit_kind_name(AuditKind kind) {
+  switch (kind) {
+  case AuditKind::HEARTBEAT:
+    return "heartbeat";
+  case AuditKind::SIGN:
+    return "sign";
+  case AuditKind::MIGRATE:
+    return "migrate";
+  }
+  return "unknown";
+}
+
+// ============================================================================
+// SEGMENT
+// ============================================================================
+
+struct AuditLog::Segment {
+  std::string path;
+  bool compressed = false;
+  uint64_t first_seq = 0;
+  int fd = -1;
+
+  // Hot: mapped header + record array
+  uint8_t *map = nullptr;
+  size_t map_size = 0;
+  HotHeader *header = nullptr;
+  AuditRecord *records = nullptr;
+  uint64_t capacity = 0;
+  std::atomic<uint64_t> count{0};
+  bool compaction_queued = false; // Guarded by m_compact_mutex
+
+  // Cold: block index (records are read with pread + inflate)
+  std::vector<ColdBlock> blocks;
+
+  ~Segment() {
+    if (map)
+      munmap(map, map_size);
+    if (fd >= 0)
+      ::close(fd);
+  }
+
+  uint64_t size() const { return count.load(std::memory_order_acquire); }
+  uint64_t last_seq() const { return first_seq + size() - 1; }
+
+  uint64_t first_ts() const {
+    return compressed ? blocks.front().first_ts : records[0].timestamp_us;
+  }
+
+  uint64_t last_ts() const {
+    return compressed ? blocks.back().last_ts
+                      : records[size() - 1].timestamp_us;
+  }
+};
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+AuditLog::AuditLog() = default;
+
+AuditLog::~AuditLog() { close(); }
+
+bool AuditLog::open(const AuditOptions &options, std::string *error) {
+  m_options = options;
+  m_options.segment_records = std::max<uint32_t>(m_options.segment_records, 64);
+
+  std::error_code ec;
+  fs::create_directories(m_options.dir, ec);
+  if (ec) {
+    if (error)
+      *error = "audit: cannot create " + m_options.dir + ": " + ec.message();
+    return false;
+  }
+
+  // Collect segments; a .seg wins over a .segz with the same first_seq
+  // (a crash between writing the .segz and unlinking the .seg)
+  std::vector<std::pair<uint64_t, fs::path>> found;
+  for (const auto &entry : fs::directory_iterator(m_options.dir, ec)) {
+    const auto name = entry.path().filename().string();
+    unsigned long long first = 0;
+    char ext[8] = {0};
+    if (std::sscanf(name.c_str(), "audit-%16llx.%4s", &first, ext) != 2)
+      continue;
+    if (std::strcmp(ext, "seg") != 0 && std::strcmp(ext, "segz") != 0)
+      continue;
+    found.emplace_back(first, entry.path());
+  }
+  std::sort(found.begin(), found.end(), [](const auto &a, const auto &b) {
+    return a.first != b.first ? a.first < b.first
+                              : a.second.extension() < b.second.extension();
+  });
+
+  for (size_t i = 0; i < found.size(); i++) {
+    bool compressed = found[i].second.extension() == ".segz";
+    if (compressed && i > 0 && found[i - 1].first == found[i].first) {
+      fs::remove(found[i].second, ec); // Superseded by the .seg
+      continue;
+    }
+    if (!open_segment_file(found[i].second.string(), compressed)) {
+      if (error)
+        *error = "audit: corrupt segment " + found[i].second.string();
+      return false;
+    }
+  }
+
+  // Resume appending into the newest unsealed hot segment
+  if (!m_segments.empty()) {
+    auto &last = m_segments.back();
+    m_next_seq = last->first_seq + last->size();
+    if (last->size())
+      m_last_timestamp_us = last->last_ts();
+    if (!last->compressed && !last->header->sealed) {
+      if (last->size() < last->capacity)
+        m_active = last;
+      else
+        last->header->sealed = 1; // Crashed right before rotating
+    }
+  }
+  if (!m_active && !start_segment(m_next_seq)) {
+    if (error)
+      *error = "audit: cannot create segment in " + m_options.dir;
+    return false;
+  }
+
+#ifdef KYTIN_AUDIT_ZLIB
+  // Picks up sealed segments left uncompressed by a previous run
+  m_compactor = std::thread(&AuditLog::compactor_loop, this);
+  schedule_compaction();
+#endif
+
+  KYTIN_LOG_INFO("KYTIN-AUDIT", "Audit log at ", m_options.dir, " (",
+                 m_segments.size(), " segments, next seq ", m_next_seq.load(),
+                 ")");
+  return true;
+}
+
+void AuditLog::close() {
+  {
+    std::lock_guard<std::mutex> lock(m_compact_mutex);
+    m_stopping = true;
+  }
+  m_compact_cv.notify_all();
+  if (m_compactor.joinable())
+    m_compactor.join();
+
+  std::unique_lock<std::shared_mutex> lock(m_index_mutex);
+  if (m_active && m_active->map)
+    msync(m_active->map, m_active->map_size, MS_SYNC);
+  m_active.reset();
+  m_segments.clear();
+}
+
+bool AuditLog::open_segment_file(const std::string &path, bool compressed) {
+  auto seg = std::make_shared<Segment>();
+  seg->path = path;
+  seg->compressed = compressed;
+  seg->fd = ::open(path.c_str(), (compressed ? O_RDONLY : O_RDWR) | O_CLOEXEC);
+  if (seg->fd < 0)
+    return false;
+
+  if (compressed) {
+    ColdHeader hdr;
+    if (pread(seg->fd, &hdr, sizeof(hdr), 0) != sizeof(hdr) ||
+        std::memcmp(hdr.magic, COLD_MAGIC, sizeof(COLD_MAGIC)) != 0 ||
+        hdr.record_size != sizeof(AuditRecord) || hdr.block_count == 0) {
+      return false;
+    }
+    seg->blocks.resize(hdr.block_count);
+    size_t table_size = hdr.block_count * sizeof(ColdBlock);
+    if (pread(seg->fd, seg->blocks.data(), table_size, sizeof(hdr)) !=
+        static_cast<ssize_t>(table_size)) {
+      return false;
+    }
+    seg->first_seq = hdr.first_seq;
+    seg->count = hdr.count;
+  } else {
+    struct stat st;
+    if (fstat(seg->fd, &st) != 0 ||
+        static_cast<size_t>(st.st_size) < HOT_HEADER_SIZE) {
+      return false;
+    }
+    seg->map_size = st.st_size;
+    void *map = mmap(nullptr, seg->map_size, PROT_READ | PROT_WRITE,
+                     MAP_SHARED, seg->fd, 0);
+    if (map == MAP_FAILED)
+      return false;
+    seg->map = static_cast<uint8_t *>(map);
+    seg->header = reinterpret_cast<HotHeader *>(seg->map);
+    seg->records = reinterpret_cast<AuditRecord *>(seg->map + HOT_HEADER_SIZE);
+
+    if (std::memcmp(seg->header->magic, HOT_MAGIC, sizeof(HOT_MAGIC)) != 0 ||
+        seg->header->record_size != sizeof(AuditRecord)) {
+      return false;
+    }
+    seg->first_seq = seg->header->first_seq;
+    seg->capacity = std::min<uint64_t>(
+        seg->header->capacity,
+        (seg->map_size - HOT_HEADER_SIZE) / sizeof(AuditRecord));
+
+    // A crash can land between writing a record and bumping the count;
+    // adopt any trailing records whose sequence numbers line up.
+    uint64_t n = std::min(seg->header->count, seg->capacity);
+    while (n < seg->capacity && seg->records[n].seq == seg->first_seq + n)
+      n++;
+    seg->header->count = n;
+    seg->count = n;
+  }
+
+  if (seg->size() == 0 && compressed)
+    return false;
+
+  m_segments.push_back(std::move(seg));
+  return true;
+}
+
+bool AuditLog::start_segment(uint64_t first_seq) {
+  auto seg = std::make_shared<Segment>();
+  seg->path = segment_path(m_options.dir, first_seq, false);
+  seg->first_seq = first_seq;
+  seg->capacity = m_options.segment_records;
+  seg->map_size = HOT_HEADER_SIZE + seg->capacity * sizeof(AuditRecord);
+
+  seg->fd = ::open(seg->path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC,
+                   0640);
+  if (seg->fd < 0)
+    return false;
+
+  // Reserve the blocks up front: a full disk must fail here, not as a
+  // SIGBUS on some later append through the mapping
+  if (posix_fallocate(seg->fd, 0, seg->map_size) != 0)
+    return false;
+
+  void *map = mmap(nullptr, seg->map_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                   seg->fd, 0);
+  if (map == MAP_FAILED)
+    return false;
+  seg->map = static_cast<uint8_t *>(map);
+  seg->header = reinterpret_cast<HotHeader *>(seg->map);
+  seg->records = reinterpret_cast<AuditRecord *>(seg->map + HOT_HEADER_SIZE);
+
+  std::memcpy(seg->header->magic, HOT_MAGIC, sizeof(HOT_MAGIC));
+  seg->header->version = FORMAT_VERSION;
+  seg->header->record_size = sizeof(AuditRecord);
+  seg->header->first_seq = first_seq;
+  seg->header->capacity = seg->capacity;
+  seg->header->count = 0;
+  seg->header->sealed = 0;
+
+  std::unique_lock<std::shared_mutex> lock(m_index_mutex);
+  m_segments.push_back(seg);
+  m_active = std::move(seg);
+  return true;
+}
+
+// ============================================================================
+// APPEND
+// ============================================================================
+
+uint64_t AuditLog::append(AuditRecord record) {
+  if (!m_active)
+    return 0;
+
+  uint64_t n = m_active->count.load(std::memory_order_relaxed);
+  if (n == m_active->capacity) {
+    seal_active();
+    if (!start_segment(m_next_seq)) {
+      KYTIN_LOG_ERROR("KYTIN-AUDIT", "cannot start new segment; audit "
+                                     "records are being lost");
+      m_active.reset();
+      return 0;
+    }
+    n = 0;
+  }
+
+  uint64_t seq = m_next_seq.load(std::memory_order_relaxed);
+  if (record.timestamp_us == 0)
+    record.timestamp_us = now_us();
+  record.timestamp_us = std::max(record.timestamp_us, m_last_timestamp_us);
+  m_last_timestamp_us = record.timestamp_us;
+  record.seq = seq;
+
+  std::memcpy(&m_active->records[n], &record, sizeof(record));
+  m_active->header->count = n + 1;
+  m_active->count.store(n + 1, std::memory_order_release);
+
+  m_next_seq.store(seq + 1, std::memory_order_release);
+  return seq;
+}
+
+void AuditLog::seal_active() {
+  m_active->header->sealed = 1;
+  msync(m_active->map, m_active->map_size, MS_ASYNC);
+
+  schedule_compaction();
+}
+
+// ============================================================================
+// COMPACTION (COLD SEGMENTS)
+// ============================================================================
+
+/**
+ * Queue every sealed hot segment outside the newest hot_segments for
+ * compression. Each segment is queued at most once.
+ */
+void AuditLog::schedule_compaction() {
+#ifdef KYTIN_AUDIT_ZLIB
+  std::vector<std::shared_ptr<Segment>> victims;
+  {
+    std::shared_lock<std::shared_mutex> lock(m_index_mutex);
+    size_t hot_sealed = 0;
+    for (auto it = m_segments.rbegin(); it != m_segments.rend(); ++it) {
+      if ((*it)->compressed || !(*it)->header->sealed)
+        continue;
+      if (++hot_sealed > m_options.hot_segments)
+        victims.push_back(*it);
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_compact_mutex);
+    for (auto it = victims.rbegin(); it != victims.rend(); ++it) {
+      if (!(*it)->compaction_queued) {
+        (*it)->compaction_queued = true;
+        m_compact_queue.push_back(std::move(*it));
+      }
+    }
+  }
+  m_compact_cv.notify_one();
+#endif
+}
+
+void AuditLog::compactor_loop() {
+  for (;;) {
+    std::shared_ptr<Segment> segment;
+    {
+      std::unique_lock<std::mutex> lock(m_compact_mutex);
+      m_compact_cv.wait(
+          lock, [&] { return m_stopping || !m_compact_queue.empty(); });
+      if (m_stopping)
+        return;
+      segment = std::move(m_compact_queue.front());
+      m_compact_queue.pop_front();
+    }
+    if (!compress_segment(segment)) {
+      KYTIN_LOG_WARN("KYTIN-AUDIT", "could not compress ", segment->path,
+                     "; leaving it uncompressed");
+    }
+  }
+}
+
+bool AuditLog::compress_segment(const std::shared_ptr<Segment> &segment) {
+#ifdef KYTIN_AUDIT_ZLIB
+  const uint64_t count = segment->size();
+  if (count == 0)
+    return false;
+
+  const std::string final_path =
+      segment_path(m_options.dir, segment->first_seq, true);
+  const std::string tmp_path = final_path + ".tmp";
+
+  int fd = ::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                  0640);
+  if (fd < 0)
+    return false;
+
+  ColdHeader hdr{};
+  std::memcpy(hdr.magic, COLD_MAGIC, sizeof(COLD_MAGIC));
+  hdr.version = FORMAT_VERSION;
+  hdr.record_size = sizeof(AuditRecord);
+  hdr.first_seq = segment->first_seq;
+  hdr.count = count;
+  hdr.block_count =
+      static_cast<uint32_t>((count + COLD_BLOCK_RECORDS - 1) /
+                            COLD_BLOCK_RECORDS);
+
+  std::vector<ColdBlock> blocks(hdr.block_count);
+  uint64_t offset = sizeof(hdr) + blocks.size() * sizeof(ColdBlock);
+  std::vector<Bytef> out(compressBound(COLD_BLOCK_RECORDS *
+                                       sizeof(AuditRecord)));
+  bool ok = true;
+
+  for (uint32_t b = 0; b < hdr.block_count && ok; b++) {
+    uint64_t first = uint64_t(b) * COLD_BLOCK_RECORDS;
+    uint32_t n = static_cast<uint32_t>(
+        std::min<uint64_t>(COLD_BLOCK_RECORDS, count - first));
+    const AuditRecord *src = segment->records + first;
+
+    uLongf out_len = out.size();
+    ok = compress2(out.data(), &out_len, reinterpret_cast<const Bytef *>(src),
+                   n * sizeof(AuditRecord), Z_BEST_SPEED) == Z_OK &&
+         pwrite(fd, out.data(), out_len, offset) ==
+             static_cast<ssize_t>(out_len);
+
+    blocks[b] = ColdBlock{.offset = offset,
+                          .compressed_size = out_len,
+                          .first_seq = src[0].seq,
+                          .first_ts = src[0].timestamp_us,
+                          .last_ts = src[n - 1].timestamp_us,
+                          .count = n,
+                          .reserved = 0};
+    offset += out_len;
+  }
+
+  size_t table_size = blocks.size() * sizeof(ColdBlock);
+  ok = ok && pwrite(fd, &hdr, sizeof(hdr), 0) == sizeof(hdr) &&
+       pwrite(fd, blocks.data(), table_size, sizeof(hdr)) ==
+           static_cast<ssize_t>(table_size) &&
+       fsync(fd) == 0;
+  ::close(fd);
+
+  if (!ok || std::rename(tmp_path.c_str(), final_path.c_str()) != 0) {
+    std::remove(tmp_path.c_str());
+    return false;
+  }
+
+  auto cold = std::make_shared<Segment>();
+  cold->path = final_path;
+  cold->compressed = true;
+  cold->first_seq = segment->first_seq;
+  cold->count = count;
+  cold->blocks = std::move(blocks);
+  cold->fd = ::open(final_path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (cold->fd < 0)
+    return false;
+
+  {
+    std::unique_lock<std::shared_mutex> lock(m_index_mutex);
+    for (auto &entry : m_segments) {
+      if (entry == segment)
+        entry = cold;
+    }
+  }
+
+  // In-flight queries still hold the hot mapping; it is unmapped when the
+  // last reference drops
+  std::remove(segment->path.c_str());
+  return true;
+#else
+  (void)segment;
+  return false;
+#endif
+}
+
+// ============================================================================
+// QUERY
+// ============================================================================
+
+void AuditLog::scan_segment(const Segment &segment, const AuditQuery &query,
+                            std::vector<AuditRecord> &out) const {
+  auto take = [&](const AuditRecord *begin, const AuditRecord *end) {
+    const AuditRecord *it = std::lower_bound(
+        begin, end, query.from_us, [](const AuditRecord &r, uint64_t ts) {
+          return r.timestamp_us < ts;
+        });
+    if (query.after_seq >= segment.first_seq && it != end) {
+      it = std::max(it, std::lower_bound(begin, end, query.after_seq + 1,
+                                         [](const AuditRecord &r, uint64_t s) {
+                                           return r.seq < s;
+                                         }));
+    }
+    for (; it < end && it->timestamp_us <= query.to_us &&
+           out.size() < query.limit;
+         ++it) {
+      out.push_back(*it);
+    }
+  };
+
+  if (!segment.compressed) {
+    take(segment.records, segment.records + segment.size());
+    return;
+  }
+
+#ifdef KYTIN_AUDIT_ZLIB
+  const auto &blocks = segment.blocks;
+  auto block = std::partition_point(
+      blocks.begin(), blocks.end(), [&](const ColdBlock &b) {
+        return b.last_ts < query.from_us ||
+               b.first_seq + b.count - 1 <= query.after_seq;
+      });
+
+  std::vector<AuditRecord> buffer(COLD_BLOCK_RECORDS);
+  std::vector<Bytef> compressed;
+  for (; block != blocks.end() && block->first_ts <= query.to_us &&
+         out.size() < query.limit;
+       ++block) {
+    compressed.resize(block->compressed_size);
+    if (pread(segment.fd, compressed.data(), compressed.size(),
+              block->offset) != static_cast<ssize_t>(compressed.size())) {
+      return;
+    }
+    uLongf len = block->count * sizeof(AuditRecord);
+    if (uncompress(reinterpret_cast<Bytef *>(buffer.data()), &len,
+                   compressed.data(), compressed.size()) != Z_OK) {
+      return;
+    }
+    take(buffer.data(), buffer.data() + block->count);
+  }
+#endif
+}
+
+std::vector<AuditRecord> AuditLog::query(const AuditQuery &query) const {
+  // Copy the index so rotation/compaction never waits on a long query
+  std::vector<std::shared_ptr<Segment>> segments;
+  {
+    std::shared_lock<std::shared_mutex> lock(m_index_mutex);
+    segments.reserve(m_segments.size());
+    for (const auto &seg : m_segments) {
+      if (seg->size() > 0)
+        segments.push_back(seg);
+    }
+  }
+
+  std::vector<AuditRecord> out;
+  if (query.limit == 0)
+    return out;
+
+  auto it = std::partition_point(
+      segments.begin(), segments.end(), [&](const auto &seg) {
+        return seg->last_ts() < query.from_us ||
+               seg->last_seq() <= query.after_seq;
+      });
+
+  for (; it != segments.end() && out.size() < query.limit; ++it) {
+    if ((*it)->first_ts() > query.to_us)
+      break;
+    scan_segment(**it, query, out);
+  }
+  return out;
+}
+
+} // namespace kytin
@@ -0,0 +1,195 @@
+/*
+ * Kytin Protocol - Traffic Capture
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ */
+
+#include "kytin_capture.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+namespace kytin {
+
+namespace {
+
+constexpr char TRACE_MAGIC[8] = {'K', 'Y', 'T', 'T', 'R', 'C', '0', '1'};
+constexpr uint32_t TRACE_VERSION = 1;
+
+void put_varint(std::string &out, uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<char>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+void put_bytes(std::string &out, const std::string &bytes) {
+  put_varint(out, bytes.size());
+  out += bytes;
+}
+
+uint64_t steady_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+} // namespace
+
+TraceMethod parse_trace_method(const std::string &method) {
+  if (method == "GET")
+    return TraceMethod::GET;
+  if (method == "POST")
+    return TraceMethod::POST;
+  return TraceMethod::OTHER;
+}
+
+const char *trace_method_name(TraceMethod method) {
+  switch (method) {
+  case TraceMethod::GET:
+    return "GET";
+  case TraceMethod::POST:
+    return "POST";
+  default:
+    return "OTHER";
+  }
+}
+
+// ============================================================================
+// WRITER
+// ============================================================================
+
+TraceWriter::~TraceWriter() { close(); }
+
+bool TraceWriter::open(const std::string &path, std::string *error) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  m_file = std::fopen(path.c_str(), "wb");
+  if (!m_file) {
+    if (error)
+      *error = "cannot create trace file " + path + ": " + std::strerror(errno);
+    return false;
+  }
+  std::setvbuf(m_file, nullptr, _IOFBF, 1 << 18);
+
+  uint64_t start_unix_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::system_clock::now().time_since_epoch())
+          .count();
+  uint32_t header[2] = {TRACE_VERSION, 0};
+  std::fwrite(TRACE_MAGIC, 1, sizeof(TRACE_MAGIC), m_file);
+  std::fwrite(header, 1, sizeof(header), m_file);
+  std::fwrite(&start_unix_us, 1, sizeof(start_unix_us), m_file);
+
+  m_epoch_ns = steady_ns();
+  return true;
+}
+
+uint64_t TraceWriter::now_us() const {
+  return (steady_ns() - m_epoch_ns) / 1000;
+}
+
+void TraceWriter::record(const std::string &method, const std::string &target,
+                         const std::string &body, int status,
+                         uint64_t arrival_us) {
+  uint64_t latency_us = now_us() - arrival_us;
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (!m_file)
+    return;
+
+  m_buffer.clear();
+  put_varint(m_buffer, arrival_us);
+  m_buffer.push_back(static_cast<char>(parse_trace_method(method)));
+  put_bytes(m_buffer, target);
+  put_bytes(m_buffer, body);
+  put_varint(m_buffer, status < 0 ? 0 : static_cast<uint64_t>(status));
+  put_varint(m_buffer, latency_us);
+  std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_file);
+}
+
+void TraceWriter::close() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_file) {
+    std::fclose(m_file);
+    m_file = nullptr;
+  }
+}
+
+// ============================================================================
+// READER
+// ============================================================================
+
+bool TraceReader::open(const std::string &path, std::string *error) {
+  m_in.open(path, std::ios::binary);
+  if (!m_in) {
+    if (error)
+      *error = "cannot open " + path;
+    return false;
+  }
+
+  char magic[sizeof(TRACE_MAGIC)];
+  uint32_t header[2];
+  m_in.read(magic, sizeof(magic));
+  m_in.read(reinterpret_cast<char *>(header), sizeof(header));
+  m_in.read(reinterpret_cast<char *>(&m_start_unix_us),
+            sizeof(m_start_unix_us));
+  if (!m_in || std::memcmp(magic, TRACE_MAGIC, sizeof(magic)) != 0) {
+    if (error)
+      *error = path + ": not a Kytin trace file";
+    return false;
+  }
+  if (header[0] != TRACE_VERSION) {
+    if (error)
+      *error = path + ": unsupported trace version " + std::to_string(header[0]);
+    return false;
+  }
+  return true;
+}
+
+bool TraceReader::read_varint(uint64_t &value) {
+  value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    int c = m_in.get();
+    if (c == EOF)
+      return false;
+    value |= uint64_t(c & 0x7F) << shift;
+    if (!(c & 0x80))
+      return true;
+  }
+  return false;
+}
+
+bool TraceReader::read_bytes(std::string &out) {
+  uint64_t len = 0;
+  if (!read_varint(len) || len > (64u << 20))
+    return false;
+  out.resize(len);
+  m_in.read(out.data(), static_cast<std::streamsize>(len));
+  return static_cast<uint64_t>(m_in.gcount()) == len;
+}
+
+bool TraceReader::next(TraceRecord &record) {
+  if (m_in.peek() == EOF)
+    return false; // Clean end of trace
+
+  uint64_t status = 0;
+  int method = 0;
+  bool ok = read_varint(record.offset_us) && (method = m_in.get()) != EOF &&
+            read_bytes(record.target) && read_bytes(record.body) &&
+            read_varint(status) && read_varint(record.latency_us);
+  if (!ok) {
+    m_error = "truncated record";
+    return false;
+  }
+  record.method = static_cast<TraceMethod>(method);
+  record.status = static_cast<uint32_t>(status);
+  return true;
+}
+
+} // namespace kytin
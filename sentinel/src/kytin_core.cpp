@@ -0,0 +1,781 @@
+/*
+ * Kytin Protocol - Sentinel Core
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ */
+
+#include "kytin_core.hpp"
+#include "kytin_log.hpp"
+#include "kytin_sha256.hpp"
+#include "kytin_trace.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <future>
+#include <thread>
+
+#include <unistd.h>
+
+using json = nlohmann::json;
+
+namespace kytin {
+
+// Event payloads on the signing path are built in the request arena and
+// copied out once, as the string the event ring keeps
+using arena_json =
+    nlohmann::basic_json<std::map, std::vector, ArenaString, bool, int64_t,
+                         uint64_t, double, ArenaAllocator>;
+
+// ============================================================================
+// HEARTBEAT MODES
+// ============================================================================
+
+uint64_t get_resin_cost(HeartbeatMode mode) {
+  switch (mode) {
+  case HeartbeatMode::ECO:
+    return 1;
+  case HeartbeatMode::TURBO:
+    return 1; // Still 1 per call, but called more frequently
+  default:
+    return 1;
+  }
+}
+
+HeartbeatMode parse_heartbeat_mode(std::string_view mode_str) {
+  if (mode_str == "TURBO")
+    return HeartbeatMode::TURBO;
+  return HeartbeatMode::ECO; // Default
+}
+
+const char *heartbeat_mode_name(HeartbeatMode mode) {
+  return mode == HeartbeatMode::TURBO ? "TURBO" : "ECO";
+}
+
+template <typename String>
+static void base64_append(std::span<const uint8_t> data, String &out) {
+  static const char *b64 =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+  const size_t start = out.size();
+  out.reserve(start + (data.size() + 2) / 3 * 4);
+  int val = 0, valb = -6;
+  for (uint8_t c : data) {
+    val = (val << 8) + c;
+    valb += 8;
+    while (valb >= 0) {
+      out.push_back(b64[(val >> valb) & 0x3F]);
+      valb -= 6;
+    }
+  }
+  if (valb > -6)
+    out.push_back(b64[((val << 8) >> (valb + 8)) & 0x3F]);
+  while ((out.size() - start) % 4)
+    out.push_back('=');
+}
+
+std::string base64_encode(const std::vector<uint8_t> &data) {
+  std::string out;
+  base64_append(data, out);
+  return out;
+}
+
+void base64_encode(std::span<const uint8_t> data, ArenaString &out) {
+  base64_append(data, out);
+}
+
+static uint64_t unix_seconds_now() {
+  return std::chrono::duration_cast<std::chrono::seconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+/**
+ * Audit detail of a signature: its sequence number, and the farm device
+ * that made it unless that was the identity TPM
+ */
+static std::array<char, 48> audit_detail(uint64_t sequence, uint32_t device) {
+  std::array<char, 48> detail{};
+  const auto seq = static_cast<unsigned long long>(sequence);
+  if (device)
+    std::snprintf(detail.data(), detail.size(), "seq=%llu tpm=%u", seq,
+                  device);
+  else
+    std::snprintf(detail.data(), detail.size(), "seq=%llu", seq);
+  return detail;
+}
+
+ArenaString sequence_string(uint64_t sequence) {
+  char buf[24];
+  const auto end = std::to_chars(buf, buf + sizeof(buf), sequence).ptr;
+  return ArenaString(buf, end);
+}
+
+// Events on the signing path are filled in key by key: the initializer-list
+// form builds (and frees, on the heap) a temporary array per key
+static std::string dump_event(const arena_json &event) {
+  const ArenaString text = event.dump();
+  return std::string(text.data(), text.size());
+}
+
+const char *core_status_name(SentinelCore::Status status) {
+  switch (status) {
+  case SentinelCore::Status::OK:
+    return "OK";
+  case SentinelCore::Status::INVALID_ARGUMENT:
+    return "INVALID_ARGUMENT";
+  case SentinelCore::Status::DEAD:
+    return "AGENT_DEAD";
+  case SentinelCore::Status::RESIN_DEPLETED:
+    return "RESIN_DEPLETED";
+  case SentinelCore::Status::POLICY_VIOLATION:
+    return "POLICY_VIOLATION";
+  case SentinelCore::Status::TPM_UNAVAILABLE:
+    return "TPM_UNAVAILABLE";
+  case SentinelCore::Status::SIGNING_FAILED:
+    return "SIGNING_FAILED";
+  case SentinelCore::Status::NOT_READY:
+    return "NOT_READY";
+  }
+  return "UNKNOWN";
+}
+
+// ============================================================================
+// LIFECYCLE & POLICY
+// ============================================================================
+
+SentinelCore::SentinelCore(uint64_t initial_resin)
+    : m_resin{.balance = initial_resin,
+              .lifetime_burned = 0,
+              .daily_limit = 1000,
+              .daily_consumed = 0,
+              .last_reset = std::chrono::system_clock::now()} {
+  apply_policy(m_policy.current());
+}
+
+bool SentinelCore::initialize(bool open_audit) {
+  const auto started = std::chrono::steady_clock::now();
+  const auto policy = m_policy.current();
+
+  // Audit log recovery (directory scan, segment mapping) is independent of
+  // the TPM, so overlap it with Esys_Initialize and the capability queries
+  std::future<std::unique_ptr<AuditLog>> audit;
+  if (open_audit && !policy->audit.dir.empty()) {
+    audit = std::async(std::launch::async, [options = policy->audit]() {
+      auto log = std::make_unique<AuditLog>();
+      std::string error;
+      if (!log->open(options, &error)) {
+        KYTIN_LOG_ERROR("KYTIN", error);
+        log.reset();
+      }
+      return log;
+    });
+  }
+
+  bool tpm_ok = m_farm.initialize(policy->tpm);
+  if (audit.valid()) {
+    m_audit = audit.get();
+    if (!m_audit)
+      return false;
+  }
+  if (!tpm_ok)
+    return false;
+
+  m_startup_ms = std::chrono::duration<double, std::milli>(
+                     std::chrono::steady_clock::now() - started)
+                     .count();
+  m_ready.store(true, std::memory_order_release);
+  return true;
+}
+
+void SentinelCore::shutdown() {
+  m_ready.store(false);
+  close_status_page();
+  m_farm.shutdown();
+  if (m_audit)
+    m_audit->close();
+}
+
+bool SentinelCore::open_audit() {
+  const auto policy = m_policy.current();
+  if (policy->audit.dir.empty())
+    return true;
+
+  auto log = std::make_unique<AuditLog>();
+  std::string error;
+  if (!log->open(policy->audit, &error)) {
+    KYTIN_LOG_ERROR("KYTIN", error);
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(m_state_mutex);
+  m_audit = std::move(log);
+  return true;
+}
+
+void SentinelCore::close_audit() {
+  std::unique_ptr<AuditLog> log;
+  {
+    std::lock_guard<std::mutex> lock(m_state_mutex);
+    log = std::move(m_audit);
+  }
+  if (log)
+    log->close();
+}
+
+bool SentinelCore::open_status_page() {
+  const auto policy = m_policy.current();
+  if (policy->status_page.name.empty())
+    return true;
+
+  const auto hw = m_tpm.get_hardware_info();
+  std::string error;
+  std::lock_guard<std::mutex> lock(m_state_mutex);
+  if (!m_status_page.open(policy->status_page.name, &error)) {
+    KYTIN_LOG_WARN("KYTIN", error);
+    return false;
+  }
+
+  // Fixed for the life of the process: copied once, not per update
+  m_status = StatusSnapshot{};
+  m_status.pid = static_cast<uint64_t>(getpid());
+  std::strncpy(m_status.hardware_id, hw.hardware_id.c_str(),
+               sizeof(m_status.hardware_id) - 1);
+  std::strncpy(m_status.manufacturer, hw.manufacturer.c_str(),
+               sizeof(m_status.manufacturer) - 1);
+  std::strncpy(m_status.firmware_version, hw.firmware_version.c_str(),
+               sizeof(m_status.firmware_version) - 1);
+  publish_status_locked();
+  return true;
+}
+
+void SentinelCore::close_status_page() {
+  std::lock_guard<std::mutex> lock(m_state_mutex);
+  m_status_page.close();
+}
+
+CoreState SentinelCore::export_state() const {
+  CoreState state;
+  std::lock_guard<std::mutex> lock(m_state_mutex);
+  state.resin = m_resin;
+  state.daily_spent_sol = m_daily_spent_sol;
+  state.is_dead = m_is_dead.load();
+  state.child_key = m_child_key;
+  state.last_will_signature = m_death_signature;
+  state.last_event_id = m_events.last_id();
+  return state;
+}
+
+void SentinelCore::import_state(const CoreState &state) {
+  std::lock_guard<std::mutex> lock(m_state_mutex);
+  const uint64_t daily_limit = m_resin.daily_limit; // Ours follows our policy
+  m_resin = state.resin;
+  m_resin.daily_limit = daily_limit;
+  m_daily_spent_sol = state.daily_spent_sol;
+  m_child_key = state.child_key;
+  m_death_signature = state.last_will_signature;
+  m_is_dead.store(state.is_dead);
+  m_events.continue_after(state.last_event_id);
+  publish_status_locked();
+}
+
+/**
+ * Push settings from a snapshot into components that keep their own copy
+ */
+void SentinelCore::apply_policy(const PolicyStore::SnapshotPtr &policy) {
+  m_farm.set_mock_profile(policy->mock_tpm);
+  m_sequence.set_nv_index(policy->sequence.nv_index);
+  set_log_level(policy->log_level);
+  set_log_format(policy->log_format);
+  set_trace_options(policy->trace);
+
+  std::lock_guard<std::mutex> lock(m_state_mutex);
+  m_resin.daily_limit = policy->resin_daily_limit;
+  publish_status_locked();
+}
+
+bool SentinelCore::load_policy(const std::string &path, std::string *error) {
+  if (!m_policy.load(path, error))
+    return false;
+  apply_policy(m_policy.current());
+  return true;
+}
+
+bool SentinelCore::reload_policy(std::string *error) {
+  if (!m_policy.reload(error))
+    return false;
+  apply_policy(m_policy.current());
+  return true;
+}
+
+// ============================================================================
+// OPERATIONS
+// ============================================================================
+
+/**
+ * Publish the current Resin counters. Called with m_state_mutex held so
+ * subscribers see balance changes in the order they happened.
+ */
+void SentinelCore::publish_resin_locked() {
+  arena_json event = arena_json::object();
+  event["balance"] = m_resin.balance;
+  event["lifetime_burned"] = m_resin.lifetime_burned;
+  event["daily_consumed"] = m_resin.daily_consumed;
+  m_events.publish(EventType::RESIN, dump_event(event));
+}
+
+/**
+ * Mirror the counters into the shared-memory status page. Called with
+ * m_state_mutex held, which makes the core the page's single writer.
+ */
+void SentinelCore::publish_status_locked() {
+  if (!m_status_page.is_open())
+    return;
+
+  const auto policy = m_policy.current();
+  m_status.updated_unix_ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::system_clock::now().time_since_epoch())
+          .count();
+  m_status.flags = (is_ready() ? StatusSnapshot::STATUS_READY : 0) |
+                   (m_farm.is_available() ? StatusSnapshot::STATUS_TPM_AVAILABLE
+                                          : 0) |
+                   (m_tpm.is_mock_mode() ? StatusSnapshot::STATUS_TPM_MOCK
+                                         : 0) |
+                   (m_is_dead.load() ? StatusSnapshot::STATUS_DEAD : 0);
+  m_status.resin_balance = m_resin.balance;
+  m_status.resin_lifetime_burned = m_resin.lifetime_burned;
+  m_status.resin_daily_limit = m_resin.daily_limit;
+  m_status.resin_daily_consumed = m_resin.daily_consumed;
+  m_status.daily_spent_sol = m_daily_spent_sol;
+  m_status.daily_limit_sol = policy->daily_limit_sol;
+  m_status.policy_generation = policy->generation;
+  m_status.heartbeats = m_heartbeats;
+  m_status.signs = m_signs;
+  m_status.last_event_id = m_events.last_id();
+  m_status_page.publish(m_status);
+}
+
+/**
+ * Record a signature in the audit log. Called with m_state_mutex held, which
+ * makes the core the log's single writer and keeps seq in signing order.
+ */
+void SentinelCore::audit_locked(AuditKind kind,
+                                std::span<const uint8_t> payload,
+                                const Sha256::Digest *payload_digest,
+                                const TPMInterface::Signature &signature,
+                                uint8_t mode, double amount_sol,
+                                std::string_view detail) {
+  if (!m_audit)
+    return;
+
+  AuditRecord record{}; // timestamp_us = 0: stamped by the log
+  record.kind = static_cast<uint8_t>(kind);
+  record.mode = mode;
+  record.resin_after = m_resin.balance;
+  record.amount_sol = amount_sol;
+
+  const auto digest = payload_digest
+                          ? *payload_digest
+                          : Sha256::hash(payload.data(), payload.size());
+  std::memcpy(record.payload_sha256, digest.data(), digest.size());
+
+  record.signature_len = static_cast<uint8_t>(
+      std::min(signature.data.size(), sizeof(record.signature)));
+  std::memcpy(record.signature, signature.data.data(), record.signature_len);
+  std::memcpy(record.detail, detail.data(),
+              std::min(detail.size(), sizeof(record.detail) - 1));
+
+  KYTIN_TRACE_SPAN("audit.append");
+  m_audit->append(record);
+}
+
+SentinelCore::HeartbeatResult
+SentinelCore::heartbeat(HeartbeatMode mode, std::span<const uint8_t> payload,
+                        const Sha256::Digest *payload_digest) {
+  HeartbeatResult result;
+  uint64_t resin_cost = get_resin_cost(mode);
+  if (!is_ready()) {
+    result.status = Status::NOT_READY;
+    return result;
+  }
+
+  auto lock = lock_state();
+
+  if (m_is_dead.load()) {
+    result.status = Status::DEAD;
+    return result;
+  }
+
+  // Check Resin balance, then the day's allowance (in-flight heartbeats
+  // included)
+  roll_daily_window_locked();
+  if (m_resin.balance < resin_cost) {
+    result.status = Status::RESIN_DEPLETED;
+    return result;
+  }
+  if (m_resin.daily_consumed + resin_cost > m_resin.daily_limit) {
+    result.status = Status::RESIN_DEPLETED;
+    result.daily_limit = true;
+    result.resin_remaining = m_resin.balance;
+    return result;
+  }
+
+  // Check TPM availability
+  if (!m_farm.is_available()) {
+    result.status = Status::TPM_UNAVAILABLE;
+    return result;
+  }
+
+  // Set the Resin aside and let other requests in while the TPM works
+  m_resin.balance -= resin_cost;
+  m_resin.daily_consumed += resin_cost;
+  const auto window = m_resin.last_reset;
+  lock.unlock();
+  auto signature = sign_sequenced(payload, result.sequence);
+  lock = lock_state();
+
+  if (!signature || m_is_dead.load()) {
+    // Refund; a Soul Transfer that won the race voids the signature
+    m_resin.balance += resin_cost;
+    if (m_resin.last_reset == window)
+      m_resin.daily_consumed -= resin_cost;
+    result.status = signature ? Status::DEAD : Status::SIGNING_FAILED;
+    return result;
+  }
+
+  // Deduct Resin
+  m_resin.lifetime_burned += resin_cost;
+  m_heartbeats++;
+  m_timeseries.record(unix_seconds_now(), resin_cost, 0, 1, 0);
+
+  result.signature = std::move(*signature);
+  result.resin_remaining = m_resin.balance;
+  const auto detail = audit_detail(result.sequence, result.signature.device);
+  audit_locked(AuditKind::HEARTBEAT, payload, payload_digest,
+               result.signature, static_cast<uint8_t>(mode), 0.0,
+               detail.data());
+
+  arena_json event = arena_json::object();
+  event["mode"] = heartbeat_mode_name(mode);
+  event["sequence"] = sequence_string(result.sequence);
+  ArenaString signature_b64;
+  base64_encode(result.signature.data, signature_b64);
+  event["signature"] = std::move(signature_b64);
+  event["timestamp"] = result.signature.timestamp;
+  event["resin_remaining"] = result.resin_remaining;
+  m_events.publish(EventType::HEARTBEAT, dump_event(event));
+  publish_resin_locked();
+  publish_status_locked();
+  return result;
+}
+
+/**
+ * Draw the next sequence number and sign it together with the payload on
+ * the farm. Called without m_state_mutex: numbers are unique and increase
+ * in the order they are drawn, but signatures on different devices may
+ * complete out of that order.
+ */
+std::optional<TPMInterface::Signature>
+SentinelCore::sign_sequenced(std::span<const uint8_t> payload,
+                             uint64_t &sequence) {
+  auto seq = m_sequence.next();
+  if (!seq)
+    return std::nullopt;
+  sequence = *seq;
+
+  ArenaBytes message(8 + payload.size());
+  for (int i = 0; i < 8; i++)
+    message[i] = static_cast<uint8_t>(sequence >> (56 - 8 * i));
+  std::copy(payload.begin(), payload.end(), message.begin() + 8);
+  return m_farm.sign(message);
+}
+
+/**
+ * Take m_state_mutex for a signing operation; the wait is traced separately
+ * so TPM time and queueing behind other signers can be told apart
+ */
+std::unique_lock<std::mutex> SentinelCore::lock_state() {
+  KYTIN_TRACE_SPAN("core.lock_wait");
+  return std::unique_lock<std::mutex>(m_state_mutex);
+}
+
+/**
+ * Start a new resin.daily_limit window once the current one is a day old
+ */
+void SentinelCore::roll_daily_window_locked() {
+  const auto now = std::chrono::system_clock::now();
+  // A clock stepped back also starts over, rather than wait out the gap
+  if (now - m_resin.last_reset >= std::chrono::hours(24) ||
+      now < m_resin.last_reset)
+    m_resin.reset_daily();
+}
+
+void SentinelCore::credit_resin(uint64_t amount) {
+  if (amount == 0)
+    return;
+
+  std::lock_guard<std::mutex> lock(m_state_mutex);
+  m_resin.balance += amount;
+  publish_resin_locked();
+  publish_status_locked();
+}
+
+/**
+ * A spend the daily window can account for. NaN compares false against the
+ * limit and would then stick in the total; a negative amount would lower it.
+ */
+static bool valid_amount(double amount_sol) {
+  return std::isfinite(amount_sol) && amount_sol >= 0.0;
+}
+
+SentinelCore::SignResult SentinelCore::sign(std::span<const uint8_t> tx,
+                                            double amount_sol,
+                                            const Sha256::Digest *tx_digest) {
+  SignResult result;
+  const auto policy = m_policy.current();
+  result.daily_limit_sol = policy->daily_limit_sol;
+  if (!is_ready()) {
+    result.status = Status::NOT_READY;
+    return result;
+  }
+
+  auto lock = lock_state();
+  result.daily_spent_sol = m_daily_spent_sol + m_reserved_sol;
+
+  if (m_is_dead.load()) {
+    result.status = Status::DEAD;
+    return result;
+  }
+
+  if (!valid_amount(amount_sol)) {
+    result.status = Status::INVALID_ARGUMENT;
+    return result;
+  }
+
+  // Check daily limit, counting signatures still at the TPM
+  if (result.daily_spent_sol + amount_sol > policy->daily_limit_sol) {
+    result.status = Status::POLICY_VIOLATION;
+    return result;
+  }
+
+  // Check TPM availability
+  if (!m_farm.is_available()) {
+    result.status = Status::TPM_UNAVAILABLE;
+    return result;
+  }
+
+  // Hold the amount against the limit and let other requests in while the
+  // TPM works
+  m_reserved_sol += amount_sol;
+  m_signs_in_flight++;
+  lock.unlock();
+  auto signature = sign_sequenced(tx, result.sequence);
+  lock = lock_state();
+
+  // Exactly zero once nothing is in flight, whatever rounding built up
+  m_reserved_sol = --m_signs_in_flight ? m_reserved_sol - amount_sol : 0.0;
+  if (!signature || m_is_dead.load()) {
+    result.status = signature ? Status::DEAD : Status::SIGNING_FAILED;
+    return result;
+  }
+
+  // Update daily spent
+  m_daily_spent_sol += amount_sol;
+  m_signs++;
+  const uint64_t lamports =
+      amount_sol > 0.0 ? static_cast<uint64_t>(std::llround(amount_sol * 1e9))
+                       : 0;
+  m_timeseries.record(unix_seconds_now(), 0, lamports, 0, 1);
+
+  result.signature = std::move(*signature);
+  result.daily_spent_sol = m_daily_spent_sol;
+  const auto detail = audit_detail(result.sequence, result.signature.device);
+  audit_locked(AuditKind::SIGN, tx, tx_digest, result.signature, 0,
+               amount_sol, detail.data());
+
+  arena_json event = arena_json::object();
+  event["amount_sol"] = amount_sol;
+  event["sequence"] = sequence_string(result.sequence);
+  ArenaString signature_b64;
+  base64_encode(result.signature.data, signature_b64);
+  event["signature"] = std::move(signature_b64);
+  event["timestamp"] = result.signature.timestamp;
+  event["daily_spent_sol"] = result.daily_spent_sol;
+  event["daily_limit_sol"] = result.daily_limit_sol;
+  m_events.publish(EventType::SIGN, dump_event(event));
+  publish_status_locked();
+  return result;
+}
+
+/**
+ * Run fn(begin, end) over [0, n) in chunks of at least `grain`, one chunk
+ * per hardware thread; the calling thread takes the first chunk
+ */
+template <typename Fn>
+static void parallel_chunks(size_t n, size_t grain, Fn fn) {
+  const size_t threads = std::max(1u, std::thread::hardware_concurrency());
+  const size_t chunk = std::max(grain, (n + threads - 1) / threads);
+  std::vector<std::future<void>> rest;
+  for (size_t begin = chunk; begin < n; begin += chunk)
+    rest.push_back(std::async(std::launch::async, fn, begin,
+                              std::min(n, begin + chunk)));
+  fn(size_t{0}, std::min(n, chunk));
+  for (auto &f : rest)
+    f.get();
+}
+
+SentinelCore::EvaluateResult
+SentinelCore::evaluate(const std::vector<double> &amounts_sol,
+                       bool cumulative) const {
+  // Below this many items per thread, spawning costs more than it saves
+  constexpr size_t EVALUATE_GRAIN = 2048;
+
+  EvaluateResult result;
+  const auto policy = m_policy.current();
+  result.daily_limit_sol = policy->daily_limit_sol;
+  result.policy_generation = policy->generation;
+  result.items.resize(amounts_sol.size());
+
+  // Same order of checks as sign(), against one copy of the window: the
+  // Sentinel's state for every item, then per item the amount, the limit
+  // and the TPM
+  Status common = Status::OK;
+  bool tpm_available;
+  {
+    std::lock_guard<std::mutex> lock(m_state_mutex);
+    result.daily_spent_sol = m_daily_spent_sol + m_reserved_sol;
+    if (!is_ready())
+      common = Status::NOT_READY;
+    else if (m_is_dead.load())
+      common = Status::DEAD;
+    tpm_available = m_farm.is_available();
+  }
+
+  // Within the limit: signed, unless there is no TPM to sign with
+  const Status within = tpm_available ? Status::OK : Status::TPM_UNAVAILABLE;
+  const double limit = result.daily_limit_sol;
+  auto judge = [&](double amount_sol, double spent_sol) {
+    if (!valid_amount(amount_sol))
+      return Status::INVALID_ARGUMENT;
+    return spent_sol + amount_sol > limit ? Status::POLICY_VIOLATION : within;
+  };
+
+  double spent = result.daily_spent_sol;
+  if (common != Status::OK || cumulative) {
+    // Each verdict depends on the ones before it: one pass, in order
+    for (size_t i = 0; i < amounts_sol.size(); i++) {
+      auto &item = result.items[i];
+      item.status =
+          common == Status::OK ? judge(amounts_sol[i], spent) : common;
+      if (item.status == Status::OK)
+        spent += amounts_sol[i];
+      item.remaining_sol = limit - spent;
+    }
+    return result;
+  }
+
+  parallel_chunks(amounts_sol.size(), EVALUATE_GRAIN,
+                  [&](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; i++) {
+                      auto &item = result.items[i];
+                      item.status = judge(amounts_sol[i], spent);
+                      item.remaining_sol =
+                          limit - spent -
+                          (item.status == Status::OK ? amounts_sol[i] : 0.0);
+                    }
+                  });
+  return result;
+}
+
+SentinelCore::MigrateResult
+SentinelCore::migrate(const std::string &child_key) {
+  MigrateResult result;
+  if (!is_ready()) {
+    result.status = Status::NOT_READY;
+    return result;
+  }
+
+  auto lock = lock_state();
+
+  if (m_is_dead.load()) {
+    result.status = Status::DEAD;
+    return result;
+  }
+
+  if (child_key.empty()) {
+    result.status = Status::INVALID_ARGUMENT;
+    return result;
+  }
+
+  if (!m_tpm.is_available()) {
+    result.status = Status::TPM_UNAVAILABLE;
+    return result;
+  }
+
+  // Sign the migration payload - THIS IS THE "LAST WILL". Always on the
+  // identity TPM, never another farm device, and under the state lock so
+  // signatures still at the farm are voided rather than released.
+  result.payload = "MIGRATE_AUTHORITY_TO:" + child_key;
+  const std::vector<uint8_t> payload(result.payload.begin(),
+                                     result.payload.end());
+  auto signature = m_tpm.sign(payload);
+
+  if (!signature) {
+    result.status = Status::SIGNING_FAILED;
+    return result;
+  }
+
+  // ***** CRITICAL: SET IS_DEAD FLAG *****
+  // This is IRREVERSIBLE - the Sentinel is now dead
+  m_death_signature = base64_encode(signature->data);
+  m_child_key = child_key;
+  m_is_dead.store(true);
+
+  result.signature = std::move(*signature);
+  audit_locked(AuditKind::MIGRATE, payload, nullptr, result.signature, 0,
+               0.0, child_key);
+
+  m_events.publish(EventType::SOUL_TRANSFER,
+                   json{{"child_key", m_child_key},
+                        {"last_will_signature", m_death_signature},
+                        {"payload", result.payload}}
+                       .dump());
+  publish_status_locked();
+  return result;
+}
+
+std::optional<SentinelCore::DeathCertificate>
+SentinelCore::death_certificate() const {
+  if (!m_is_dead.load())
+    return std::nullopt;
+
+  std::lock_guard<std::mutex> lock(m_state_mutex);
+  return DeathCertificate{.child_key = m_child_key,
+                          .last_will_signature = m_death_signature};
+}
+
+SentinelCore::Snapshot SentinelCore::snapshot() const {
+  Snapshot snap;
+  snap.policy = m_policy.current();
+
+  std::lock_guard<std::mutex> lock(m_state_mutex);
+  snap.resin = m_resin;
+  snap.daily_spent_sol = m_daily_spent_sol;
+  if (is_ready()) {
+    snap.hardware = m_tpm.get_hardware_info();
+    snap.tpm_available = m_farm.is_available();
+  }
+  snap.is_dead = m_is_dead.load();
+  return snap;
+}
+
+} // namespace kytin
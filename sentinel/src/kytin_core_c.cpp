@@ -0,0 +1,276 @@
+/*
+ * Kytin Protocol - Sentinel Core C API
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ *
+ * extern "C" wrapper over kytin::SentinelCore. No exception may cross the
+ * ABI boundary; anything unexpected maps to KYTIN_ERR_INTERNAL.
+ */
+
+#include "kytin_core.h"
+#include "kytin_core.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+
+// Frozen layouts (see the ABI rules in kytin_core.h): new fields go in a
+// size-prefixed *_ext_t struct instead
+static_assert(sizeof(kytin_signature_t) == 112);
+static_assert(sizeof(kytin_core_status_t) == 72);
+
+struct kytin_core {
+  kytin::SentinelCore core;
+};
+
+namespace {
+
+kytin_result_t to_result(kytin::SentinelCore::Status status) {
+  using Status = kytin::SentinelCore::Status;
+  switch (status) {
+  case Status::OK:
+    return KYTIN_OK;
+  case Status::INVALID_ARGUMENT:
+    return KYTIN_ERR_INVALID_ARGUMENT;
+  case Status::DEAD:
+    return KYTIN_ERR_DEAD;
+  case Status::RESIN_DEPLETED:
+    return KYTIN_ERR_RESIN_DEPLETED;
+  case Status::POLICY_VIOLATION:
+    return KYTIN_ERR_POLICY_VIOLATION;
+  case Status::TPM_UNAVAILABLE:
+  case Status::NOT_READY: // Not reachable: kytin_core_create() initializes
+    return KYTIN_ERR_TPM_UNAVAILABLE;
+  case Status::SIGNING_FAILED:
+    return KYTIN_ERR_SIGNING_FAILED;
+  }
+  return KYTIN_ERR_INTERNAL;
+}
+
+void copy_signature(const kytin::TPMInterface::Signature &in,
+                    kytin_signature_t *out) {
+  if (!out)
+    return;
+  std::memset(out, 0, sizeof(*out));
+  out->length = static_cast<uint32_t>(
+      std::min<size_t>(in.data.size(), KYTIN_SIGNATURE_MAX));
+  std::memcpy(out->data, in.data.data(), out->length);
+  out->timestamp = in.timestamp;
+  std::strncpy(out->algorithm, in.algorithm.c_str(),
+               sizeof(out->algorithm) - 1);
+}
+
+// Whether the caller's kytin_signature_ext_t is large enough to have `field`
+#define SIGNATURE_EXT_HAS(ext, field)                                          \
+  ((ext)->size >= offsetof(kytin_signature_ext_t, field) + sizeof((ext)->field))
+
+void copy_ext(const kytin::TPMInterface::Signature &in, uint64_t sequence,
+              kytin_signature_ext_t *ext) {
+  if (!ext)
+    return;
+  if (SIGNATURE_EXT_HAS(ext, sequence))
+    ext->sequence = sequence;
+  if (SIGNATURE_EXT_HAS(ext, device))
+    ext->device = in.device;
+}
+
+template <typename Fn> kytin_result_t guarded(Fn &&fn) {
+  try {
+    return fn();
+  } catch (...) {
+    return KYTIN_ERR_INTERNAL;
+  }
+}
+
+} // namespace
+
+extern "C" {
+
+uint32_t kytin_core_abi_version(void) { return KYTIN_CORE_ABI_VERSION; }
+
+kytin_result_t kytin_core_create(const char *config_path, kytin_core_t **out) {
+  if (!out)
+    return KYTIN_ERR_INVALID_ARGUMENT;
+  *out = nullptr;
+
+  return guarded([&] {
+    auto handle = std::make_unique<kytin_core>();
+    if (config_path && !handle->core.load_policy(config_path))
+      return KYTIN_ERR_CONFIG;
+    if (!handle->core.initialize())
+      return KYTIN_ERR_TPM_UNAVAILABLE;
+    *out = handle.release();
+    return KYTIN_OK;
+  });
+}
+
+void kytin_core_destroy(kytin_core_t *core) {
+  if (!core)
+    return;
+  core->core.shutdown();
+  delete core;
+}
+
+kytin_result_t kytin_core_reload(kytin_core_t *core) {
+  if (!core)
+    return KYTIN_ERR_INVALID_ARGUMENT;
+  return guarded([&] {
+    return core->core.reload_policy() ? KYTIN_OK : KYTIN_ERR_CONFIG;
+  });
+}
+
+kytin_result_t kytin_heartbeat(kytin_core_t *core, kytin_heartbeat_mode_t mode,
+                               const uint8_t *payload, size_t payload_len,
+                               kytin_signature_t *signature,
+                               uint64_t *resin_remaining) {
+  return kytin_heartbeat_ex(core, mode, payload, payload_len, signature,
+                            nullptr, resin_remaining);
+}
+
+kytin_result_t kytin_heartbeat_ex(kytin_core_t *core,
+                                  kytin_heartbeat_mode_t mode,
+                                  const uint8_t *payload, size_t payload_len,
+                                  kytin_signature_t *signature,
+                                  kytin_signature_ext_t *ext,
+                                  uint64_t *resin_remaining) {
+  if (!core || (!payload && payload_len))
+    return KYTIN_ERR_INVALID_ARGUMENT;
+
+  return guarded([&] {
+    auto result = core->core.heartbeat(
+        mode == KYTIN_MODE_TURBO ? kytin::HeartbeatMode::TURBO
+                                 : kytin::HeartbeatMode::ECO,
+        std::span<const uint8_t>(payload, payload_len));
+    if (result.status == kytin::SentinelCore::Status::OK) {
+      copy_signature(result.signature, signature);
+      copy_ext(result.signature, result.sequence, ext);
+      if (resin_remaining)
+        *resin_remaining = result.resin_remaining;
+    }
+    return to_result(result.status);
+  });
+}
+
+kytin_result_t kytin_sign(kytin_core_t *core, const uint8_t *tx, size_t tx_len,
+                          double amount_sol, kytin_signature_t *signature,
+                          double *daily_remaining_sol) {
+  return kytin_sign_ex(core, tx, tx_len, amount_sol, signature, nullptr,
+                       daily_remaining_sol);
+}
+
+kytin_result_t kytin_sign_ex(kytin_core_t *core, const uint8_t *tx,
+                             size_t tx_len, double amount_sol,
+                             kytin_signature_t *signature,
+                             kytin_signature_ext_t *ext,
+                             double *daily_remaining_sol) {
+  if (!core || (!tx && tx_len))
+    return KYTIN_ERR_INVALID_ARGUMENT;
+
+  return guarded([&] {
+    auto result =
+        core->core.sign(std::span<const uint8_t>(tx, tx_len), amount_sol);
+    if (result.status == kytin::SentinelCore::Status::OK) {
+      copy_signature(result.signature, signature);
+      copy_ext(result.signature, result.sequence, ext);
+    }
+    if (daily_remaining_sol)
+      *daily_remaining_sol = result.daily_limit_sol - result.daily_spent_sol;
+    return to_result(result.status);
+  });
+}
+
+kytin_result_t kytin_migrate(kytin_core_t *core, const char *child_key,
+                             kytin_signature_t *signature) {
+  if (!core || !child_key)
+    return KYTIN_ERR_INVALID_ARGUMENT;
+
+  return guarded([&] {
+    auto result = core->core.migrate(child_key);
+    if (result.status == kytin::SentinelCore::Status::OK)
+      copy_signature(result.signature, signature);
+    return to_result(result.status);
+  });
+}
+
+kytin_result_t kytin_core_status(kytin_core_t *core,
+                                 kytin_core_status_t *status) {
+  if (!core || !status)
+    return KYTIN_ERR_INVALID_ARGUMENT;
+
+  return guarded([&] {
+    auto snap = core->core.snapshot();
+    std::memset(status, 0, sizeof(*status));
+    status->resin_balance = snap.resin.balance;
+    status->resin_lifetime_burned = snap.resin.lifetime_burned;
+    status->resin_daily_limit = snap.policy->resin_daily_limit;
+    status->resin_daily_consumed = snap.resin.daily_consumed;
+    status->daily_spent_sol = snap.daily_spent_sol;
+    status->daily_limit_sol = snap.policy->daily_limit_sol;
+    status->policy_generation = snap.policy->generation;
+    status->tpm_available = snap.tpm_available;
+    status->tpm_mock_mode = snap.hardware.is_mock;
+    status->is_dead = snap.is_dead;
+    return KYTIN_OK;
+  });
+}
+
+kytin_result_t kytin_core_device_count(kytin_core_t *core, uint32_t *count) {
+  if (!core || !count)
+    return KYTIN_ERR_INVALID_ARGUMENT;
+  *count = static_cast<uint32_t>(core->core.farm().size());
+  return KYTIN_OK;
+}
+
+kytin_result_t kytin_core_device_public_key(kytin_core_t *core,
+                                            uint32_t device,
+                                            kytin_device_key_t *key) {
+  if (!core || !key || device >= core->core.farm().size())
+    return KYTIN_ERR_INVALID_ARGUMENT;
+
+  return guarded([&] {
+    // A copy taken under the farm's lock: the device may not have signed
+    // anything yet, or be coming up right now
+    const auto stats = core->core.farm().stats();
+    const auto &entry = stats[device];
+    if (entry.hardware_id.empty())
+      return KYTIN_ERR_TPM_UNAVAILABLE;
+    std::memset(key, 0, sizeof(*key));
+    std::strncpy(key->hardware_id, entry.hardware_id.c_str(),
+                 sizeof(key->hardware_id) - 1);
+    key->public_key_length = static_cast<uint32_t>(
+        std::min<size_t>(entry.public_key.size(), KYTIN_PUBLIC_KEY_MAX));
+    std::memcpy(key->public_key, entry.public_key.data(),
+                key->public_key_length);
+    return KYTIN_OK;
+  });
+}
+
+const char *kytin_result_name(kytin_result_t result) {
+  switch (result) {
+  case KYTIN_OK:
+    return "OK";
+  case KYTIN_ERR_INVALID_ARGUMENT:
+    return "INVALID_ARGUMENT";
+  case KYTIN_ERR_DEAD:
+    return "AGENT_DEAD";
+  case KYTIN_ERR_RESIN_DEPLETED:
+    return "RESIN_DEPLETED";
+  case KYTIN_ERR_POLICY_VIOLATION:
+    return "POLICY_VIOLATION";
+  case KYTIN_ERR_TPM_UNAVAILABLE:
+    return "TPM_UNAVAILABLE";
+  case KYTIN_ERR_SIGNING_FAILED:
+    return "SIGNING_FAILED";
+  case KYTIN_ERR_CONFIG:
+    return "CONFIG_INVALID";
+  case KYTIN_ERR_INTERNAL:
+    return "INTERNAL_ERROR";
+  }
+  return "UNKNOWN";
+}
+
+} // extern "C"
@@ -0,0 +1,104 @@
+/*
+ * Kytin Protocol - Sentinel Event Bus
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ */
+
+#include "kytin_events.hpp"
+
+#include <algorithm>
+
+namespace kytin {
+
+const char *event_type_name(EventType type) {
+  switch (type) {
+  case EventType::HEARTBEAT:
+    return "heartbeat";
+  case EventType::SIGN:
+    return "sign";
+  case EventType::RESIN:
+    return "resin";
+  case EventType::SOUL_TRANSFER:
+    return "soul_transfer";
+  }
+  return "unknown";
+}
+
+static size_t round_up_pow2(size_t n) {
+  size_t p = 1;
+  while (p < n)
+    p <<= 1;
+  return p;
+}
+
+EventBus::EventBus(size_t capacity)
+    : m_ring(round_up_pow2(capacity < 2 ? 2 : capacity)),
+      m_mask(m_ring.size() - 1) {}
+
+uint64_t EventBus::publish(EventType type, std::string data) {
+  uint64_t id;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    id = m_last_id.load(std::memory_order_relaxed) + 1;
+    SentinelEvent &slot = m_ring[id & m_mask];
+    slot.id = id;
+    slot.type = type;
+    slot.data = std::move(data);
+    m_last_id.store(id, std::memory_order_release);
+  }
+  m_cv.notify_all();
+  return id;
+}
+
+EventBus::ReadResult EventBus::read(uint64_t after_id,
+                                    std::vector<SentinelEvent> &out,
+                                    size_t max) const {
+  ReadResult result;
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  uint64_t last = m_last_id.load(std::memory_order_relaxed);
+  if (after_id > last)
+    after_id = last; // Cursor from a previous process; restart at the tip
+
+  uint64_t oldest = last >= m_ring.size() ? last - m_ring.size() + 1 : 1;
+  oldest = std::max(oldest, m_first_id);
+  uint64_t next = after_id + 1;
+  if (next < oldest) {
+    result.dropped = oldest - next;
+    next = oldest;
+  }
+
+  for (; next <= last && max > 0; next++) {
+    const SentinelEvent &ev = m_ring[next & m_mask];
+    // Coalesce: a resin update supersedes the one right before it
+    if (ev.type == EventType::RESIN && !out.empty() &&
+        out.back().type == EventType::RESIN) {
+      out.back() = ev;
+      continue;
+    }
+    out.push_back(ev);
+    max--;
+  }
+
+  result.next_cursor = next - 1;
+  return result;
+}
+
+void EventBus::continue_after(uint64_t last_id) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_last_id.store(last_id, std::memory_order_release);
+  m_first_id = last_id + 1;
+}
+
+bool EventBus::wait(uint64_t after_id,
+                    std::chrono::milliseconds timeout) const {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  return m_cv.wait_for(lock, timeout, [&] {
+    return m_last_id.load(std::memory_order_relaxed) > after_id;
+  });
+}
+
+} // namespace kytin
@@ -0,0 +1,231 @@
+/*
+ * Kytin Protocol - Hot Upgrade Handoff
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ */
+
+#include "kytin_handoff.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using json = nlohmann::json;
+
+namespace kytin {
+
+static constexpr uint32_t MAX_FRAME = 16u << 20;
+
+// ============================================================================
+// STATE ENCODING
+// ============================================================================
+
+std::string encode_handoff(const Handoff &handoff) {
+  const auto &core = handoff.core;
+  json beats = json::array();
+  for (const auto &beat : handoff.beats)
+    beats.push_back({{"id", beat.id},
+                     {"turbo", beat.turbo},
+                     {"seq", beat.seq},
+                     {"due_unix_ms", beat.due_unix_ms}});
+
+  return json{{"resin",
+               {{"balance", core.resin.balance},
+                {"lifetime_burned", core.resin.lifetime_burned},
+                {"daily_limit", core.resin.daily_limit},
+                {"daily_consumed", core.resin.daily_consumed},
+                {"last_reset_ms",
+                 std::chrono::duration_cast<std::chrono::milliseconds>(
+                     core.resin.last_reset.time_since_epoch())
+                     .count()}}},
+              {"daily_spent_sol", core.daily_spent_sol},
+              {"is_dead", core.is_dead},
+              {"child_key", core.child_key},
+              {"last_will_signature", core.last_will_signature},
+              {"last_event_id", core.last_event_id},
+              {"beats", std::move(beats)}}
+      .dump();
+}
+
+bool decode_handoff(const std::string &payload, Handoff &handoff,
+                    std::string *error) {
+  try {
+    json doc = json::parse(payload);
+    const auto &resin = doc.at("resin");
+    auto &core = handoff.core;
+    core.resin.balance = resin.at("balance").get<uint64_t>();
+    core.resin.lifetime_burned = resin.at("lifetime_burned").get<uint64_t>();
+    core.resin.daily_limit = resin.at("daily_limit").get<uint64_t>();
+    core.resin.daily_consumed = resin.at("daily_consumed").get<uint64_t>();
+    core.resin.last_reset = std::chrono::system_clock::time_point(
+        std::chrono::milliseconds(resin.at("last_reset_ms").get<int64_t>()));
+    core.daily_spent_sol = doc.at("daily_spent_sol").get<double>();
+    core.is_dead = doc.at("is_dead").get<bool>();
+    core.child_key = doc.at("child_key").get<std::string>();
+    core.last_will_signature = doc.at("last_will_signature").get<std::string>();
+    core.last_event_id = doc.at("last_event_id").get<uint64_t>();
+
+    handoff.beats.clear();
+    for (const auto &entry : doc.at("beats")) {
+      ParkedBeat beat;
+      beat.id = entry.at("id").get<std::string>();
+      beat.turbo = entry.at("turbo").get<bool>();
+      beat.seq = entry.at("seq").get<uint64_t>();
+      beat.due_unix_ms = entry.at("due_unix_ms").get<uint64_t>();
+      handoff.beats.push_back(std::move(beat));
+    }
+    return true;
+  } catch (const json::exception &e) {
+    if (error)
+      *error = std::string("malformed handoff state: ") + e.what();
+    return false;
+  }
+}
+
+// ============================================================================
+// FRAMING
+// ============================================================================
+
+bool handoff_send(int channel, const std::string &payload, int fd) {
+  std::string frame(4, '\0');
+  const uint32_t size = static_cast<uint32_t>(payload.size());
+  for (int i = 0; i < 4; i++)
+    frame[i] = static_cast<char>(size >> (24 - 8 * i));
+  frame += payload;
+
+  size_t sent = 0;
+  while (sent < frame.size()) {
+    iovec iov{frame.data() + sent, frame.size() - sent};
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+
+    // The descriptor rides on the first chunk only
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+    if (fd >= 0 && sent == 0) {
+      msg.msg_control = control;
+      msg.msg_controllen = sizeof(control);
+      cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+      cmsg->cmsg_level = SOL_SOCKET;
+      cmsg->cmsg_type = SCM_RIGHTS;
+      cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+      std::memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+    }
+
+    ssize_t n = sendmsg(channel, &msg, MSG_NOSIGNAL);
+    if (n < 0) {
+      if (errno == EINTR)
+        continue;
+      return false;
+    }
+    sent += static_cast<size_t>(n);
+  }
+  return true;
+}
+
+/**
+ * Read exactly `size` bytes, collecting a passed descriptor if one arrives
+ */
+static bool recv_exact(int channel, char *data, size_t size, int *fd,
+                       std::chrono::steady_clock::time_point deadline,
+                       bool has_deadline, std::string &error) {
+  size_t got = 0;
+  while (got < size) {
+    if (has_deadline) {
+      auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                      deadline - std::chrono::steady_clock::now())
+                      .count();
+      if (left <= 0) {
+        error = "timed out";
+        return false;
+      }
+      pollfd pfd{channel, POLLIN, 0};
+      int ready = poll(&pfd, 1, static_cast<int>(left));
+      if (ready < 0 && errno != EINTR) {
+        error = std::strerror(errno);
+        return false;
+      }
+      if (ready <= 0)
+        continue;
+    }
+
+    iovec iov{data + got, size - got};
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    ssize_t n = recvmsg(channel, &msg, MSG_CMSG_CLOEXEC);
+    if (n < 0) {
+      if (errno == EINTR)
+        continue;
+      error = std::strerror(errno);
+      return false;
+    }
+    if (n == 0) {
+      error = "peer closed the channel";
+      return false;
+    }
+    for (cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg;
+         cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+      if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+        int passed;
+        std::memcpy(&passed, CMSG_DATA(cmsg), sizeof(int));
+        if (fd && *fd < 0)
+          *fd = passed;
+        else
+          close(passed);
+      }
+    }
+    got += static_cast<size_t>(n);
+  }
+  return true;
+}
+
+bool handoff_recv(int channel, std::string &payload, int *fd,
+                  uint32_t timeout_ms, std::string *error) {
+  if (fd)
+    *fd = -1;
+  const auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::milliseconds(timeout_ms);
+  std::string reason;
+
+  unsigned char header[4];
+  bool ok = recv_exact(channel, reinterpret_cast<char *>(header), 4, fd,
+                       deadline, timeout_ms > 0, reason);
+  if (ok) {
+    uint32_t size = (uint32_t{header[0]} << 24) | (uint32_t{header[1]} << 16) |
+                    (uint32_t{header[2]} << 8) | header[3];
+    if (size > MAX_FRAME) {
+      reason = "frame too large";
+      ok = false;
+    } else {
+      payload.resize(size);
+      ok = recv_exact(channel, payload.data(), size, fd, deadline,
+                      timeout_ms > 0, reason);
+    }
+  }
+
+  if (!ok) {
+    if (fd && *fd >= 0) {
+      close(*fd);
+      *fd = -1;
+    }
+    if (error)
+      *error = reason;
+  }
+  return ok;
+}
+
+} // namespace kytin
@@ -0,0 +1,443 @@
+/*
+ * Kytin Protocol - Asynchronous Logging
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ */
+
+#include "kytin_log.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace kytin {
+
+namespace detail {
+std::atomic<uint8_t> g_log_level{static_cast<uint8_t>(LogLevel::INFO)};
+} // namespace detail
+
+namespace {
+
+std::atomic<uint8_t> g_log_format{static_cast<uint8_t>(LogFormat::TEXT)};
+
+// Set once the drain thread has been torn down (static destruction); later
+// log statements are written synchronously instead of queued
+std::atomic<bool> g_log_closed{false};
+
+constexpr size_t RING_SLOTS = 256; // Per thread, power of two
+
+// ============================================================================
+// PER-THREAD RING
+// ============================================================================
+
+/**
+ * Single-producer (owning thread) / single-consumer (drain thread) ring
+ */
+struct LogRing {
+  detail::LogRecord slots[RING_SLOTS];
+  alignas(64) std::atomic<uint64_t> head{0}; // Next slot to write
+  alignas(64) std::atomic<uint64_t> tail{0}; // Next slot to drain
+  std::atomic<uint64_t> dropped{0};
+  std::atomic<bool> orphaned{false}; // Owning thread has exited
+};
+
+struct ThreadLog {
+  std::shared_ptr<LogRing> ring;
+
+  ~ThreadLog() {
+    if (ring)
+      ring->orphaned.store(true, std::memory_order_release);
+  }
+};
+
+thread_local ThreadLog t_log;
+
+// Trivially destructible, so still usable from static destructors that run
+// after this thread's t_log is gone
+thread_local detail::LogRecord t_sync_record;
+thread_local bool t_sync = false;
+
+// ============================================================================
+// FORMATTING
+// ============================================================================
+
+void append_json_escaped(std::string &out, std::string_view s) {
+  for (char c : s) {
+    switch (c) {
+    case '"':
+      out += "\\\"";
+      break;
+    case '\\':
+      out += "\\\\";
+      break;
+    case '\n':
+      out += "\\n";
+      break;
+    case '\t':
+      out += "\\t";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20) {
+        char buf[8];
+        std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+        out += buf;
+      } else {
+        out.push_back(c);
+      }
+    }
+  }
+}
+
+/**
+ * Decode the binary argument list back into text
+ */
+void decode_message(const detail::LogRecord &rec, std::string &out) {
+  using detail::LogArg;
+  char buf[32];
+  size_t pos = 0;
+
+  while (pos < rec.size) {
+    auto type = static_cast<LogArg>(rec.payload[pos++]);
+    const uint8_t *p = rec.payload + pos;
+    switch (type) {
+    case LogArg::I64: {
+      int64_t v;
+      std::memcpy(&v, p, sizeof(v));
+      std::snprintf(buf, sizeof(buf), "%lld", static_cast<long long>(v));
+      out += buf;
+      pos += sizeof(v);
+      break;
+    }
+    case LogArg::U64: {
+      uint64_t v;
+      std::memcpy(&v, p, sizeof(v));
+      std::snprintf(buf, sizeof(buf), "%llu",
+                    static_cast<unsigned long long>(v));
+      out += buf;
+      pos += sizeof(v);
+      break;
+    }
+    case LogArg::F64: {
+      double v;
+      std::memcpy(&v, p, sizeof(v));
+      std::snprintf(buf, sizeof(buf), "%g", v);
+      out += buf;
+      pos += sizeof(v);
+      break;
+    }
+    case LogArg::BOOL:
+      out += *p ? "true" : "false";
+      pos += 1;
+      break;
+    case LogArg::CHAR:
+      out.push_back(static_cast<char>(*p));
+      pos += 1;
+      break;
+    case LogArg::STR: {
+      uint16_t n;
+      std::memcpy(&n, p, sizeof(n));
+      out.append(reinterpret_cast<const char *>(p + sizeof(n)), n);
+      pos += sizeof(n) + n;
+      break;
+    }
+    default:
+      return; // Corrupt record; keep what we have
+    }
+  }
+  if (rec.truncated)
+    out += "...";
+}
+
+/**
+ * Format one record as a complete output line
+ */
+void format_record(const detail::LogRecord &rec, LogFormat format,
+                   std::string &line) {
+  line.clear();
+  if (format == LogFormat::JSON) {
+    std::string msg;
+    decode_message(rec, msg);
+    char ts[32];
+    std::snprintf(ts, sizeof(ts), "%.6f", rec.timestamp_ns / 1e9);
+    line += "{\"ts\":";
+    line += ts;
+    line += ",\"level\":\"";
+    line += log_level_name(rec.level);
+    line += "\",\"component\":\"";
+    append_json_escaped(line, rec.tag);
+    line += "\",\"msg\":\"";
+    append_json_escaped(line, msg);
+    line += "\"}\n";
+    return;
+  }
+
+  line += '[';
+  line += rec.tag;
+  line += "] ";
+  if (rec.level == LogLevel::WARN)
+    line += "WARNING: ";
+  else if (rec.level == LogLevel::ERR)
+    line += "ERROR: ";
+  decode_message(rec, line);
+  line += '\n';
+}
+
+void write_record(const detail::LogRecord &rec, std::string &line) {
+  auto format = static_cast<LogFormat>(g_log_format.load());
+  format_record(rec, format, line);
+  FILE *out =
+      format == LogFormat::TEXT && rec.level >= LogLevel::WARN ? stderr
+                                                               : stdout;
+  std::fwrite(line.data(), 1, line.size(), out);
+}
+
+// ============================================================================
+// DRAIN THREAD
+// ============================================================================
+
+class Logger {
+public:
+  static Logger &instance() {
+    static Logger logger;
+    return logger;
+  }
+
+  std::shared_ptr<LogRing> register_thread() {
+    auto ring = std::make_shared<LogRing>();
+    {
+      std::lock_guard<std::mutex> lock(m_rings_mutex);
+      m_rings.push_back(ring);
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_thread.joinable() && !m_stopping)
+      m_thread = std::thread(&Logger::run, this);
+    return ring;
+  }
+
+  void flush() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_thread.joinable())
+      return;
+    uint64_t target = m_requested = m_completed + 2; // One full pass after now
+    m_wake.notify_one();
+    m_done.wait(lock, [&] { return m_completed >= target || m_stopping; });
+  }
+
+  ~Logger() {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stopping = true;
+    }
+    m_wake.notify_one();
+    if (m_thread.joinable())
+      m_thread.join();
+    g_log_closed.store(true);
+    drain(); // Anything logged while the thread was exiting
+
+  }
+
+private:
+  Logger() = default;
+
+  void run() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stopping) {
+      m_wake.wait_for(lock, std::chrono::milliseconds(10),
+                      [&] { return m_stopping || m_requested > m_completed; });
+      lock.unlock();
+      drain();
+      lock.lock();
+      m_completed++;
+      m_done.notify_all();
+    }
+  }
+
+  /**
+   * Move every committed record out of every ring, order them by time and
+   * write them. Only this function (and the destructor) consumes rings.
+   */
+  void drain() {
+    std::vector<std::shared_ptr<LogRing>> rings;
+    {
+      std::lock_guard<std::mutex> lock(m_rings_mutex);
+      rings = m_rings;
+    }
+
+    m_batch.clear();
+    uint64_t dropped = 0;
+    for (const auto &ring : rings) {
+      uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+      uint64_t head = ring->head.load(std::memory_order_acquire);
+      for (; tail != head; tail++)
+        m_batch.push_back(&ring->slots[tail & (RING_SLOTS - 1)]);
+      m_batch_tails.emplace_back(ring.get(), head);
+      dropped += ring->dropped.exchange(0, std::memory_order_relaxed);
+    }
+
+    std::stable_sort(m_batch.begin(), m_batch.end(),
+                     [](const detail::LogRecord *a,
+                        const detail::LogRecord *b) {
+                       return a->timestamp_ns < b->timestamp_ns;
+                     });
+    for (const auto *rec : m_batch)
+      write_record(*rec, m_line);
+
+    if (dropped) {
+      detail::LogRecord note{};
+      note.timestamp_ns = detail::log_timestamp_ns();
+      note.tag = "KYTIN";
+      note.level = LogLevel::WARN;
+      detail::LogEncoder enc(note);
+      enc.put(dropped);
+      enc.put(" log records dropped (ring full)");
+      write_record(note, m_line);
+    }
+
+    // Release the slots only after they have been formatted
+    for (auto [ring, head] : m_batch_tails)
+      ring->tail.store(head, std::memory_order_release);
+    m_batch_tails.clear();
+
+    if (!m_batch.empty() || dropped) {
+      std::fflush(stdout);
+      std::fflush(stderr);
+    }
+
+    // Forget rings whose thread exited and that are fully drained
+    std::lock_guard<std::mutex> lock(m_rings_mutex);
+    m_rings.erase(std::remove_if(m_rings.begin(), m_rings.end(),
+                                 [](const std::shared_ptr<LogRing> &r) {
+                                   return r->orphaned.load() &&
+                                          r->tail.load() == r->head.load();
+                                 }),
+                  m_rings.end());
+  }
+
+  // Thread control
+  std::mutex m_mutex;
+  std::condition_variable m_wake;
+  std::condition_variable m_done;
+  std::thread m_thread;
+  bool m_stopping = false;
+  uint64_t m_requested = 0;
+  uint64_t m_completed = 0;
+
+  // Registered rings (producers lock this only once, at registration)
+  std::mutex m_rings_mutex;
+  std::vector<std::shared_ptr<LogRing>> m_rings;
+
+  // Drain scratch space
+  std::vector<const detail::LogRecord *> m_batch;
+  std::vector<std::pair<LogRing *, uint64_t>> m_batch_tails;
+  std::string m_line;
+};
+
+} // namespace
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+const char *log_level_name(LogLevel level) {
+  switch (level) {
+  case LogLevel::DBG:
+    return "debug";
+  case LogLevel::INFO:
+    return "info";
+  case LogLevel::WARN:
+    return "warn";
+  case LogLevel::ERR:
+    return "error";
+  case LogLevel::OFF:
+    return "off";
+  }
+  return "unknown";
+}
+
+bool parse_log_level(const std::string &name, LogLevel &level) {
+  for (auto candidate : {LogLevel::DBG, LogLevel::INFO, LogLevel::WARN,
+                         LogLevel::ERR, LogLevel::OFF}) {
+    if (name == log_level_name(candidate)) {
+      level = candidate;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool parse_log_format(const std::string &name, LogFormat &format) {
+  if (name == "text") {
+    format = LogFormat::TEXT;
+  } else if (name == "json") {
+    format = LogFormat::JSON;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+void set_log_level(LogLevel level) {
+  detail::g_log_level.store(static_cast<uint8_t>(level),
+                            std::memory_order_relaxed);
+}
+
+LogLevel log_level() {
+  return static_cast<LogLevel>(detail::g_log_level.load());
+}
+
+void set_log_format(LogFormat format) {
+  g_log_format.store(static_cast<uint8_t>(format));
+}
+
+void log_flush() {
+  if (!g_log_closed.load())
+    Logger::instance().flush();
+}
+
+namespace detail {
+
+uint64_t log_timestamp_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+LogRecord *log_claim() {
+  if (g_log_closed.load(std::memory_order_acquire)) {
+    t_sync = true;
+    return &t_sync_record;
+  }
+
+  ThreadLog &tl = t_log;
+  if (!tl.ring)
+    tl.ring = Logger::instance().register_thread();
+
+  LogRing &ring = *tl.ring;
+  uint64_t head = ring.head.load(std::memory_order_relaxed);
+  if (head - ring.tail.load(std::memory_order_acquire) == RING_SLOTS) {
+    ring.dropped.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+  }
+  return &ring.slots[head & (RING_SLOTS - 1)];
+}
+
+void log_commit() {
+  if (t_sync) {
+    t_sync = false;
+    std::string line;
+    write_record(t_sync_record, line);
+    return;
+  }
+  t_log.ring->head.fetch_add(1, std::memory_order_release);
+}
+
+} // namespace detail
+
+} // namespace kytin
@@ -0,0 +1,653 @@
+/*
+ * Kytin Protocol - HTTP Signing Pipeline
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ *
+ * POST /heartbeat, /sign and /migrate: one compile-time pipeline over the
+ * core, with the wire formats and canned replies it shares with the rest of
+ * the front end (main.cpp).
+ */
+
+#include "kytin_pipeline.hpp"
+#include "kytin_log.hpp"
+#include "kytin_trace.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using json = nlohmann::json;
+
+namespace kytin {
+
+// JSON whose nodes and text live in the request arena (signing pipeline)
+using arena_json =
+    nlohmann::basic_json<std::map, std::vector, ArenaString, bool, int64_t,
+                         uint64_t, double, ArenaAllocator>;
+
+// Initial Resin balance: 22,000 credits (10 years of ECO heartbeats)
+SentinelCore g_core(22000);
+
+// ============================================================================
+// CANNED REPLIES
+// ============================================================================
+
+/*
+ * Under abuse, or once the Sentinel is dead, most responses are rejections.
+ * Those whose body never changes are serialized once and copied from here
+ * instead of being rebuilt with json{...}.dump() per request.
+ */
+
+static std::string error_body(const char *error, const char *message) {
+  return json{{"error", error}, {"message", message}}.dump();
+}
+
+static void reply_canned(httplib::Response &res, int status,
+                         const std::string &body) {
+  res.status = status;
+  res.set_content(body, "application/json");
+}
+
+/**
+ * The 410 bodies for a dead Sentinel. Soul Transfer is irreversible, so
+ * they are built by the first request that finds it dead and never change.
+ */
+struct DeathReplies {
+  std::string agent_dead;   // /heartbeat, /sign
+  std::string already_dead; // /migrate
+};
+
+static const DeathReplies *death_replies() {
+  if (!g_core.is_dead())
+    return nullptr;
+
+  static std::once_flag once;
+  static DeathReplies replies;
+  std::call_once(once, [] {
+    const auto death = g_core.death_certificate();
+    replies.agent_dead =
+        json{{"error", "AGENT_DEAD"},
+             {"message",
+              "This Sentinel has executed Soul Transfer. Authority migrated."},
+             {"child_key", death->child_key},
+             {"last_will_signature", death->last_will_signature}}
+            .dump();
+    replies.already_dead =
+        json{{"error", "ALREADY_DEAD"},
+             {"message", "Soul Transfer already executed."},
+             {"child_key", death->child_key},
+             {"last_will_signature", death->last_will_signature}}
+            .dump();
+  });
+  return &replies;
+}
+
+/**
+ * Check if this Sentinel is dead and return 410 GONE if so
+ */
+bool check_if_dead(httplib::Response &res) {
+  const DeathReplies *dead = death_replies();
+  if (!dead)
+    return false;
+  reply_canned(res, 410, dead->agent_dead); // Gone
+  return true;
+}
+
+/**
+ * Render the failure statuses shared by every signing endpoint.
+ * @return true if a response was written
+ */
+bool reply_core_failure(SentinelCore::Status status,
+                        httplib::Response &res) {
+  static const std::string tpm_unavailable = error_body(
+      "TPM_UNAVAILABLE", "Hardware root of trust not initialized.");
+  static const std::string not_ready =
+      error_body("NOT_READY", "Sentinel is still initializing.");
+  static const std::string signing_failed =
+      error_body("SIGNING_FAILED", "TPM signing operation failed.");
+
+  switch (status) {
+  case SentinelCore::Status::DEAD:
+    return check_if_dead(res);
+  case SentinelCore::Status::TPM_UNAVAILABLE:
+    reply_canned(res, 403, tpm_unavailable);
+    return true;
+  case SentinelCore::Status::NOT_READY:
+    res.set_header("Retry-After", "1");
+    reply_canned(res, 503, not_ready);
+    return true;
+  case SentinelCore::Status::SIGNING_FAILED:
+    reply_canned(res, 500, signing_failed);
+    return true;
+  default:
+    return false;
+  }
+}
+
+/**
+ * 402 for an empty tank; the body names the policy's registry, so it is
+ * rebuilt only when the policy changes (per worker thread, without a lock)
+ */
+static void reply_resin_depleted(httplib::Response &res) {
+  thread_local uint64_t generation = 0;
+  thread_local std::string body;
+
+  const auto policy = g_core.policy();
+  if (body.empty() || generation != policy->generation) {
+    body = json{{"error", "RESIN_DEPLETED"},
+                {"message", "Resin tank empty. Burn $KYT to refill."},
+                {"clawhub", policy->config.clawhub_registry + "/refill"}}
+               .dump();
+    generation = policy->generation;
+  }
+  reply_canned(res, 402, body); // Payment Required
+}
+
+/**
+ * 402 for a heartbeat over the policy's resin.daily_limit: the tank has
+ * Resin, but the day's allowance is spent
+ */
+static void reply_resin_daily_limit(httplib::Response &res) {
+  const auto policy = g_core.policy();
+  res.status = 402;
+  res.set_content(json{{"error", "RESIN_DEPLETED"},
+                       {"message", "Daily Resin limit reached."},
+                       {"daily_limit", policy->resin_daily_limit}}
+                      .dump(),
+                  "application/json");
+}
+
+void reply_invalid_json(httplib::Response &res, const json::exception &e) {
+  // Only the parser's message varies
+  static const std::string prefix =
+      R"({"error":"INVALID_JSON","message":)";
+  std::string body = prefix;
+  body += json(e.what()).dump();
+  body += '}';
+  res.status = 400;
+  res.set_content(std::move(body), "application/json");
+}
+
+// ============================================================================
+// WIRE FORMATS
+// ============================================================================
+
+/*
+ * /heartbeat, /sign, /migrate and /status speak JSON unless the client asks
+ * for CBOR (RFC 8949) or MessagePack: request bodies are decoded per their
+ * Content-Type, replies encoded per Accept. Both carry the same fields as
+ * the JSON, except that signatures are raw byte strings instead of base64
+ * text. Error replies are always JSON.
+ */
+enum class WireFormat { JSON, CBOR, MSGPACK };
+
+static bool media_type_is(std::string_view media, std::string_view type) {
+  return media.size() == type.size() &&
+         std::equal(media.begin(), media.end(), type.begin(),
+                    [](char a, char b) {
+                      return std::tolower(static_cast<unsigned char>(a)) == b;
+                    });
+}
+
+/**
+ * Format of one media range ("application/cbor; q=0.9"); nullopt if it is
+ * none we speak. Wildcards mean JSON.
+ */
+static std::optional<WireFormat> media_format(std::string_view range) {
+  std::string_view media = range.substr(0, range.find(';'));
+  while (!media.empty() && media.front() == ' ')
+    media.remove_prefix(1);
+  while (!media.empty() && media.back() == ' ')
+    media.remove_suffix(1);
+
+  if (media_type_is(media, "application/cbor"))
+    return WireFormat::CBOR;
+  if (media_type_is(media, "application/msgpack") ||
+      media_type_is(media, "application/x-msgpack") ||
+      media_type_is(media, "application/vnd.msgpack"))
+    return WireFormat::MSGPACK;
+  if (media_type_is(media, "application/json") ||
+      media_type_is(media, "application/*") || media_type_is(media, "*/*"))
+    return WireFormat::JSON;
+  return std::nullopt;
+}
+
+static WireFormat body_format(const httplib::Request &req) {
+  return media_format(req.get_header_value("Content-Type"))
+      .value_or(WireFormat::JSON);
+}
+
+/**
+ * The first range in Accept that we speak (q=0 ranges excluded); JSON if
+ * none is
+ */
+static WireFormat reply_format(const httplib::Request &req) {
+  const std::string accept = req.get_header_value("Accept");
+  std::string_view rest = accept;
+  while (!rest.empty()) {
+    const size_t comma = rest.find(',');
+    const std::string_view range = rest.substr(0, comma);
+    rest = comma == std::string_view::npos ? "" : rest.substr(comma + 1);
+
+    const size_t q = range.find("q=0");
+    if (q != std::string_view::npos &&
+        range.find_first_not_of(".0 ", q + 3) == std::string_view::npos)
+      continue; // "q=0", "q=0.0": not acceptable
+    if (auto format = media_format(range))
+      return *format;
+  }
+  return WireFormat::JSON;
+}
+
+static const char *content_type(WireFormat format) {
+  switch (format) {
+  case WireFormat::CBOR:
+    return "application/cbor";
+  case WireFormat::MSGPACK:
+    return "application/msgpack";
+  default:
+    return "application/json";
+  }
+}
+
+/**
+ * Signatures and other raw bytes: a byte string in the binary formats,
+ * base64 text in JSON
+ */
+static void put_bytes(arena_json &reply, const char *key,
+                      const std::vector<uint8_t> &bytes, WireFormat format) {
+  if (format != WireFormat::JSON) {
+    reply[key] = arena_json::binary(bytes);
+    return;
+  }
+  ArenaString text;
+  base64_encode(bytes, text);
+  reply[key] = std::move(text);
+}
+
+/**
+ * Serialize a reply document into the request arena
+ */
+static ArenaString encode_reply(const arena_json &reply, WireFormat format) {
+  if (format == WireFormat::JSON)
+    return reply.dump();
+  ArenaString out;
+  nlohmann::detail::binary_writer<arena_json, char> writer{
+      nlohmann::detail::output_adapter<char, ArenaString>(out)};
+  if (format == WireFormat::CBOR)
+    writer.write_cbor(reply);
+  else
+    writer.write_msgpack(reply);
+  return out;
+}
+
+/**
+ * Heap-backed replies (/status) in the client's format
+ */
+void set_reply(const httplib::Request &req, httplib::Response &res,
+               const json &reply) {
+  const WireFormat format = reply_format(req);
+  res.set_header("Vary", "Accept");
+  if (format == WireFormat::JSON) {
+    res.set_content(reply.dump(), "application/json");
+    return;
+  }
+  const std::vector<uint8_t> out = format == WireFormat::CBOR
+                                       ? json::to_cbor(reply)
+                                       : json::to_msgpack(reply);
+  res.set_content(reinterpret_cast<const char *>(out.data()), out.size(),
+                  content_type(format));
+}
+
+// ============================================================================
+// SIGNING PIPELINE
+// ============================================================================
+
+/*
+ * /heartbeat, /sign and /migrate run the same stages, composed at compile
+ * time from an endpoint's traits:
+ *
+ *   death check -> parse -> admit -> core call -> reject -> encode
+ *
+ * The core call does accounting and signing under one lock, so those stay
+ * a single stage. Each Endpoint provides:
+ *
+ *   ROUTE, CORE_SPAN               trace names
+ *   BODY_REQUIRED                  false: an empty body is a default request
+ *   Request                        what parse() extracts from the body
+ *   Result                         what call() returns
+ *   reply_dead(res)                410 when the Sentinel is already dead
+ *   parse(document, request)       may throw json::exception (-> 400)
+ *   admit(request, res)            request-level checks; false = replied
+ *   call(request, body)            the core operation
+ *   reject(request, result, res)   endpoint-specific failures; true = replied
+ *   encode(request, result, fmt)   the 200 document
+ *
+ * Requests, parsed JSON and the encoded reply live in the request arena
+ * (see streamed()); the reply is copied out once, into the response.
+ * Replies are filled in key by key: the initializer-list form builds (and
+ * frees, on the heap) a temporary array per key.
+ */
+
+/**
+ * Decode the body per its Content-Type and hand it to Endpoint::parse().
+ * Binary bodies decode onto the heap: nlohmann's binary reader does not
+ * build documents with a custom string type.
+ */
+template <typename Endpoint>
+void parse_body(const RequestBody &body, WireFormat format,
+                typename Endpoint::Request &request) {
+  switch (format) {
+  case WireFormat::CBOR:
+    Endpoint::parse(json::from_cbor(body.data), request);
+    break;
+  case WireFormat::MSGPACK:
+    Endpoint::parse(json::from_msgpack(body.data), request);
+    break;
+  default:
+    Endpoint::parse(arena_json::parse(body.data), request);
+    break;
+  }
+}
+
+template <typename Endpoint>
+void signing_pipeline(const httplib::Request &req, httplib::Response &res,
+                      const RequestBody &body) {
+  KYTIN_TRACE_REQUEST(Endpoint::ROUTE);
+
+  if (Endpoint::reply_dead(res))
+    return;
+
+  typename Endpoint::Request request;
+  try {
+    KYTIN_TRACE_SPAN("parse");
+    if (Endpoint::BODY_REQUIRED || !body.data.empty())
+      parse_body<Endpoint>(body, body_format(req), request);
+  } catch (const json::exception &e) {
+    reply_invalid_json(res, e);
+    return;
+  }
+  if (!Endpoint::admit(request, res))
+    return;
+
+  typename Endpoint::Result result;
+  {
+    KYTIN_TRACE_SPAN(Endpoint::CORE_SPAN);
+    result = Endpoint::call(request, body);
+  }
+  if (Endpoint::reject(request, result, res) ||
+      reply_core_failure(result.status, res))
+    return;
+
+  KYTIN_TRACE_SPAN("serialize");
+  const WireFormat format = reply_format(req);
+  const ArenaString reply =
+      encode_reply(Endpoint::encode(request, result, format), format);
+  res.status = 200;
+  res.set_header("Vary", "Accept");
+  res.set_content(reply.data(), reply.size(), content_type(format));
+}
+
+/**
+ * POST /heartbeat
+ * Input: { "mode": "ECO" | "TURBO" }
+ *
+ * The core "proof of life" endpoint. Each heartbeat:
+ * 1. Checks Resin balance
+ * 2. Signs the payload with TPM key
+ * 3. Deducts Resin based on mode
+ *
+ * Returns 402 Payment Required if tank is empty.
+ * Returns 410 Gone if Soul Transfer has occurred.
+ */
+struct HeartbeatEndpoint {
+  static constexpr const char *ROUTE = "POST /heartbeat";
+  static constexpr const char *CORE_SPAN = "core.heartbeat";
+  static constexpr bool BODY_REQUIRED = false;
+
+  struct Request {
+    HeartbeatMode mode = HeartbeatMode::ECO;
+  };
+  using Result = SentinelCore::HeartbeatResult;
+
+  static bool reply_dead(httplib::Response &res) { return check_if_dead(res); }
+
+  template <typename Document>
+  static void parse(const Document &request_json, Request &request) {
+    using String = typename Document::string_t;
+    if (auto it = request_json.find("mode"); it != request_json.end())
+      request.mode =
+          parse_heartbeat_mode(it->template get_ref<const String &>());
+  }
+
+  static bool admit(const Request &, httplib::Response &) { return true; }
+
+  // Sign the heartbeat payload (the raw body, in place) and deduct Resin
+  static Result call(const Request &request, const RequestBody &body) {
+    return g_core.heartbeat(
+        request.mode,
+        std::span(reinterpret_cast<const uint8_t *>(body.data.data()),
+                  body.data.size()),
+        &body.sha256);
+  }
+
+  static bool reject(const Request &, const Result &result,
+                     httplib::Response &res) {
+    if (result.status != SentinelCore::Status::RESIN_DEPLETED)
+      return false;
+    if (result.daily_limit)
+      reply_resin_daily_limit(res);
+    else
+      reply_resin_depleted(res);
+    return true;
+  }
+
+  static arena_json encode(const Request &request, const Result &result,
+                           WireFormat format) {
+    arena_json reply = arena_json::object();
+    reply["status"] = "signed";
+    reply["hardware_id"] =
+        std::string_view(g_core.farm().hardware_id(result.signature.device));
+    put_bytes(reply, "signature", result.signature.data, format);
+    reply["algorithm"] = std::string_view(result.signature.algorithm);
+    reply["sequence"] = sequence_string(result.sequence);
+    reply["resin_remaining"] = result.resin_remaining;
+    reply["mode"] = heartbeat_mode_name(request.mode);
+    return reply;
+  }
+};
+
+/**
+ * POST /sign
+ * Input: { "tx": "base64_transaction", "amount": 1.5 }
+ *
+ * Policy-checked transaction signing for Solana.
+ * Enforces daily limits and per-transaction caps.
+ * Returns 410 Gone if Soul Transfer has occurred.
+ */
+struct SignEndpoint {
+  static constexpr const char *ROUTE = "POST /sign";
+  static constexpr const char *CORE_SPAN = "core.sign";
+  static constexpr bool BODY_REQUIRED = true;
+
+  struct Request {
+    ArenaBytes tx;
+    double amount_sol = 0.0;
+  };
+  using Result = SentinelCore::SignResult;
+
+  static bool reply_dead(httplib::Response &res) { return check_if_dead(res); }
+
+  // The tx is copied once, straight out of the parsed body. CBOR and
+  // MessagePack clients may send it as a byte string.
+  template <typename Document>
+  static void parse(const Document &request_json, Request &request) {
+    using String = typename Document::string_t;
+    if (auto it = request_json.find("tx"); it != request_json.end()) {
+      if (it->is_binary()) {
+        const auto &tx_data = it->get_binary();
+        request.tx.assign(tx_data.begin(), tx_data.end());
+      } else {
+        const auto &tx_data = it->template get_ref<const String &>();
+        request.tx.assign(tx_data.begin(), tx_data.end());
+      }
+    }
+    request.amount_sol = request_json.value("amount", 0.0);
+  }
+
+  // The amount is checked by the core: CBOR and MessagePack can carry NaN
+  // and infinities, which it refuses as INVALID_ARGUMENT
+  static bool admit(const Request &, httplib::Response &) { return true; }
+
+  // Check daily limit, then sign the transaction (hashed for the audit log
+  // before the state lock is taken)
+  static Result call(const Request &request, const RequestBody &) {
+    const auto tx_digest = Sha256::hash(request.tx.data(), request.tx.size());
+    return g_core.sign(request.tx, request.amount_sol, &tx_digest);
+  }
+
+  static bool reject(const Request &request, const Result &result,
+                     httplib::Response &res) {
+    static const std::string invalid_amount = error_body(
+        "INVALID_AMOUNT", "amount must be a finite number >= 0.");
+    if (result.status == SentinelCore::Status::INVALID_ARGUMENT) {
+      reply_canned(res, 400, invalid_amount);
+      return true;
+    }
+    if (result.status != SentinelCore::Status::POLICY_VIOLATION)
+      return false;
+    res.status = 403;
+    res.set_content(
+        json{{"error", "POLICY_VIOLATION"},
+             {"message", "Transaction would exceed daily spending limit."},
+             {"daily_limit_sol", result.daily_limit_sol},
+             {"daily_spent_sol", result.daily_spent_sol},
+             {"requested_sol", request.amount_sol}}
+            .dump(),
+        "application/json");
+    return true;
+  }
+
+  static arena_json encode(const Request &request, const Result &result,
+                           WireFormat format) {
+    arena_json reply = arena_json::object();
+    reply["signed"] = true;
+    reply["hardware_id"] =
+        std::string_view(g_core.farm().hardware_id(result.signature.device));
+    put_bytes(reply, "signature", result.signature.data, format);
+    reply["algorithm"] = std::string_view(result.signature.algorithm);
+    reply["sequence"] = sequence_string(result.sequence);
+    reply["amount_sol"] = request.amount_sol;
+    reply["daily_remaining_sol"] =
+        result.daily_limit_sol - result.daily_spent_sol;
+    return reply;
+  }
+};
+
+/**
+ * POST /migrate
+ * Input: { "child_key": "hex_pubkey", "auth_token": "..." }
+ *
+ * SOUL TRANSFER PROTOCOL - Death Certificate Signing
+ * This is IRREVERSIBLE. After execution:
+ * 1. Signs "MIGRATE_AUTHORITY_TO:<child_key>"
+ * 2. Sets is_dead = true
+ * 3. All future /sign and /heartbeat calls return 410 GONE
+ *
+ * Returns the "Last Will" signature for on-chain migration.
+ */
+struct MigrateEndpoint {
+  static constexpr const char *ROUTE = "POST /migrate";
+  static constexpr const char *CORE_SPAN = "core.migrate";
+  static constexpr bool BODY_REQUIRED = true;
+
+  struct Request {
+    std::string child_key;
+    std::string auth_token;
+  };
+  using Result = SentinelCore::MigrateResult;
+
+  static bool reply_dead(httplib::Response &res) {
+    const DeathReplies *dead = death_replies();
+    if (!dead)
+      return false;
+    reply_canned(res, 410, dead->already_dead);
+    return true;
+  }
+
+  template <typename Document>
+  static void parse(const Document &request_json, Request &request) {
+    using String = typename Document::string_t;
+    const String child_key = request_json.value("child_key", "");
+    const String auth_token = request_json.value("auth_token", "");
+    request.child_key.assign(child_key.data(), child_key.size());
+    request.auth_token.assign(auth_token.data(), auth_token.size());
+  }
+
+  static bool admit(const Request &request, httplib::Response &res) {
+    static const std::string missing_child_key = error_body(
+        "MISSING_CHILD_KEY", "child_key is required for Soul Transfer.");
+    if (!request.child_key.empty())
+      return true;
+    reply_canned(res, 400, missing_child_key);
+    return false;
+  }
+
+  // Sign the migration payload - THIS IS THE "LAST WILL"
+  static Result call(const Request &request, const RequestBody &) {
+    return g_core.migrate(request.child_key);
+  }
+
+  static bool reject(const Request &, const Result &result,
+                     httplib::Response &res) {
+    // Lost a race with a concurrent Soul Transfer
+    return result.status == SentinelCore::Status::DEAD && reply_dead(res);
+  }
+
+  // The "Death Certificate"
+  static arena_json encode(const Request &request, const Result &result,
+                           WireFormat format) {
+    KYTIN_LOG_INFO("KYTIN",
+                   "⚰️  SOUL TRANSFER EXECUTED - THIS SENTINEL IS NOW DEAD ⚰️");
+    KYTIN_LOG_INFO("KYTIN", "Authority transferred to: ",
+                   request.child_key.substr(0, 32),
+                   "... All future signing requests will fail with 410 GONE");
+
+    arena_json reply = {
+        {"status", "soul_transferred"},
+        {"parent_pubkey", std::string_view(g_core.tpm().get_hardware_id())},
+        {"child_key", std::string_view(request.child_key)},
+        {"payload", std::string_view(result.payload)},
+        {"algorithm", std::string_view(result.signature.algorithm)},
+        {"message", "This Sentinel is now dead. Broadcast "
+                    "last_will_signature to Solana to complete "
+                    "migration."}};
+    put_bytes(reply, "last_will_signature", result.signature.data, format);
+    return reply;
+  }
+};
+
+void handle_heartbeat(const httplib::Request &req, httplib::Response &res,
+                      const RequestBody &body) {
+  signing_pipeline<HeartbeatEndpoint>(req, res, body);
+}
+
+void handle_sign(const httplib::Request &req, httplib::Response &res,
+                 const RequestBody &body) {
+  signing_pipeline<SignEndpoint>(req, res, body);
+}
+
+void handle_migrate(const httplib::Request &req, httplib::Response &res,
+                    const RequestBody &body) {
+  signing_pipeline<MigrateEndpoint>(req, res, body);
+}
+
+} // namespace kytin
@@ -0,0 +1,94 @@
+/*
+ * Kytin Protocol - HTTP Signing Pipeline
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ *
+ * The signing endpoints of the Sentinel's HTTP front end, and the replies
+ * the rest of it shares with them. Internal to the daemon (not installed):
+ * kytin_sentinel serves these handlers, kytin_alloc_bench drives them
+ * in-process.
+ */
+
+#ifndef KYTIN_PIPELINE_HPP
+#define KYTIN_PIPELINE_HPP
+
+#include "kytin_arena.hpp"
+#include "kytin_core.hpp"
+#include "kytin_sha256.hpp"
+
+#include <httplib.h>
+#include <nlohmann/json.hpp>
+
+namespace kytin {
+
+/**
+ * @brief The daemon's core: Resin, policy, TPM and Soul Transfer state
+ */
+extern SentinelCore g_core;
+
+// ============================================================================
+// REQUEST BODIES
+// ============================================================================
+
+/**
+ * @brief A POST body read through httplib's content reader: size-checked
+ *        and hashed chunk by chunk as it arrived, and buffered exactly once,
+ *        in the request arena
+ */
+struct RequestBody {
+    ArenaString data;
+    Sha256::Digest sha256{};            // Of data
+};
+
+using BodyHandler = void (*)(const httplib::Request&, httplib::Response&,
+                             const RequestBody&);
+
+// ============================================================================
+// SIGNING ENDPOINTS
+// ============================================================================
+
+/**
+ * @brief POST /heartbeat, /sign and /migrate
+ *
+ * Call inside a RequestArena::Scope that outlives body: requests, parsed
+ * documents and the encoded reply are built in the arena.
+ */
+void handle_heartbeat(const httplib::Request& req, httplib::Response& res,
+                      const RequestBody& body);
+void handle_sign(const httplib::Request& req, httplib::Response& res,
+                 const RequestBody& body);
+void handle_migrate(const httplib::Request& req, httplib::Response& res,
+                    const RequestBody& body);
+
+// ============================================================================
+// SHARED REPLIES
+// ============================================================================
+
+/**
+ * @brief 410 GONE if this Sentinel has executed Soul Transfer
+ * @return true if a response was written
+ */
+bool check_if_dead(httplib::Response& res);
+
+/**
+ * @brief The failure statuses shared by every signing endpoint
+ * @return true if a response was written
+ */
+bool reply_core_failure(SentinelCore::Status status, httplib::Response& res);
+
+void reply_invalid_json(httplib::Response& res,
+                        const nlohmann::json::exception& e);
+
+/**
+ * @brief A heap-backed reply (/status) in the format the client's Accept
+ *        header asks for: JSON, CBOR or MessagePack
+ */
+void set_reply(const httplib::Request& req, httplib::Response& res,
+               const nlohmann::json& reply);
+
+} // namespace kytin
+
+#endif // KYTIN_PIPELINE_HPP
@@ -0,0 +1,503 @@
+/*
+ * Kytin Protocol - Hot-Reloadable Policy Snapshots
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ *
+ * Config file format (all keys optional):
+ *   {
+ *     "listen_host": "127.0.0.1",
+ *     "listen_port": 18789,
+ *     "solana_rpc": "https://api.devnet.solana.com",
+ *     "clawhub_registry": "https://clawhub.kytin.io",
+ *     "resin":  { "daily_limit": 1000 },
+ *     "policy": { "daily_limit_sol": 10.0 },
+ *     "mock_tpm": {
+ *       "latency": "none" | "fixed" | "normal" | "trace",
+ *       "fixed_ms": 40, "mean_ms": 45, "stddev_ms": 15,
+ *       "trace_file": "sign-latency.txt",
+ *       "error_rate": 0.001, "serialize": true
+ *     },
+ *     "tpm": {
+ *       "devices": [ "device:/dev/tpmrm0", "swtpm:host=127.0.0.1,port=2321" ],
+ *       "health_interval_ms": 2000, "down_after": 3
+ *     },
+ *     "audit": {
+ *       "dir": "/var/lib/kytin/audit",
+ *       "segment_records": 65536, "hot_segments": 2
+ *     },
+ *     "log": { "level": "debug" | "info" | "warn" | "error" | "off",
+ *              "format": "text" | "json" },
+ *     "heartbeat": {
+ *       "agents": [ { "id": "agent-1", "mode": "ECO" | "TURBO" } ],
+ *       "sink": "file:heartbeats.jsonl" | "unix:/run/kytin/heartbeat.sock",
+ *       "eco_interval_s": 14400, "turbo_interval_s": 60, "jitter": 0.05
+ *     },
+ *     "burn_sync": {
+ *       "address": "<token account or wallet>", "mint": "<RESIN mint>",
+ *       "units_per_resin": 1000000000, "poll_interval_s": 30,
+ *       "batch_size": 50, "commitment": "finalized",
+ *       "cache_file": "/var/lib/kytin/burn-sync.json"
+ *     },
+ *     "rate_limit": {
+ *       "enabled": true, "rate": 5, "burst": 20,
+ *       "key_header": "X-Kytin-Client", "trusted_proxies": [ "127.0.0.1" ],
+ *       "capacity": 65536,
+ *       "clients": { "trusted-skill": { "rate": 50, "burst": 100 } }
+ *     },
+ *     "trace": { "sample_rate": 0.01, "buffer_spans": 4096 },
+ *     "attest": { "batch_window_ms": 20, "max_batch": 1024, "freshness_s": 30 },
+ *     "skills": {
+ *       "trusted_keys": [ "ClawhubSigner:ed25519:<base64 key>" ],
+ *       "cache_entries": 4096
+ *     },
+ *     "shutdown": { "drain_timeout_s": 30, "upgrade_timeout_s": 120 },
+ *     "body_limits": {
+ *       "heartbeat": 4096, "sign": 4096, "migrate": 4096, "attest": 1024,
+ *       "verify_skill": 16777216, "evaluate": 1048576, "other": 65536,
+ *       "timeout_ms": 10000
+ *     },
+ *     "sequence": { "nv_index": "0x01500020" },
+ *     "status_page": { "name": "/kytin-status" }
+ *   }
+ */
+
+#include "kytin_policy.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <fstream>
+
+using json = nlohmann::json;
+
+namespace kytin {
+
+// ============================================================================
+// CONFIG FILE PARSING
+// ============================================================================
+
+static bool parse_schedule(const json &section, ScheduleOptions &options,
+                           std::string &error) {
+  options.sink = section.value("sink", options.sink);
+  options.eco_interval_s =
+      section.value("eco_interval_s", options.eco_interval_s);
+  options.turbo_interval_s =
+      section.value("turbo_interval_s", options.turbo_interval_s);
+  options.jitter = section.value("jitter", options.jitter);
+
+  if (section.contains("agents")) {
+    for (const auto &entry : section["agents"]) {
+      ScheduledAgent agent;
+      agent.id = entry.value("id", "");
+      std::string mode = entry.value("mode", "ECO");
+      if (agent.id.empty()) {
+        error = "heartbeat.agents: every agent needs an id";
+        return false;
+      }
+      if (mode != "ECO" && mode != "TURBO") {
+        error = "heartbeat.agents: unknown mode '" + mode + "' for " +
+                agent.id;
+        return false;
+      }
+      for (const auto &other : options.agents) {
+        if (other.id == agent.id) {
+          error = "heartbeat.agents: duplicate id " + agent.id;
+          return false;
+        }
+      }
+      agent.turbo = mode == "TURBO";
+      options.agents.push_back(std::move(agent));
+    }
+  }
+
+  if (options.jitter < 0.0 || options.jitter > 0.5) {
+    error = "heartbeat.jitter must be within [0, 0.5]";
+    return false;
+  }
+  if (!options.sink.empty() && options.sink.rfind("file:", 0) != 0 &&
+      options.sink.rfind("unix:", 0) != 0) {
+    error = "heartbeat.sink must start with file: or unix:";
+    return false;
+  }
+  return true;
+}
+
+static bool parse_rate_limit(const json &section, RateLimitOptions &options,
+                             std::string &error) {
+  auto parse_limit = [&](const json &entry, RateLimitOptions::Limit &limit,
+                         const std::string &where) {
+    limit.rate = entry.value("rate", limit.rate);
+    limit.burst = entry.value("burst", limit.burst);
+    if (limit.rate != 0.0 &&
+        !(limit.rate >= RateLimitOptions::Limit::MIN_RATE)) {
+      error = where + ": rate must be 0 (unlimited) or at least one per day";
+      return false;
+    }
+    if (!(limit.burst >= 1.0)) {
+      error = where + ": burst must be >= 1";
+      return false;
+    }
+    return true;
+  };
+
+  options.enabled = section.value("enabled", true);
+  options.key_header = section.value("key_header", options.key_header);
+  options.trusted_proxies =
+      section.value("trusted_proxies", options.trusted_proxies);
+  options.capacity = section.value("capacity", options.capacity);
+  if (!parse_limit(section, options.limit, "rate_limit"))
+    return false;
+
+  if (section.contains("clients")) {
+    for (const auto &[client, entry] : section["clients"].items()) {
+      RateLimitOptions::Limit limit = options.limit;
+      if (!parse_limit(entry, limit, "rate_limit.clients." + client))
+        return false;
+      options.clients.emplace(client, limit);
+    }
+  }
+  return true;
+}
+
+static bool parse_mock_profile(const json &section,
+                               TPMInterface::MockProfile &profile,
+                               std::string &error) {
+  using Latency = TPMInterface::MockProfile::Latency;
+
+  std::string latency = section.value("latency", "none");
+  if (latency == "none") {
+    profile.latency = Latency::NONE;
+  } else if (latency == "fixed") {
+    profile.latency = Latency::FIXED;
+  } else if (latency == "normal") {
+    profile.latency = Latency::NORMAL;
+  } else if (latency == "trace") {
+    profile.latency = Latency::TRACE;
+  } else {
+    error = "mock_tpm.latency: unknown distribution '" + latency + "'";
+    return false;
+  }
+
+  profile.fixed_ms = section.value("fixed_ms", profile.fixed_ms);
+  profile.mean_ms = section.value("mean_ms", profile.mean_ms);
+  profile.stddev_ms = section.value("stddev_ms", profile.stddev_ms);
+  profile.error_rate = section.value("error_rate", profile.error_rate);
+  profile.serialize = section.value("serialize", profile.serialize);
+
+  if (profile.latency == Latency::TRACE) {
+    std::string trace_file = section.value("trace_file", "");
+    if (!load_latency_trace(trace_file, profile.trace_ms)) {
+      error = "mock_tpm.trace_file: no samples in '" + trace_file + "'";
+      return false;
+    }
+  }
+
+  if (profile.error_rate < 0.0 || profile.error_rate > 1.0) {
+    error = "mock_tpm.error_rate must be within [0, 1]";
+    return false;
+  }
+  return true;
+}
+
+static bool parse_tpm_farm(const json &section, TPMFarmOptions &options,
+                           std::string &error) {
+  options.devices = section.value("devices", options.devices);
+  options.health_interval_ms =
+      section.value("health_interval_ms", options.health_interval_ms);
+  options.down_after = section.value("down_after", options.down_after);
+
+  if (options.devices.size() > TPM_FARM_MAX_DEVICES) {
+    error = "tpm.devices: at most " + std::to_string(TPM_FARM_MAX_DEVICES) +
+            " devices";
+    return false;
+  }
+  for (size_t i = 0; i < options.devices.size(); i++) {
+    if (options.devices[i].empty()) {
+      error = "tpm.devices: empty TCTI at index " + std::to_string(i);
+      return false;
+    }
+    for (size_t j = 0; j < i; j++) {
+      if (options.devices[j] == options.devices[i]) {
+        error = "tpm.devices: duplicate " + options.devices[i];
+        return false;
+      }
+    }
+  }
+  if (options.health_interval_ms == 0 || options.down_after == 0) {
+    error = "tpm.health_interval_ms and tpm.down_after must be > 0";
+    return false;
+  }
+  return true;
+}
+
+std::optional<PolicySnapshot> load_policy_file(const std::string &path,
+                                               std::string *error) {
+  std::ifstream in(path);
+  if (!in) {
+    if (error)
+      *error = "cannot open " + path;
+    return std::nullopt;
+  }
+
+  PolicySnapshot snap;
+  snap.source = path;
+
+  try {
+    json doc = json::parse(in);
+    auto &cfg = snap.config;
+
+    cfg.listen_host = doc.value("listen_host", cfg.listen_host);
+    cfg.listen_port = doc.value("listen_port", cfg.listen_port);
+    cfg.solana_rpc = doc.value("solana_rpc", cfg.solana_rpc);
+    cfg.clawhub_registry = doc.value("clawhub_registry", cfg.clawhub_registry);
+
+    if (doc.contains("resin")) {
+      snap.resin_daily_limit =
+          doc["resin"].value("daily_limit", snap.resin_daily_limit);
+    }
+    if (doc.contains("policy")) {
+      snap.daily_limit_sol =
+          doc["policy"].value("daily_limit_sol", snap.daily_limit_sol);
+    }
+    if (doc.contains("mock_tpm")) {
+      std::string reason;
+      if (!parse_mock_profile(doc["mock_tpm"], snap.mock_tpm, reason)) {
+        if (error)
+          *error = path + ": " + reason;
+        return std::nullopt;
+      }
+    }
+    if (doc.contains("tpm")) {
+      std::string reason;
+      if (!parse_tpm_farm(doc["tpm"], snap.tpm, reason)) {
+        if (error)
+          *error = path + ": " + reason;
+        return std::nullopt;
+      }
+    }
+    if (doc.contains("audit")) {
+      const auto &audit = doc["audit"];
+      snap.audit.dir = audit.value("dir", snap.audit.dir);
+      snap.audit.segment_records =
+          audit.value("segment_records", snap.audit.segment_records);
+      snap.audit.hot_segments =
+          audit.value("hot_segments", snap.audit.hot_segments);
+    }
+    if (doc.contains("heartbeat")) {
+      std::string reason;
+      if (!parse_schedule(doc["heartbeat"], snap.heartbeat, reason)) {
+        if (error)
+          *error = path + ": " + reason;
+        return std::nullopt;
+      }
+    }
+    if (doc.contains("burn_sync")) {
+      const auto &sync = doc["burn_sync"];
+      auto &opts = snap.burn_sync;
+      opts.address = sync.value("address", opts.address);
+      opts.mint = sync.value("mint", opts.mint);
+      opts.units_per_resin =
+          sync.value("units_per_resin", opts.units_per_resin);
+      opts.poll_interval_s =
+          sync.value("poll_interval_s", opts.poll_interval_s);
+      opts.batch_size = sync.value("batch_size", opts.batch_size);
+      opts.commitment = sync.value("commitment", opts.commitment);
+      opts.cache_file = sync.value("cache_file", opts.cache_file);
+      if (!opts.address.empty() && opts.mint.empty()) {
+        if (error)
+          *error = path + ": burn_sync.mint is required with an address";
+        return std::nullopt;
+      }
+      if (opts.units_per_resin == 0) {
+        if (error)
+          *error = path + ": burn_sync.units_per_resin must be > 0";
+        return std::nullopt;
+      }
+    }
+    if (doc.contains("rate_limit")) {
+      std::string reason;
+      if (!parse_rate_limit(doc["rate_limit"], snap.rate_limit, reason)) {
+        if (error)
+          *error = path + ": " + reason;
+        return std::nullopt;
+      }
+    }
+    if (doc.contains("trace")) {
+      const auto &trace = doc["trace"];
+      snap.trace.sample_rate =
+          trace.value("sample_rate", snap.trace.sample_rate);
+      snap.trace.buffer_spans =
+          trace.value("buffer_spans", snap.trace.buffer_spans);
+      if (snap.trace.sample_rate < 0.0 || snap.trace.sample_rate > 1.0) {
+        if (error)
+          *error = path + ": trace.sample_rate must be within [0, 1]";
+        return std::nullopt;
+      }
+    }
+    if (doc.contains("attest")) {
+      const auto &attest = doc["attest"];
+      auto &opts = snap.attest;
+      opts.batch_window_ms =
+          attest.value("batch_window_ms", opts.batch_window_ms);
+      opts.max_batch = attest.value("max_batch", opts.max_batch);
+      opts.freshness_s = attest.value("freshness_s", opts.freshness_s);
+      if (opts.batch_window_ms > 1000 || opts.max_batch == 0) {
+        if (error)
+          *error = path + ": attest.batch_window_ms must be <= 1000 and "
+                          "max_batch > 0";
+        return std::nullopt;
+      }
+    }
+    if (doc.contains("skills")) {
+      const auto &skills = doc["skills"];
+      snap.skills.trusted_keys =
+          skills.value("trusted_keys", snap.skills.trusted_keys);
+      snap.skills.cache_entries =
+          skills.value("cache_entries", snap.skills.cache_entries);
+    }
+    if (doc.contains("shutdown")) {
+      const auto &shutdown = doc["shutdown"];
+      snap.shutdown.drain_timeout_s =
+          shutdown.value("drain_timeout_s", snap.shutdown.drain_timeout_s);
+      snap.shutdown.upgrade_timeout_s =
+          shutdown.value("upgrade_timeout_s", snap.shutdown.upgrade_timeout_s);
+    }
+    if (doc.contains("body_limits")) {
+      const auto &limits = doc["body_limits"];
+      auto &opts = snap.body_limits;
+      opts.heartbeat = limits.value("heartbeat", opts.heartbeat);
+      opts.sign = limits.value("sign", opts.sign);
+      opts.migrate = limits.value("migrate", opts.migrate);
+      opts.attest = limits.value("attest", opts.attest);
+      opts.verify_skill = limits.value("verify_skill", opts.verify_skill);
+      opts.evaluate = limits.value("evaluate", opts.evaluate);
+      opts.other = limits.value("other", opts.other);
+      opts.timeout_ms = limits.value("timeout_ms", opts.timeout_ms);
+    }
+    if (doc.contains("sequence")) {
+      const auto &index = doc["sequence"].value("nv_index", json());
+      uint64_t nv_index = snap.sequence.nv_index;
+      if (index.is_string()) {
+        // Hex is the usual notation for NV indices
+        const std::string text = index.get<std::string>();
+        size_t used = 0;
+        try {
+          nv_index = std::stoull(text, &used, 0);
+        } catch (const std::exception &) {
+          used = 0;
+        }
+        if (used == 0 || used != text.size())
+          nv_index = 0;
+      } else if (!index.is_null()) {
+        nv_index = index.get<uint64_t>();
+      }
+      if (nv_index < 0x01000000 || nv_index > 0x01FFFFFF) {
+        if (error)
+          *error = path + ": sequence.nv_index must be an owner NV index "
+                          "(0x01000000 - 0x01FFFFFF)";
+        return std::nullopt;
+      }
+      snap.sequence.nv_index = static_cast<uint32_t>(nv_index);
+    }
+    if (doc.contains("status_page")) {
+      const auto &page = doc["status_page"];
+      snap.status_page.name = page.value("name", snap.status_page.name);
+      if (!snap.status_page.name.empty() &&
+          (snap.status_page.name[0] != '/' ||
+           snap.status_page.name.find('/', 1) != std::string::npos)) {
+        if (error)
+          *error = path + ": status_page.name must look like \"/name\"";
+        return std::nullopt;
+      }
+    }
+    if (doc.contains("log")) {
+      const auto &log = doc["log"];
+      std::string level = log.value("level", "info");
+      std::string format = log.value("format", "text");
+      if (!parse_log_level(level, snap.log_level)) {
+        if (error)
+          *error = path + ": log.level: unknown level '" + level + "'";
+        return std::nullopt;
+      }
+      if (!parse_log_format(format, snap.log_format)) {
+        if (error)
+          *error = path + ": log.format: unknown format '" + format + "'";
+        return std::nullopt;
+      }
+    }
+  } catch (const json::exception &e) {
+    if (error)
+      *error = path + ": " + e.what();
+    return std::nullopt;
+  }
+
+  if (snap.daily_limit_sol < 0.0) {
+    if (error)
+      *error = path + ": policy.daily_limit_sol must be >= 0";
+    return std::nullopt;
+  }
+
+  return snap;
+}
+
+// ============================================================================
+// POLICY STORE
+// ============================================================================
+
+PolicyStore::PolicyStore() { install(PolicySnapshot{}); }
+
+PolicyStore::SnapshotPtr PolicyStore::current() const noexcept {
+#if defined(__cpp_lib_atomic_shared_ptr)
+  return m_current.load(std::memory_order_acquire);
+#else
+  return std::atomic_load_explicit(&m_current, std::memory_order_acquire);
+#endif
+}
+
+void PolicyStore::install(PolicySnapshot snapshot) {
+  std::lock_guard<std::mutex> lock(m_writer_mutex);
+
+  snapshot.generation = ++m_generation;
+  auto next = std::make_shared<const PolicySnapshot>(std::move(snapshot));
+
+  // The previous snapshot is released when its last in-flight reader drops
+  // it, so a reload never waits on requests that are already running.
+#if defined(__cpp_lib_atomic_shared_ptr)
+  m_current.store(std::move(next), std::memory_order_release);
+#else
+  std::atomic_store_explicit(&m_current, std::move(next),
+                             std::memory_order_release);
+#endif
+}
+
+bool PolicyStore::load(const std::string &path, std::string *error) {
+  auto snap = load_policy_file(path, error);
+  if (!snap)
+    return false;
+
+  {
+    std::lock_guard<std::mutex> lock(m_writer_mutex);
+    m_path = path;
+  }
+  install(std::move(*snap));
+  return true;
+}
+
+bool PolicyStore::reload(std::string *error) {
+  std::string path = this->path();
+  if (path.empty()) {
+    if (error)
+      *error = "no config file loaded";
+    return false;
+  }
+  return load(path, error);
+}
+
+std::string PolicyStore::path() const {
+  std::lock_guard<std::mutex> lock(m_writer_mutex);
+  return m_path;
+}
+
+} // namespace kytin
@@ -0,0 +1,152 @@
+/*
+ * Kytin Protocol - Per-Client Rate Limiting
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ */
+
+#include "kytin_ratelimit.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+
+namespace kytin {
+
+namespace {
+
+/**
+ * 64-bit FNV-1a followed by a murmur finalizer so both the shard bits (top)
+ * and the probe bits (bottom) are well mixed. Never returns 0.
+ */
+uint64_t client_hash(std::string_view client) {
+  uint64_t h = 0xcbf29ce484222325ull;
+  for (unsigned char c : client) {
+    h ^= c;
+    h *= 0x100000001b3ull;
+  }
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdull;
+  h ^= h >> 33;
+  return h ? h : 1;
+}
+
+/**
+ * Nanoseconds as a bucket offset, capped at a year: a tiny rate or a huge
+ * burst would otherwise overflow the conversion (or the TAT after it).
+ * A year is past any Retry-After a client will wait for.
+ */
+uint64_t span_ns(double ns) {
+  constexpr uint64_t MAX_SPAN_NS = 365ull * 86400 * 1000000000;
+  if (!(ns < static_cast<double>(MAX_SPAN_NS)))
+    return MAX_SPAN_NS;
+  return static_cast<uint64_t>(ns);
+}
+
+/**
+ * Monotonic time for bucket arithmetic. The coarse clock (jiffy resolution)
+ * is several times cheaper than steady_clock and plenty for limits counted
+ * per second.
+ */
+uint64_t monotonic_ns() {
+#ifdef CLOCK_MONOTONIC_COARSE
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull +
+         static_cast<uint64_t>(ts.tv_nsec);
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#endif
+}
+
+} // namespace
+
+RateLimiter::RateLimiter(uint32_t capacity) {
+  uint32_t per_shard = std::max<uint32_t>(PROBE_LIMIT, capacity / SHARDS);
+  m_shard_slots = 1;
+  while (m_shard_slots < per_shard)
+    m_shard_slots <<= 1;
+
+  for (auto &shard : m_shards)
+    shard.slots = std::make_unique<Slot[]>(m_shard_slots);
+}
+
+/**
+ * Slot holding `key`, claiming an empty or fully refilled one if needed.
+ * nullptr only if the whole probe window is busy with other active clients.
+ */
+RateLimiter::Slot *RateLimiter::find_slot(uint64_t key, uint64_t now_ns) {
+  Slot *slots = m_shards[key >> 58].slots.get(); // Top 6 bits pick the shard
+  uint32_t mask = m_shard_slots - 1;
+  uint32_t start = static_cast<uint32_t>(key) & mask;
+  Slot *idle = nullptr;
+
+  for (uint32_t i = 0; i < PROBE_LIMIT; i++) {
+    Slot &slot = slots[(start + i) & mask];
+    uint64_t current = slot.key.load(std::memory_order_acquire);
+    if (current == key)
+      return &slot;
+    if (current == 0) {
+      if (slot.key.compare_exchange_strong(current, key,
+                                           std::memory_order_acq_rel))
+        return &slot;
+      if (current == key)
+        return &slot; // Another thread inserted the same client
+      continue;
+    }
+    if (!idle && slot.tat.load(std::memory_order_relaxed) <= now_ns)
+      idle = &slot;
+  }
+
+  // Window full: take over a client whose bucket is full again (it would
+  // start from a full bucket anyway if it came back)
+  if (idle) {
+    uint64_t current = idle->key.load(std::memory_order_relaxed);
+    if (idle->key.compare_exchange_strong(current, key,
+                                          std::memory_order_acq_rel))
+      return idle;
+  }
+  return nullptr;
+}
+
+RateLimiter::Decision
+RateLimiter::acquire(std::string_view client,
+                     const RateLimitOptions::Limit &limit) {
+  return acquire(client, limit, monotonic_ns());
+}
+
+RateLimiter::Decision
+RateLimiter::acquire(std::string_view client,
+                     const RateLimitOptions::Limit &limit, uint64_t now_ns) {
+  Decision decision;
+  if (limit.rate <= 0.0)
+    return decision; // Unlimited
+
+  const uint64_t interval = span_ns(1e9 / limit.rate);
+  const uint64_t tolerance =
+      span_ns(std::max(0.0, limit.burst - 1.0) * 1e9 / limit.rate);
+
+  Slot *slot = find_slot(client_hash(client), now_ns);
+  if (!slot)
+    return decision; // Table saturated: fail open rather than block signing
+
+  uint64_t tat = slot->tat.load(std::memory_order_relaxed);
+  for (;;) {
+    uint64_t base = std::max(tat, now_ns);
+    if (base - now_ns > tolerance) {
+      decision.allowed = false;
+      decision.retry_after_ms = (base - now_ns - tolerance + 999999) / 1000000;
+      m_rejected.fetch_add(1, std::memory_order_relaxed);
+      return decision;
+    }
+    if (slot->tat.compare_exchange_weak(tat, base + interval,
+                                        std::memory_order_relaxed))
+      return decision;
+  }
+}
+
+} // namespace kytin
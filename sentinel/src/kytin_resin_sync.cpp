@@ -0,0 +1,463 @@
+/*
+ * Kytin Protocol - On-Chain Burn Sync
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ */
+
+#include "kytin_resin_sync.hpp"
+#include "kytin_core.hpp"
+#include "kytin_log.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <unordered_map>
+
+using json = nlohmann::json;
+
+namespace kytin {
+
+namespace {
+
+constexpr size_t SIGNATURE_PAGE = 1000; // getSignaturesForAddress maximum
+
+uint64_t unix_seconds() {
+  return std::chrono::duration_cast<std::chrono::seconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+/**
+ * Raw amount of an SPL-Token burn of `mint` that concerns `address`, or 0
+ */
+uint64_t burned_units(const json &ix, const std::string &mint,
+                      const std::string &address) {
+  if (!ix.contains("parsed") || !ix["parsed"].is_object())
+    return 0;
+  const std::string program = ix.value("program", "");
+  if (program != "spl-token" && program != "spl-token-2022")
+    return 0;
+
+  const auto &parsed = ix["parsed"];
+  const std::string type = parsed.value("type", "");
+  if (type != "burn" && type != "burnChecked")
+    return 0;
+
+  const auto &info = parsed.value("info", json::object());
+  if (info.value("mint", "") != mint)
+    return 0;
+  if (address != mint && info.value("account", "") != address &&
+      info.value("authority", "") != address)
+    return 0;
+
+  std::string amount = type == "burn"
+                           ? info.value("amount", "0")
+                           : info.value("tokenAmount", json::object())
+                                 .value("amount", "0");
+  try {
+    return std::stoull(amount);
+  } catch (const std::exception &) {
+    return 0;
+  }
+}
+
+/**
+ * Total burned units in one getTransaction (jsonParsed) result
+ */
+uint64_t transaction_burns(const json &tx, const std::string &mint,
+                           const std::string &address, uint64_t &count) {
+  uint64_t total = 0;
+  auto scan = [&](const json &instructions) {
+    if (!instructions.is_array())
+      return;
+    for (const auto &ix : instructions) {
+      uint64_t units = burned_units(ix, mint, address);
+      if (units) {
+        total += units;
+        count++;
+      }
+    }
+  };
+
+  const auto &message =
+      tx.value("transaction", json::object()).value("message", json::object());
+  scan(message.value("instructions", json::array()));
+
+  const auto &meta = tx.value("meta", json::object());
+  for (const auto &inner : meta.value("innerInstructions", json::array()))
+    scan(inner.value("instructions", json::array()));
+  return total;
+}
+
+json rpc_request(uint64_t id, const char *method, json params) {
+  return json{{"jsonrpc", "2.0"},
+              {"id", id},
+              {"method", method},
+              {"params", std::move(params)}};
+}
+
+} // namespace
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+BurnSync::BurnSync(SentinelCore &core, RpcTransport transport)
+    : m_core(core), m_transport(std::move(transport)) {}
+
+BurnSync::~BurnSync() { stop(); }
+
+void BurnSync::start(bool credit_cached) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_thread.joinable())
+    return;
+  m_stopping = false;
+  m_credit_cached = credit_cached;
+  m_thread = std::thread(&BurnSync::run, this);
+}
+
+void BurnSync::stop() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = true;
+  }
+  m_wake.notify_all();
+  if (m_thread.joinable())
+    m_thread.join();
+}
+
+BurnSync::Stats BurnSync::stats() const {
+  Stats stats;
+  {
+    std::lock_guard<std::mutex> lock(m_cursor_mutex);
+    stats.enabled = !m_cursor.address.empty();
+    stats.last_signature = m_cursor.signature;
+    stats.last_slot = m_cursor.slot;
+    stats.burns = m_cursor.burns;
+    stats.credited_resin = m_cursor.credited_resin;
+  }
+  stats.rpc_requests = m_rpc_requests.load();
+  stats.rpc_errors = m_rpc_errors.load();
+  stats.last_sync_unix = m_last_sync_unix.load();
+  return stats;
+}
+
+void BurnSync::run() {
+  // Failed cycles back off exponentially (up to 5 minutes) and are logged
+  // once per failure streak
+  constexpr uint32_t MAX_BACKOFF_S = 300;
+  uint32_t backoff_s = 0;
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (!m_stopping) {
+    lock.unlock();
+    std::string error;
+    bool ok = sync_once(&error);
+    uint32_t interval_s =
+        std::max<uint32_t>(1, m_core.policy()->burn_sync.poll_interval_s);
+    if (ok) {
+      if (backoff_s)
+        KYTIN_LOG_INFO("KYTIN", "Burn sync recovered");
+      backoff_s = 0;
+    } else {
+      if (!backoff_s)
+        KYTIN_LOG_WARN("KYTIN", "Burn sync failed: ", error);
+      backoff_s = std::min(MAX_BACKOFF_S, backoff_s ? backoff_s * 2
+                                                    : interval_s);
+      interval_s = backoff_s;
+    }
+    lock.lock();
+
+    m_wake.wait_for(lock, std::chrono::seconds(interval_s),
+                    [&] { return m_stopping; });
+  }
+}
+
+// ============================================================================
+// RPC
+// ============================================================================
+
+bool BurnSync::call(const std::string &url, const std::string &body,
+                    std::string &response, std::string &error) {
+  m_rpc_requests.fetch_add(1, std::memory_order_relaxed);
+  if (!m_transport(url, body, response, error)) {
+    m_rpc_errors.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Every signature newer than the cursor, oldest first
+ */
+bool BurnSync::fetch_signatures(const std::string &url,
+                                const BurnSyncOptions &options,
+                                std::vector<PendingSignature> &out,
+                                std::string &error) {
+  std::string until;
+  {
+    std::lock_guard<std::mutex> lock(m_cursor_mutex);
+    until = m_cursor.signature;
+  }
+
+  std::string before;
+  for (;;) {
+    json config{{"limit", SIGNATURE_PAGE}, {"commitment", options.commitment}};
+    if (!until.empty())
+      config["until"] = until;
+    if (!before.empty())
+      config["before"] = before;
+
+    std::string response;
+    json request = rpc_request(
+        1, "getSignaturesForAddress", json::array({options.address, config}));
+    if (!call(url, request.dump(), response, error))
+      return false;
+
+    try {
+      json doc = json::parse(response);
+      if (doc.contains("error")) {
+        error = "getSignaturesForAddress: " + doc["error"].dump();
+        m_rpc_errors.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+      const auto &page = doc.at("result");
+      for (const auto &entry : page) {
+        PendingSignature sig;
+        sig.signature = entry.at("signature").get<std::string>();
+        sig.slot = entry.value("slot", uint64_t{0});
+        sig.failed = entry.contains("err") && !entry["err"].is_null();
+        out.push_back(std::move(sig));
+      }
+      if (page.size() < SIGNATURE_PAGE)
+        break;
+      before = out.back().signature;
+    } catch (const json::exception &e) {
+      error = std::string("getSignaturesForAddress: ") + e.what();
+      m_rpc_errors.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+  }
+
+  std::reverse(out.begin(), out.end());
+  return true;
+}
+
+bool BurnSync::sync_once(std::string *error_out) {
+  const auto policy = m_core.policy();
+  const auto &options = policy->burn_sync;
+  const std::string &url = policy->config.solana_rpc;
+  std::string error;
+
+  {
+    std::lock_guard<std::mutex> lock(m_cursor_mutex);
+    if (options.address.empty()) {
+      m_cursor = Cursor{};
+      return true;
+    }
+  }
+
+  if (!m_cache_applied) {
+    m_cache_applied = true;
+    if (load_cache(options) && m_credit_cached) {
+      m_core.credit_resin(m_cursor.credited_resin);
+      KYTIN_LOG_INFO("KYTIN", "Burn sync: resuming after ", m_cursor.signature,
+                     " (", m_cursor.credited_resin, " Resin credited)");
+    }
+  }
+
+  {
+    // A different account or mint starts a new history; Resin already
+    // credited for the old one stays in the tank
+    std::lock_guard<std::mutex> lock(m_cursor_mutex);
+    if (m_cursor.address != options.address || m_cursor.mint != options.mint) {
+      m_cursor = Cursor{};
+      m_cursor.address = options.address;
+      m_cursor.mint = options.mint;
+    }
+  }
+
+  std::vector<PendingSignature> pending;
+  if (!fetch_signatures(url, options, pending, error)) {
+    if (error_out)
+      *error_out = error;
+    return false;
+  }
+
+  const size_t batch = std::max<uint32_t>(1, options.batch_size);
+  const uint64_t units_per_resin = std::max<uint64_t>(1, options.units_per_resin);
+
+  for (size_t first = 0; first < pending.size(); first += batch) {
+    size_t last = std::min(pending.size(), first + batch);
+
+    // One HTTP request carries the whole batch; ids index into `pending`
+    json requests = json::array();
+    for (size_t i = first; i < last; i++) {
+      if (pending[i].failed)
+        continue; // Nothing was burned; only the cursor moves past it
+      requests.push_back(rpc_request(
+          i, "getTransaction",
+          json::array({pending[i].signature,
+                       {{"encoding", "jsonParsed"},
+                        {"commitment", options.commitment},
+                        {"maxSupportedTransactionVersion", 0}}})));
+    }
+
+    std::unordered_map<uint64_t, json> results;
+    if (!requests.empty()) {
+      std::string response;
+      if (!call(url, requests.dump(), response, error)) {
+        if (error_out)
+          *error_out = error;
+        return false;
+      }
+      try {
+        json doc = json::parse(response);
+        if (!doc.is_array()) {
+          // Batch rejected as a whole (e.g. the endpoint caps batch size)
+          error = "getTransaction batch: " +
+                  doc.value("error", json::object()).dump();
+          m_rpc_errors.fetch_add(1, std::memory_order_relaxed);
+          if (error_out)
+            *error_out = error;
+          return false;
+        }
+        for (auto &reply : doc)
+          results.emplace(reply.value("id", uint64_t{0}), std::move(reply));
+      } catch (const json::exception &e) {
+        error = std::string("getTransaction batch: ") + e.what();
+        m_rpc_errors.fetch_add(1, std::memory_order_relaxed);
+        if (error_out)
+          *error_out = error;
+        return false;
+      }
+    }
+
+    // Advance through the batch in order; stop at the first transaction
+    // the node cannot return yet so the cursor never skips one
+    Cursor next;
+    {
+      std::lock_guard<std::mutex> lock(m_cursor_mutex);
+      next = m_cursor;
+    }
+    uint64_t credit = 0;
+    bool complete = true;
+    for (size_t i = first; i < last; i++) {
+      if (!pending[i].failed) {
+        auto it = results.find(i);
+        if (it == results.end() || !it->second.contains("result") ||
+            it->second["result"].is_null()) {
+          error = "transaction " + pending[i].signature + " not available";
+          complete = false;
+          break;
+        }
+        const auto &tx = it->second["result"];
+        const auto &meta = tx.value("meta", json::object());
+        if (meta.contains("err") && meta["err"].is_null()) {
+          uint64_t units = transaction_burns(tx, options.mint,
+                                             options.address, next.burns);
+          // Split to avoid overflowing remainder + units
+          uint64_t whole = units / units_per_resin;
+          uint64_t rest = next.remainder_units + units % units_per_resin;
+          whole += rest / units_per_resin;
+          next.remainder_units = rest % units_per_resin;
+          credit += whole;
+        }
+      }
+      next.signature = pending[i].signature;
+      next.slot = pending[i].slot;
+    }
+    next.credited_resin += credit;
+
+    // Persist first: a crash after this point re-credits from the cache,
+    // a crash before it re-fetches the batch
+    if (next.signature != m_cursor.signature) {
+      if (!options.cache_file.empty() && !save_cache(next, options.cache_file))
+        KYTIN_LOG_WARN("KYTIN", "Burn sync: cannot write ", options.cache_file);
+      {
+        std::lock_guard<std::mutex> lock(m_cursor_mutex);
+        m_cursor = next;
+      }
+      if (credit) {
+        m_core.credit_resin(credit);
+        KYTIN_LOG_INFO("KYTIN", "Burn sync: +", credit, " Resin (slot ",
+                       next.slot, ")");
+      }
+    }
+
+    if (!complete) {
+      m_rpc_errors.fetch_add(1, std::memory_order_relaxed);
+      if (error_out)
+        *error_out = error;
+      return false;
+    }
+  }
+
+  m_last_sync_unix.store(unix_seconds());
+  return true;
+}
+
+// ============================================================================
+// CACHE FILE
+// ============================================================================
+
+bool BurnSync::load_cache(const BurnSyncOptions &options) {
+  if (options.cache_file.empty())
+    return false;
+  std::ifstream in(options.cache_file);
+  if (!in)
+    return false; // First run
+
+  try {
+    json doc = json::parse(in);
+    Cursor cursor;
+    cursor.address = doc.at("address").get<std::string>();
+    cursor.mint = doc.at("mint").get<std::string>();
+    cursor.signature = doc.at("last_signature").get<std::string>();
+    cursor.slot = doc.value("last_slot", uint64_t{0});
+    cursor.burns = doc.value("burns", uint64_t{0});
+    cursor.credited_resin = doc.value("credited_resin", uint64_t{0});
+    cursor.remainder_units = doc.value("remainder_units", uint64_t{0});
+    if (cursor.address != options.address || cursor.mint != options.mint) {
+      KYTIN_LOG_WARN("KYTIN", "Burn sync: ", options.cache_file,
+                     " belongs to another account or mint; ignoring it");
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(m_cursor_mutex);
+    m_cursor = std::move(cursor);
+    return true;
+  } catch (const json::exception &e) {
+    KYTIN_LOG_WARN("KYTIN", "Burn sync: ignoring ", options.cache_file, ": ",
+                   e.what());
+    return false;
+  }
+}
+
+bool BurnSync::save_cache(const Cursor &cursor, const std::string &path) {
+  // Write-then-rename so a crash never leaves a torn cache behind
+  std::string tmp = path + ".tmp";
+  {
+    std::ofstream out(tmp, std::ios::trunc);
+    out << json{{"address", cursor.address},
+                {"mint", cursor.mint},
+                {"last_signature", cursor.signature},
+                {"last_slot", cursor.slot},
+                {"burns", cursor.burns},
+                {"credited_resin", cursor.credited_resin},
+                {"remainder_units", cursor.remainder_units}}
+               .dump(2)
+        << '\n';
+    out.flush();
+    if (!out)
+      return false;
+  }
+  return std::rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+} // namespace kytin
@@ -0,0 +1,479 @@
+/*
+ * Kytin Protocol - Heartbeat Scheduler
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ */
+
+#include "kytin_scheduler.hpp"
+#include "config.hpp"
+#include "kytin_core.hpp"
+#include "kytin_log.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+using json = nlohmann::json;
+
+namespace kytin {
+
+// ============================================================================
+// TIMING WHEEL
+// ============================================================================
+
+TimerWheel::TimerWheel(uint64_t now) : m_now(now) {
+  for (auto &level : m_slots) {
+    for (auto &head : level)
+      head.prev = head.next = &head;
+  }
+}
+
+void TimerWheel::link(Timer &timer) {
+  // Place by distance from now; anything beyond the wheel's range parks in
+  // the top level and is re-placed each time that slot cascades
+  uint64_t delta = std::min(timer.expires - m_now, MAX_DELTA);
+  uint64_t target = m_now + delta;
+
+  int level = 0;
+  while (level < LEVELS - 1 && delta >= (1ull << ((level + 1) * SLOT_BITS)))
+    level++;
+  Timer &head = m_slots[level][(target >> (level * SLOT_BITS)) & (SLOTS - 1)];
+
+  timer.prev = head.prev;
+  timer.next = &head;
+  head.prev->next = &timer;
+  head.prev = &timer;
+}
+
+void TimerWheel::arm(Timer &timer, uint64_t expires) {
+  cancel(timer);
+  timer.expires = std::max(expires, m_now + 1);
+  link(timer);
+  m_size++;
+}
+
+void TimerWheel::cancel(Timer &timer) {
+  if (!timer.armed())
+    return;
+  timer.prev->next = timer.next;
+  timer.next->prev = timer.prev;
+  timer.prev = timer.next = nullptr;
+  m_size--;
+}
+
+/**
+ * Re-place every timer of the current slot of `level` one level down
+ */
+void TimerWheel::cascade(int level) {
+  Timer &head = m_slots[level][(m_now >> (level * SLOT_BITS)) & (SLOTS - 1)];
+  Timer *timer = head.next;
+  head.prev = head.next = &head;
+
+  while (timer != &head) {
+    Timer *next = timer->next;
+    link(*timer);
+    timer = next;
+  }
+}
+
+void TimerWheel::advance(uint64_t now, std::vector<Timer *> &expired) {
+  while (m_now < now) {
+    m_now++;
+
+    uint64_t index = m_now & (SLOTS - 1);
+    if (index == 0) {
+      for (int level = 1; level < LEVELS; level++) {
+        cascade(level);
+        if ((m_now >> (level * SLOT_BITS)) & (SLOTS - 1))
+          break;
+      }
+    }
+
+    Timer &head = m_slots[0][index];
+    while (head.next != &head) {
+      Timer *timer = head.next;
+      cancel(*timer);
+      expired.push_back(timer);
+    }
+  }
+}
+
+// ============================================================================
+// SCHEDULER
+// ============================================================================
+
+namespace {
+
+/**
+ * FNV-1a: stable per-agent phase, independent of process and platform
+ */
+uint64_t agent_phase_hash(const std::string &id) {
+  uint64_t hash = 0xcbf29ce484222325ull;
+  for (unsigned char c : id) {
+    hash ^= c;
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+
+uint64_t unix_seconds() {
+  return std::chrono::duration_cast<std::chrono::seconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+uint64_t unix_millis() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+} // namespace
+
+HeartbeatScheduler::HeartbeatScheduler(SentinelCore &core)
+    : m_core(core),
+      m_rng(std::chrono::steady_clock::now().time_since_epoch().count() | 1) {}
+
+HeartbeatScheduler::~HeartbeatScheduler() { stop(); }
+
+void HeartbeatScheduler::start() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_thread.joinable())
+    return;
+  m_stopping = false;
+  m_thread = std::thread(&HeartbeatScheduler::run, this);
+}
+
+void HeartbeatScheduler::stop() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = true;
+  }
+  m_wake.notify_all();
+  if (m_thread.joinable())
+    m_thread.join();
+}
+
+std::vector<ParkedBeat> HeartbeatScheduler::parked() const {
+  std::lock_guard<std::mutex> lock(m_parked_mutex);
+  return m_parked;
+}
+
+void HeartbeatScheduler::resume(const std::vector<ParkedBeat> &beats) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_resume.clear();
+  for (const auto &beat : beats)
+    m_resume.emplace(beat.id, beat);
+}
+
+HeartbeatScheduler::Stats HeartbeatScheduler::stats() const {
+  Stats stats;
+  stats.agents = m_agent_count.load();
+  stats.fired = m_fired.load();
+  stats.failed = m_failed.load();
+  stats.sink_errors = m_sink_errors.load();
+  return stats;
+}
+
+uint64_t HeartbeatScheduler::interval_ticks(bool turbo) const {
+  return turbo ? m_turbo_ticks : m_eco_ticks;
+}
+
+/**
+ * One period from `from_tick`, stretched or shrunk by up to m_jitter so
+ * agents that happen to share a phase drift apart
+ */
+uint64_t HeartbeatScheduler::next_deadline(const Agent &agent,
+                                           uint64_t from_tick) {
+  // xorshift64: cheap, and quality is irrelevant here
+  m_rng ^= m_rng << 13;
+  m_rng ^= m_rng >> 7;
+  m_rng ^= m_rng << 17;
+  double u = static_cast<double>(m_rng >> 11) * 0x1.0p-53 * 2.0 - 1.0;
+
+  double period = static_cast<double>(interval_ticks(agent.turbo));
+  period *= 1.0 + m_jitter * u;
+  return from_tick + std::max<uint64_t>(1, static_cast<uint64_t>(period));
+}
+
+/**
+ * Bring agents, intervals and sink in line with a new policy snapshot
+ */
+void HeartbeatScheduler::reconcile(const ScheduleOptions &options,
+                                   uint64_t now_tick) {
+  constexpr uint64_t TICKS_PER_SECOND = 1000 / TICK_MS;
+  uint32_t eco_s = options.eco_interval_s ? options.eco_interval_s
+                                          : HEARTBEAT_INTERVAL_ECO;
+  uint32_t turbo_s = options.turbo_interval_s ? options.turbo_interval_s
+                                              : HEARTBEAT_INTERVAL_TURBO;
+  bool intervals_changed = eco_s * TICKS_PER_SECOND != m_eco_ticks ||
+                           turbo_s * TICKS_PER_SECOND != m_turbo_ticks;
+  m_eco_ticks = static_cast<uint32_t>(eco_s * TICKS_PER_SECOND);
+  m_turbo_ticks = static_cast<uint32_t>(turbo_s * TICKS_PER_SECOND);
+  m_jitter = options.jitter;
+
+  std::unordered_map<std::string, std::unique_ptr<Agent>> next;
+  next.reserve(options.agents.size());
+  for (const auto &wanted : options.agents) {
+    std::unique_ptr<Agent> agent;
+    auto it = m_agents.find(wanted.id);
+    if (it != m_agents.end()) {
+      agent = std::move(it->second);
+      m_agents.erase(it);
+    } else {
+      agent = std::make_unique<Agent>();
+      agent->id = wanted.id;
+    }
+
+    auto parked = m_resume.find(wanted.id);
+    if (parked != m_resume.end() && parked->second.turbo == wanted.turbo) {
+      // Pick up where the previous process left off
+      agent->turbo = wanted.turbo;
+      agent->seq = parked->second.seq;
+      uint64_t now_ms = unix_millis();
+      uint64_t due_ms = parked->second.due_unix_ms;
+      m_wheel.arm(*agent,
+                  now_tick + 1 + (due_ms > now_ms ? (due_ms - now_ms) / TICK_MS
+                                                  : 0));
+    } else if (!agent->armed() || agent->turbo != wanted.turbo ||
+               intervals_changed) {
+      // First beat lands at a fixed, id-derived offset into the interval
+      agent->turbo = wanted.turbo;
+      uint64_t phase =
+          agent_phase_hash(agent->id) % interval_ticks(agent->turbo);
+      m_wheel.arm(*agent, now_tick + 1 + phase);
+    }
+    next.emplace(wanted.id, std::move(agent));
+  }
+
+  // Whatever is left was removed from the config
+  for (auto &[id, agent] : m_agents)
+    m_wheel.cancel(*agent);
+  m_agents = std::move(next);
+  m_resume.clear();
+  m_agent_count.store(m_agents.size());
+
+  if (options.sink != m_sink_spec) {
+    close_sink();
+    m_sink_spec = options.sink;
+    if (!m_sink_spec.empty())
+      open_sink(m_sink_spec);
+  }
+
+  if (!m_agents.empty()) {
+    KYTIN_LOG_INFO("KYTIN", "Heartbeat scheduler: ", m_agents.size(),
+                   " agents (ECO every ", eco_s, "s, TURBO every ", turbo_s,
+                   "s)", m_sink_spec.empty() ? "" : " -> ", m_sink_spec);
+  }
+}
+
+void HeartbeatScheduler::fire(Agent &agent) {
+  HeartbeatMode mode = agent.turbo ? HeartbeatMode::TURBO : HeartbeatMode::ECO;
+  agent.seq++;
+
+  json line{{"agent", agent.id},
+            {"seq", agent.seq},
+            {"mode", heartbeat_mode_name(mode)},
+            {"timestamp", unix_seconds()}};
+  std::string payload = line.dump();
+
+  auto result = m_core.heartbeat(
+      mode, std::span(reinterpret_cast<const uint8_t *>(payload.data()),
+                      payload.size()));
+  if (result.status == SentinelCore::Status::OK) {
+    m_fired.fetch_add(1, std::memory_order_relaxed);
+    line["signature"] = base64_encode(result.signature.data);
+    line["algorithm"] = result.signature.algorithm;
+    line["sequence"] = std::to_string(result.sequence);
+    line["hardware_id"] = m_core.farm().hardware_id(result.signature.device);
+    line["resin_remaining"] = result.resin_remaining;
+  } else {
+    m_failed.fetch_add(1, std::memory_order_relaxed);
+    line["error"] = core_status_name(result.status);
+    KYTIN_LOG_WARN("KYTIN", "Scheduled heartbeat for ", agent.id, " failed: ",
+                   core_status_name(result.status));
+  }
+
+  if (!m_sink_spec.empty() && !write_sink(line.dump() + "\n"))
+    m_sink_errors.fetch_add(1, std::memory_order_relaxed);
+}
+
+void HeartbeatScheduler::run() {
+  using clock = std::chrono::steady_clock;
+  const auto epoch = clock::now();
+  const auto tick = std::chrono::milliseconds(TICK_MS);
+  const uint64_t base = m_wheel.now(); // Wheel time survives stop/start
+  std::vector<TimerWheel::Timer *> due;
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (!m_stopping) {
+    uint64_t elapsed = (clock::now() - epoch) / tick;
+    m_wake.wait_until(lock, epoch + (elapsed + 1) * tick,
+                      [&] { return m_stopping; });
+    if (m_stopping)
+      break;
+    lock.unlock();
+
+    uint64_t now_tick = base + (clock::now() - epoch) / tick;
+    const auto policy = m_core.policy();
+    if (policy->generation != m_generation) {
+      m_generation = policy->generation;
+      reconcile(policy->heartbeat, m_wheel.now());
+    }
+
+    if (m_core.is_dead()) {
+      KYTIN_LOG_INFO("KYTIN", "Soul Transfer executed; heartbeat scheduler "
+                              "stopped");
+      lock.lock();
+      break;
+    }
+
+    // Fire everything due, then re-arm from the deadline it was due at so
+    // a slow signature does not push the agent's schedule back
+    due.clear();
+    m_wheel.advance(now_tick, due);
+    for (auto *timer : due) {
+      auto &agent = static_cast<Agent &>(*timer);
+      uint64_t deadline = agent.expires;
+      fire(agent);
+      m_wheel.arm(agent, next_deadline(agent, deadline));
+    }
+
+    lock.lock();
+  }
+
+  std::vector<ParkedBeat> parked;
+  const uint64_t now_ms = unix_millis();
+  for (auto &[id, agent] : m_agents) {
+    if (agent->armed()) {
+      uint64_t ticks =
+          agent->expires > m_wheel.now() ? agent->expires - m_wheel.now() : 0;
+      parked.push_back(
+          {id, agent->turbo, agent->seq, now_ms + ticks * TICK_MS});
+    }
+    m_wheel.cancel(*agent);
+  }
+  {
+    std::lock_guard<std::mutex> parked_lock(m_parked_mutex);
+    m_parked = std::move(parked);
+  }
+  m_agents.clear();
+  m_agent_count.store(0);
+  m_generation = 0;
+  close_sink();
+  m_sink_spec.clear();
+}
+
+// ============================================================================
+// SINK
+// ============================================================================
+
+/**
+ * "file:PATH" appends JSON lines; "unix:PATH" sends one datagram per line to
+ * a SOCK_DGRAM socket, or streams lines to a SOCK_STREAM listener
+ */
+bool HeartbeatScheduler::open_sink(const std::string &spec) {
+  if (spec.rfind("file:", 0) == 0) {
+    std::string path = spec.substr(5);
+    m_sink_fd = ::open(path.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC,
+                       0640);
+    m_sink_socket = m_sink_datagram = false;
+  } else if (spec.rfind("unix:", 0) == 0) {
+    std::string path = spec.substr(5);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+      KYTIN_LOG_ERROR("KYTIN", "Heartbeat sink path too long: ", path);
+      return false;
+    }
+    std::memcpy(addr.sun_path, path.c_str(), path.size());
+
+    for (int type : {SOCK_DGRAM, SOCK_STREAM}) {
+      int fd = socket(AF_UNIX, type | SOCK_CLOEXEC, 0);
+      if (fd < 0)
+        break;
+      if (connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0) {
+        m_sink_fd = fd;
+        m_sink_socket = true;
+        m_sink_datagram = type == SOCK_DGRAM;
+        break;
+      }
+      int err = errno;
+      ::close(fd);
+      if (err != EPROTOTYPE) {
+        errno = err;
+        break;
+      }
+    }
+  } else {
+    KYTIN_LOG_ERROR("KYTIN", "Heartbeat sink '", spec,
+                    "' must start with file: or unix:");
+    return false;
+  }
+
+  if (m_sink_fd < 0) {
+    KYTIN_LOG_WARN("KYTIN", "Heartbeat sink ", spec,
+                   " unavailable: ", std::strerror(errno));
+    return false;
+  }
+  return true;
+}
+
+void HeartbeatScheduler::close_sink() {
+  if (m_sink_fd >= 0) {
+    ::close(m_sink_fd);
+    m_sink_fd = -1;
+  }
+}
+
+bool HeartbeatScheduler::write_sink(const std::string &line) {
+  // A socket reader that went away is reconnected, at most every 10 s
+  constexpr uint64_t RETRY_TICKS = 10 * 1000 / TICK_MS;
+  if (m_sink_fd < 0) {
+    if (m_wheel.now() < m_sink_retry_tick)
+      return false;
+    m_sink_retry_tick = m_wheel.now() + RETRY_TICKS;
+    if (!open_sink(m_sink_spec))
+      return false;
+  }
+
+  // Datagrams are sent whole or dropped (never block on a slow reader);
+  // streams and files loop over short writes
+  size_t done = 0;
+  while (done < line.size()) {
+    ssize_t n = m_sink_socket
+                    ? send(m_sink_fd, line.data() + done, line.size() - done,
+                           MSG_NOSIGNAL | (m_sink_datagram ? MSG_DONTWAIT : 0))
+                    : ::write(m_sink_fd, line.data() + done,
+                              line.size() - done);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n < 0 && m_sink_datagram && errno == EAGAIN)
+      return false; // Reader is behind; keep the socket
+    if (n <= 0) {
+      KYTIN_LOG_WARN("KYTIN", "Heartbeat sink ", m_sink_spec,
+                     " write failed: ", std::strerror(errno));
+      close_sink();
+      return false;
+    }
+    done += static_cast<size_t>(n);
+  }
+  return true;
+}
+
+} // namespace kytin
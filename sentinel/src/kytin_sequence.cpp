@@ -0,0 +1,82 @@
+/*
+ * Kytin Protocol - Signature Sequence Numbers
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ */
+
+#include "kytin_sequence.hpp"
+#include "kytin_log.hpp"
+
+namespace kytin {
+
+// Counter values at or above this would overflow the 64-bit number space
+static constexpr uint64_t MAX_BLOCK = ~uint64_t{0} / SEQUENCE_BLOCK;
+
+SequenceAllocator::SequenceAllocator(TPMInterface &tpm) : m_tpm(tpm) {}
+
+std::optional<uint64_t> SequenceAllocator::next() {
+  for (;;) {
+    const uint64_t seq = m_next.fetch_add(1, std::memory_order_relaxed);
+    if (seq / SEQUENCE_BLOCK == m_block.load(std::memory_order_acquire)) {
+      m_issued.fetch_add(1, std::memory_order_relaxed);
+      return seq;
+    }
+
+    // Block exhausted (or none yet): one thread reserves the next block,
+    // the others wait for it and draw again
+    std::lock_guard<std::mutex> lock(m_reserve_mutex);
+    const uint64_t block = m_block.load(std::memory_order_acquire);
+    if (block != NO_BLOCK && seq / SEQUENCE_BLOCK < block)
+      continue; // Drawn before a reservation raised m_next; draw again
+    if (seq / SEQUENCE_BLOCK != block) {
+      if (!reserve_block())
+        return std::nullopt;
+      // Usually the first number of the new block: keep it
+      if (seq / SEQUENCE_BLOCK != m_block.load(std::memory_order_relaxed))
+        continue;
+    }
+    m_issued.fetch_add(1, std::memory_order_relaxed);
+    return seq;
+  }
+}
+
+/**
+ * Increment the NV counter and move m_next to the start of the new block
+ * (caller holds m_reserve_mutex)
+ */
+bool SequenceAllocator::reserve_block() {
+  const uint32_t nv_index = m_nv_index.load();
+  auto counter = m_tpm.increment_counter(nv_index);
+  if (!counter || *counter >= MAX_BLOCK) {
+    m_failures.fetch_add(1, std::memory_order_relaxed);
+    KYTIN_LOG_ERROR("KYTIN", "Sequence: could not reserve a block from NV "
+                             "index ", nv_index);
+    return false;
+  }
+
+  // Numbers below the block were either issued earlier or skipped
+  const uint64_t first = *counter * SEQUENCE_BLOCK;
+  uint64_t next = m_next.load(std::memory_order_relaxed);
+  while (next < first &&
+         !m_next.compare_exchange_weak(next, first, std::memory_order_relaxed))
+    ;
+  m_block.store(*counter, std::memory_order_release);
+  m_blocks.fetch_add(1, std::memory_order_relaxed);
+
+  KYTIN_LOG_DEBUG("KYTIN", "Sequence: reserved block ", *counter,
+                  " (from ", first, ")");
+  return true;
+}
+
+SequenceAllocator::Stats SequenceAllocator::stats() const {
+  Stats s;
+  s.issued = m_issued.load();
+  s.blocks = m_blocks.load();
+  s.failures = m_failures.load();
+  return s;
+}
+
+} // namespace kytin
@@ -0,0 +1,227 @@
+/*
+ * Kytin Protocol - Skill Signature Verification
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ *
+ * Same checks, in the same order, as verifySkillSignature() in the bridge:
+ * trusted key, signature decoding, key format and decoding (keys shorter
+ * than 32 bytes are zero-padded, as the bridge does for demo keys), then
+ * Ed25519 verification of the code bytes via OpenSSL.
+ */
+
+#include "kytin_skill.hpp"
+#include "kytin_verify.hpp"
+
+#include <openssl/evp.h>
+#include <openssl/sha.h>
+
+#include <algorithm>
+
+namespace kytin {
+
+const char *skill_verdict_name(SkillVerdict verdict) {
+  switch (verdict) {
+  case SkillVerdict::VALID:
+    return "VALID";
+  case SkillVerdict::UNTRUSTED_SOURCE:
+    return "UNTRUSTED_SOURCE";
+  case SkillVerdict::INVALID_KEY_FORMAT:
+    return "INVALID_KEY_FORMAT";
+  case SkillVerdict::INVALID_KEY:
+    return "INVALID_KEY";
+  case SkillVerdict::INVALID_SIGNATURE:
+    return "INVALID_SIGNATURE";
+  case SkillVerdict::SIGNATURE_INVALID:
+    return "SIGNATURE_INVALID";
+  case SkillVerdict::NOT_CACHED:
+    return "NOT_CACHED";
+  }
+  return "UNKNOWN";
+}
+
+/**
+ * Most recently decoded developer key; a skill directory is usually signed
+ * by one or two developers, so verify_each() decodes each key once
+ */
+struct SkillVerifier::KeyDecoder {
+  std::string developer_key;
+  EVP_PKEY *pkey = nullptr;
+  SkillVerdict error = SkillVerdict::VALID;
+
+  ~KeyDecoder() { EVP_PKEY_free(pkey); }
+
+  /**
+   * @return nullptr with `error` set if the key is unusable
+   */
+  EVP_PKEY *decode(const std::string &key) {
+    if (key == developer_key)
+      return pkey;
+
+    EVP_PKEY_free(pkey);
+    pkey = nullptr;
+    developer_key = key;
+
+    // "Prefix:ed25519:base64key"
+    size_t first = key.find(':');
+    size_t second =
+        first == std::string::npos ? first : key.find(':', first + 1);
+    if (second == std::string::npos ||
+        key.find(':', second + 1) != std::string::npos ||
+        key.compare(first + 1, second - first - 1, "ed25519") != 0) {
+      error = SkillVerdict::INVALID_KEY_FORMAT;
+      return nullptr;
+    }
+
+    std::vector<uint8_t> raw;
+    if (!base64_decode(key.substr(second + 1), raw) || raw.size() > 32) {
+      error = SkillVerdict::INVALID_KEY;
+      return nullptr;
+    }
+    raw.resize(32, 0);
+
+    pkey = EVP_PKEY_new_raw_public_key(EVP_PKEY_ED25519, nullptr, raw.data(),
+                                       raw.size());
+    error = pkey ? SkillVerdict::VALID : SkillVerdict::INVALID_KEY;
+    return pkey;
+  }
+};
+
+static bool ed25519_verify(EVP_PKEY *pkey, const std::string &message,
+                           const std::vector<uint8_t> &signature) {
+  EVP_MD_CTX *ctx = EVP_MD_CTX_new();
+  if (!ctx)
+    return false;
+  bool ok =
+      EVP_DigestVerifyInit(ctx, nullptr, nullptr, nullptr, pkey) == 1 &&
+      EVP_DigestVerify(ctx, signature.data(), signature.size(),
+                       reinterpret_cast<const uint8_t *>(message.data()),
+                       message.size()) == 1;
+  EVP_MD_CTX_free(ctx);
+  return ok;
+}
+
+// ============================================================================
+// SKILL VERIFIER
+// ============================================================================
+
+SkillVerifier::SkillVerifier(uint32_t cache_entries)
+    : m_shards(std::make_unique<Shard[]>(SHARDS)),
+      m_shard_capacity(std::max<uint32_t>(1, cache_entries / SHARDS)) {}
+
+SkillVerifier::Result
+SkillVerifier::verify(SkillCheck check,
+                      const std::vector<std::string> &trusted) {
+  KeyDecoder decoder;
+  return check_one(check, trusted, decoder);
+}
+
+std::vector<SkillVerifier::Result>
+SkillVerifier::verify_each(std::vector<SkillCheck> checks,
+                            const std::vector<std::string> &trusted) {
+  KeyDecoder decoder;
+  std::vector<Result> results;
+  results.reserve(checks.size());
+  for (auto &check : checks)
+    results.push_back(check_one(check, trusted, decoder));
+  return results;
+}
+
+SkillVerifier::Result
+SkillVerifier::check_one(SkillCheck &check,
+                         const std::vector<std::string> &trusted,
+                         KeyDecoder &decoder) {
+  Result result;
+  if (check.has_code)
+    SHA256(reinterpret_cast<const uint8_t *>(check.code.data()),
+           check.code.size(), check.content_hash.data());
+  result.content_hash = check.content_hash;
+
+  if (std::find(trusted.begin(), trusted.end(), check.developer_key) ==
+      trusted.end()) {
+    result.verdict = SkillVerdict::UNTRUSTED_SOURCE;
+    return result;
+  }
+
+  std::vector<uint8_t> signature;
+  if (!base64_decode(check.signature, signature) || signature.size() != 64) {
+    result.verdict = SkillVerdict::INVALID_SIGNATURE;
+    return result;
+  }
+
+  // Cache key: the content hash bound to this exact signature and signer
+  std::vector<uint8_t> material(check.content_hash.begin(),
+                                check.content_hash.end());
+  material.insert(material.end(), signature.begin(), signature.end());
+  material.insert(material.end(), check.developer_key.begin(),
+                  check.developer_key.end());
+  Key key;
+  SHA256(material.data(), material.size(), key.data());
+
+  bool valid = false;
+  if (lookup(key, valid)) {
+    result.cached = true;
+    result.verdict =
+        valid ? SkillVerdict::VALID : SkillVerdict::SIGNATURE_INVALID;
+    return result;
+  }
+
+  // Only a miss pays for key decoding (cached entries had a usable key)
+  EVP_PKEY *pkey = decoder.decode(check.developer_key);
+  if (!pkey) {
+    result.verdict = decoder.error;
+    return result;
+  }
+  if (!check.has_code) {
+    result.verdict = SkillVerdict::NOT_CACHED;
+    return result;
+  }
+
+  valid = ed25519_verify(pkey, check.code, signature);
+  remember(key, valid);
+  result.verdict =
+      valid ? SkillVerdict::VALID : SkillVerdict::SIGNATURE_INVALID;
+  return result;
+}
+
+bool SkillVerifier::lookup(const Key &key, bool &valid) {
+  Shard &shard = m_shards[key[31] % SHARDS];
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  auto it = shard.index.find(key);
+  if (it == shard.index.end()) {
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+  valid = it->second->second;
+  m_hits.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+void SkillVerifier::remember(const Key &key, bool valid) {
+  Shard &shard = m_shards[key[31] % SHARDS];
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  if (shard.index.count(key))
+    return; // Another thread verified the same bundle meanwhile
+
+  shard.lru.emplace_front(key, valid);
+  shard.index.emplace(key, shard.lru.begin());
+  if (shard.lru.size() > m_shard_capacity) {
+    shard.index.erase(shard.lru.back().first);
+    shard.lru.pop_back();
+    m_evictions.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+SkillVerifier::Stats SkillVerifier::stats() const {
+  Stats s;
+  s.hits = m_hits.load();
+  s.misses = m_misses.load();
+  s.evictions = m_evictions.load();
+  s.capacity = m_shard_capacity * SHARDS;
+  return s;
+}
+
+} // namespace kytin
@@ -0,0 +1,197 @@
+/*
+ * Kytin Protocol - Shared-Memory Status Page
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ */
+
+#include "kytin_status_page.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace kytin {
+
+// Give up after this many torn reads (the writer holds the lock for a few
+// hundred nanoseconds per update, so this only triggers if it died mid-write)
+static constexpr int MAX_READ_ATTEMPTS = 1000;
+
+// ============================================================================
+// WRITER
+// ============================================================================
+
+bool StatusPageWriter::open(const std::string &name, std::string *error) {
+#ifndef _WIN32
+  close();
+
+  // A fresh segment rather than reusing one: a reader that still maps the
+  // old page sees STATUS_CLOSED there and follows the name to this one
+  shm_unlink(name.c_str());
+  int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+  if (fd < 0 || ftruncate(fd, sizeof(StatusPageLayout)) != 0) {
+    if (error)
+      *error = "status page " + name + ": " + std::strerror(errno);
+    if (fd >= 0) {
+      ::close(fd);
+      shm_unlink(name.c_str());
+    }
+    return false;
+  }
+
+  void *addr = mmap(nullptr, sizeof(StatusPageLayout), PROT_READ | PROT_WRITE,
+                    MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (addr == MAP_FAILED) {
+    if (error)
+      *error = "status page " + name + ": " + std::strerror(errno);
+    shm_unlink(name.c_str());
+    return false;
+  }
+
+  // ftruncate zero-filled the page: seq 0, all words 0
+  m_page = static_cast<StatusPageLayout *>(addr);
+  m_page->version = STATUS_PAGE_VERSION;
+  m_page->magic.store(STATUS_PAGE_MAGIC, std::memory_order_release);
+  m_name = name;
+  return true;
+#else
+  if (error)
+    *error = "status page: POSIX shared memory not available";
+  return false;
+#endif
+}
+
+void StatusPageWriter::publish(const StatusSnapshot &snapshot) {
+  if (!m_page)
+    return;
+  m_last = snapshot;
+
+  uint64_t words[StatusPageLayout::WORDS];
+  std::memcpy(words, &snapshot, sizeof(words));
+
+  const uint64_t seq = m_page->seq.load(std::memory_order_relaxed);
+  m_page->seq.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  for (size_t i = 0; i < StatusPageLayout::WORDS; i++)
+    m_page->words[i].store(words[i], std::memory_order_relaxed);
+  m_page->seq.store(seq + 2, std::memory_order_release);
+}
+
+void StatusPageWriter::close() {
+#ifndef _WIN32
+  if (!m_page)
+    return;
+  StatusSnapshot last = m_last;
+  last.flags = (last.flags & ~StatusSnapshot::STATUS_READY) |
+               StatusSnapshot::STATUS_CLOSED;
+  publish(last);
+
+  shm_unlink(m_name.c_str());
+  munmap(m_page, sizeof(StatusPageLayout));
+  m_page = nullptr;
+#endif
+}
+
+// ============================================================================
+// READER
+// ============================================================================
+
+StatusReader::StatusReader(std::string name) : m_name(std::move(name)) {}
+
+StatusReader::~StatusReader() { unmap(); }
+
+bool StatusReader::map(std::string *error) {
+#ifndef _WIN32
+  int fd = shm_open(m_name.c_str(), O_RDONLY | O_CLOEXEC, 0);
+  if (fd < 0) {
+    if (error)
+      *error = "status page " + m_name + ": " + std::strerror(errno);
+    return false;
+  }
+
+  struct stat st {};
+  void *addr = MAP_FAILED;
+  if (fstat(fd, &st) == 0 &&
+      static_cast<size_t>(st.st_size) >= sizeof(StatusPageLayout))
+    addr = mmap(nullptr, sizeof(StatusPageLayout), PROT_READ, MAP_SHARED, fd,
+                0);
+  ::close(fd);
+  if (addr == MAP_FAILED) {
+    if (error)
+      *error = "status page " + m_name + ": not a Kytin status page";
+    return false;
+  }
+
+  m_page = static_cast<const StatusPageLayout *>(addr);
+  if (m_page->magic.load(std::memory_order_acquire) != STATUS_PAGE_MAGIC ||
+      m_page->version < 1) {
+    // Not ours, or the writer is still setting it up
+    unmap();
+    if (error)
+      *error = "status page " + m_name + ": not a Kytin status page";
+    return false;
+  }
+  return true;
+#else
+  if (error)
+    *error = "status page: POSIX shared memory not available";
+  return false;
+#endif
+}
+
+void StatusReader::unmap() {
+#ifndef _WIN32
+  if (m_page)
+    munmap(const_cast<StatusPageLayout *>(m_page), sizeof(StatusPageLayout));
+#endif
+  m_page = nullptr;
+}
+
+bool StatusReader::try_read(StatusSnapshot &out) const {
+  uint64_t words[StatusPageLayout::WORDS];
+  for (int attempt = 0; attempt < MAX_READ_ATTEMPTS; attempt++) {
+    const uint64_t before = m_page->seq.load(std::memory_order_acquire);
+    if (before & 1)
+      continue;
+    for (size_t i = 0; i < StatusPageLayout::WORDS; i++)
+      words[i] = m_page->words[i].load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (m_page->seq.load(std::memory_order_relaxed) == before) {
+      std::memcpy(&out, words, sizeof(words));
+      return true;
+    }
+  }
+  return false;
+}
+
+std::optional<StatusSnapshot> StatusReader::read(std::string *error) {
+  if (!m_page && !map(error))
+    return std::nullopt;
+
+  StatusSnapshot snapshot;
+  if (!try_read(snapshot)) {
+    if (error)
+      *error = "status page " + m_name + ": writer stuck mid-update";
+    return std::nullopt;
+  }
+
+  // The writer went away; a successor may have published a new page
+  if (snapshot.has(StatusSnapshot::STATUS_CLOSED)) {
+    unmap();
+    StatusSnapshot current;
+    if (map(nullptr) && try_read(current))
+      return current;
+  }
+  return snapshot;
+}
+
+} // namespace kytin
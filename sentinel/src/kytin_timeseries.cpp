@@ -0,0 +1,148 @@
+/*
+ * Kytin Protocol - Burn and Spend Time Series
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ */
+
+#include "kytin_timeseries.hpp"
+
+#include <algorithm>
+
+namespace kytin {
+
+// Ring depths per resolution (see the header)
+static constexpr uint64_t WIDTHS[3] = {1, 60, 3600};
+static constexpr size_t SIZES[3] = {300, 1440, 168};
+
+std::optional<Resolution> parse_resolution(const std::string &name) {
+  if (name == "second")
+    return Resolution::SECOND;
+  if (name == "minute")
+    return Resolution::MINUTE;
+  if (name == "hour")
+    return Resolution::HOUR;
+  return std::nullopt;
+}
+
+const char *resolution_name(Resolution resolution) {
+  switch (resolution) {
+  case Resolution::SECOND:
+    return "second";
+  case Resolution::MINUTE:
+    return "minute";
+  default:
+    return "hour";
+  }
+}
+
+Timeseries::Timeseries() {
+  for (int i = 0; i < 3; i++) {
+    m_rings[i].width_s = WIDTHS[i];
+    m_rings[i].size = SIZES[i];
+    m_rings[i].buckets = std::make_unique<Bucket[]>(SIZES[i]);
+  }
+}
+
+size_t Timeseries::capacity(Resolution resolution) {
+  return SIZES[static_cast<int>(resolution)];
+}
+
+const Timeseries::Ring &Timeseries::ring(Resolution resolution) const {
+  return m_rings[static_cast<int>(resolution)];
+}
+
+void Timeseries::record(uint64_t unix_s, uint64_t resin, uint64_t lamports,
+                        uint64_t heartbeats, uint64_t signs) {
+  m_latest_s = std::max(m_latest_s, unix_s);
+
+  for (Ring &ring : m_rings) {
+    const uint64_t period = m_latest_s / ring.width_s;
+    Bucket &b = ring.buckets[period % ring.size];
+
+    if (b.period.load(std::memory_order_relaxed) != period) {
+      // Recycle: readers that catch it mid-way see a period change and
+      // drop their copy
+      b.period.store(NO_PERIOD, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      b.resin.store(0, std::memory_order_relaxed);
+      b.lamports.store(0, std::memory_order_relaxed);
+      b.heartbeats.store(0, std::memory_order_relaxed);
+      b.signs.store(0, std::memory_order_relaxed);
+      b.period.store(period, std::memory_order_release);
+    }
+    b.resin.fetch_add(resin, std::memory_order_relaxed);
+    b.lamports.fetch_add(lamports, std::memory_order_relaxed);
+    b.heartbeats.fetch_add(heartbeats, std::memory_order_relaxed);
+    b.signs.fetch_add(signs, std::memory_order_relaxed);
+  }
+}
+
+Timeseries::Counts Timeseries::read(const Ring &ring, uint64_t period) {
+  const Bucket &b = ring.buckets[period % ring.size];
+  if (b.period.load(std::memory_order_acquire) != period)
+    return {};
+
+  Counts counts;
+  counts.resin = b.resin.load(std::memory_order_relaxed);
+  counts.lamports = b.lamports.load(std::memory_order_relaxed);
+  counts.heartbeats = b.heartbeats.load(std::memory_order_relaxed);
+  counts.signs = b.signs.load(std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (b.period.load(std::memory_order_relaxed) != period)
+    return {}; // Recycled while we read it
+  return counts;
+}
+
+Series Timeseries::series(Resolution resolution, size_t points,
+                          uint64_t unix_s) const {
+  const Ring &r = ring(resolution);
+  const uint64_t current = unix_s / r.width_s;
+  points =
+      std::clamp<size_t>(points, 1, std::min<uint64_t>(r.size, current + 1));
+
+  Series s;
+  s.resolution = resolution;
+  s.width_s = r.width_s;
+  s.start = (current + 1 - points) * r.width_s;
+  s.resin.reserve(points);
+  s.lamports.reserve(points);
+  s.heartbeats.reserve(points);
+  s.signs.reserve(points);
+
+  for (uint64_t period = current + 1 - points; period <= current; period++) {
+    const Counts c = read(r, period);
+    s.resin.push_back(c.resin);
+    s.lamports.push_back(c.lamports);
+    s.heartbeats.push_back(c.heartbeats);
+    s.signs.push_back(c.signs);
+  }
+  return s;
+}
+
+Rate Timeseries::rate(Resolution resolution, size_t periods,
+                      uint64_t unix_s) const {
+  const Ring &r = ring(resolution);
+  const uint64_t current = unix_s / r.width_s;
+  // The current period is still filling; the oldest may be recycled soon
+  periods = std::min<uint64_t>({periods, r.size - 1, current});
+
+  Rate rate;
+  rate.window_s = periods * r.width_s;
+  if (!periods)
+    return rate;
+
+  uint64_t resin = 0, lamports = 0;
+  for (uint64_t period = current - periods; period < current; period++) {
+    const Counts c = read(r, period);
+    resin += c.resin;
+    lamports += c.lamports;
+  }
+  rate.resin_per_s = static_cast<double>(resin) / rate.window_s;
+  rate.sol_per_s = static_cast<double>(lamports) / 1e9 / rate.window_s;
+  return rate;
+}
+
+} // namespace kytin
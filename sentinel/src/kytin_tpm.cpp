@@ -12,14 +12,20 @@
  */
 
 #include "kytin_tpm.hpp"
+#include "kytin_log.hpp"
+#include "kytin_sha256.hpp"
+#include "kytin_trace.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <cstdio>
 #include <cstdlib>
+#include <fstream>
 #include <functional>
 #include <iomanip>
-#include <iostream>
 #include <random>
 #include <sstream>
+#include <thread>
 
 // Only include TSS2 headers if we're building with real TPM support
 #ifndef MOCK_TPM
@@ -85,7 +91,8 @@ static uint64_t get_timestamp() {
 // ============================================================================
 
 bool TPMInterface::initialize() {
-  std::cout << "[KYTIN-TPM] Initializing TPM 2.0 context..." << std::endl;
+  KYTIN_LOG_INFO("KYTIN-TPM", "Initializing TPM 2.0 context",
+                 m_tcti.empty() ? "" : " on ", m_tcti, "...");
 
 #ifdef MOCK_TPM
   return init_mock_tpm();
@@ -94,17 +101,21 @@ bool TPMInterface::initialize() {
   if (init_real_tpm()) {
     return true;
   }
+  // A device that was asked for by name is not replaced by a mock
+  if (!m_tcti.empty()) {
+    KYTIN_LOG_ERROR("KYTIN-TPM", "TPM ", m_tcti, " not available");
+    return false;
+  }
   // Fall back to mock if real TPM fails
-  std::cout << "[KYTIN-TPM] Real TPM not available, falling back to mock mode"
-            << std::endl;
+  KYTIN_LOG_WARN("KYTIN-TPM",
+                 "Real TPM not available, falling back to mock mode");
   return init_mock_tpm();
 #endif
 }
 
 bool TPMInterface::init_mock_tpm() {
-  std::cout << "[KYTIN-TPM] *** MOCK MODE ACTIVE ***" << std::endl;
-  std::cout << "[KYTIN-TPM] No real TPM hardware required for testing"
-            << std::endl;
+  KYTIN_LOG_INFO("KYTIN-TPM", "*** MOCK MODE ACTIVE ***");
+  KYTIN_LOG_INFO("KYTIN-TPM", "No real TPM hardware required for testing");
 
   m_is_mock = true;
 
@@ -123,8 +134,8 @@ bool TPMInterface::init_mock_tpm() {
   m_firmware_version = "1.0.0-mock";
   m_initialized = true;
 
-  std::cout << "[KYTIN-TPM] Hardware ID: " << m_hardware_id << std::endl;
-  std::cout << "[KYTIN-TPM] Mock TPM initialized successfully" << std::endl;
+  KYTIN_LOG_INFO("KYTIN-TPM", "Hardware ID: ", m_hardware_id);
+  KYTIN_LOG_INFO("KYTIN-TPM", "Mock TPM initialized successfully");
 
   return true;
 }
@@ -132,18 +143,10 @@ bool TPMInterface::init_mock_tpm() {
 bool TPMInterface::init_real_tpm() {
 #if defined(KYTIN_TPM_ENABLED) && !defined(MOCK_TPM)
   // Real TPM initialization using tss2-esys
-  ESYS_CONTEXT *esys_ctx = nullptr;
-  TSS2_RC rc;
-
-  // Initialize the TPM context
-  rc = Esys_Initialize(&esys_ctx, nullptr, nullptr);
-  if (rc != TSS2_RC_SUCCESS) {
-    std::cerr << "[KYTIN-TPM] Esys_Initialize failed: " << Tss2_RC_Decode(rc)
-              << std::endl;
+  if (!open_context())
     return false;
-  }
-
-  m_tpm_context = esys_ctx;
+  ESYS_CONTEXT *esys_ctx = static_cast<ESYS_CONTEXT *>(m_tpm_context);
+  TSS2_RC rc;
 
   // Get TPM capabilities to verify it's working
   TPMS_CAPABILITY_DATA *cap_data = nullptr;
@@ -161,16 +164,17 @@ bool TPMInterface::init_real_tpm() {
     Esys_Free(cap_data);
   }
 
-  // Generate hardware ID from Endorsement Key
+  // Generate hardware ID from Endorsement Key (and the TCTI, so identical
+  // chips on one host get distinct IDs)
   std::hash<std::string> hasher;
-  m_hardware_id = "KYTIN-" + std::to_string(hasher(m_manufacturer + "ek"));
+  m_hardware_id =
+      "KYTIN-" + std::to_string(hasher(m_manufacturer + "ek" + m_tcti));
   m_firmware_version = "2.0";
   m_is_mock = false;
   m_initialized = true;
 
-  std::cout << "[KYTIN-TPM] Real TPM initialized: " << m_manufacturer
-            << std::endl;
-  std::cout << "[KYTIN-TPM] Hardware ID: " << m_hardware_id << std::endl;
+  KYTIN_LOG_INFO("KYTIN-TPM", "Real TPM initialized: ", m_manufacturer);
+  KYTIN_LOG_INFO("KYTIN-TPM", "Hardware ID: ", m_hardware_id);
 
   return true;
 #else
@@ -178,50 +182,170 @@ bool TPMInterface::init_real_tpm() {
 #endif
 }
 
+/**
+ * Load the TCTI (if one was named) and create the ESYS context over it
+ */
+bool TPMInterface::open_context() {
+#if defined(KYTIN_TPM_ENABLED) && !defined(MOCK_TPM)
+  TSS2_TCTI_CONTEXT *tcti = nullptr;
+  TSS2_RC rc;
+  if (!m_tcti.empty()) {
+    rc = Tss2_TctiLdr_Initialize(m_tcti.c_str(), &tcti);
+    if (rc != TSS2_RC_SUCCESS) {
+      KYTIN_LOG_ERROR("KYTIN-TPM", "TCTI ", m_tcti, ": ", Tss2_RC_Decode(rc));
+      return false;
+    }
+  }
+
+  ESYS_CONTEXT *esys_ctx = nullptr;
+  rc = Esys_Initialize(&esys_ctx, tcti, nullptr);
+  if (rc != TSS2_RC_SUCCESS) {
+    KYTIN_LOG_ERROR("KYTIN-TPM", "Esys_Initialize failed: ",
+                    Tss2_RC_Decode(rc));
+    if (tcti)
+      Tss2_TctiLdr_Finalize(&tcti);
+    return false;
+  }
+
+  m_tpm_context = esys_ctx;
+  m_tcti_context = tcti;
+  return true;
+#else
+  return false;
+#endif
+}
+
+void TPMInterface::close_context() {
+#if defined(KYTIN_TPM_ENABLED) && !defined(MOCK_TPM)
+  if (m_tpm_context) {
+    ESYS_CONTEXT *ctx = static_cast<ESYS_CONTEXT *>(m_tpm_context);
+    Esys_Finalize(&ctx);
+    m_tpm_context = nullptr;
+  }
+  if (m_tcti_context) {
+    auto *tcti = static_cast<TSS2_TCTI_CONTEXT *>(m_tcti_context);
+    Tss2_TctiLdr_Finalize(&tcti);
+    m_tcti_context = nullptr;
+  }
+#endif
+}
+
+// ============================================================================
+// TPM INTERFACE - HEALTH
+// ============================================================================
+
+bool TPMInterface::probe() {
+  if (!m_initialized)
+    return false;
+
+  if (m_is_mock) {
+    double latency_ms = 0.0;
+    bool serialize = true;
+    return sample_mock_command(latency_ms, serialize);
+  }
+
+#if defined(KYTIN_TPM_ENABLED) && !defined(MOCK_TPM)
+  std::lock_guard<std::mutex> command(m_command_mutex);
+  ESYS_CONTEXT *ctx = static_cast<ESYS_CONTEXT *>(m_tpm_context);
+  TPMS_CAPABILITY_DATA *cap_data = nullptr;
+  TSS2_RC rc = Esys_GetCapability(ctx, ESYS_TR_NONE, ESYS_TR_NONE,
+                                  ESYS_TR_NONE, TPM2_CAP_TPM_PROPERTIES,
+                                  TPM2_PT_MANUFACTURER, 1, nullptr, &cap_data);
+  Esys_Free(cap_data);
+  return rc == TSS2_RC_SUCCESS;
+#else
+  return false;
+#endif
+}
+
+bool TPMInterface::reopen() {
+  if (!m_initialized)
+    return initialize();
+  if (m_is_mock)
+    return true;
+
+#if defined(KYTIN_TPM_ENABLED) && !defined(MOCK_TPM)
+  // Under the command lock, so quotes and NV increments on other threads
+  // never see the context change under them
+  std::lock_guard<std::mutex> command(m_command_mutex);
+  close_context();
+  return open_context();
+#else
+  return false;
+#endif
+}
+
 // ============================================================================
 // TPM INTERFACE - SIGNING
 // ============================================================================
 
 std::optional<TPMInterface::Signature>
-TPMInterface::sign(const std::vector<uint8_t> &payload) {
+TPMInterface::sign(std::span<const uint8_t> payload) {
   if (!m_initialized) {
-    std::cerr << "[KYTIN-TPM] ERROR: TPM not initialized" << std::endl;
+    KYTIN_LOG_ERROR("KYTIN-TPM", "TPM not initialized");
     return std::nullopt;
   }
 
+  KYTIN_TRACE_SPAN("tpm.sign");
+
+  // Mock timing model: decide latency/failure up front, then hold the
+  // command lock for the simulated duration like real hardware would
+  double latency_ms = 0.0;
+  bool serialize = true;
+  bool inject_failure = m_is_mock && !sample_mock_command(latency_ms, serialize);
+
+  std::unique_lock<std::mutex> command(m_command_mutex, std::defer_lock);
+  if (serialize) {
+    KYTIN_TRACE_SPAN("tpm.queue");
+    command.lock();
+  }
+  KYTIN_TRACE_SPAN("tpm.command");
+
+  if (latency_ms > 0.0) {
+    std::this_thread::sleep_for(
+        std::chrono::duration<double, std::milli>(latency_ms));
+  }
+  if (inject_failure) {
+    KYTIN_LOG_WARN("KYTIN-TPM", "Mock: injected signing failure");
+    return std::nullopt;
+  }
+
+  KYTIN_LOG_DEBUG("KYTIN-TPM", "Signing ", payload.size(), "-byte payload");
+
   Signature sig;
   sig.algorithm = "Secp256r1";
   sig.timestamp = get_timestamp();
 
-#ifdef MOCK_TPM
-  // Mock signature: SHA256-like hash of payload + timestamp
-  std::vector<uint8_t> mock_sig;
-  mock_sig.reserve(64);
+  if (m_is_mock) {
+    // Mock signature: SHA256-like hash of payload + timestamp
+    std::vector<uint8_t> mock_sig;
+    mock_sig.reserve(64);
 
-  // Create deterministic but realistic-looking signature
-  std::hash<std::string> hasher;
-  size_t hash1 = hasher(std::string(payload.begin(), payload.end()) +
-                        std::to_string(sig.timestamp));
-  size_t hash2 = hasher(std::to_string(hash1));
+    // Create deterministic but realistic-looking signature
+    std::hash<std::string> hasher;
+    size_t hash1 = hasher(std::string(payload.begin(), payload.end()) +
+                          std::to_string(sig.timestamp));
+    size_t hash2 = hasher(std::to_string(hash1));
 
-  for (int i = 0; i < 32; i++) {
-    mock_sig.push_back(static_cast<uint8_t>((hash1 >> (i % 8)) ^ (i * 17)));
-  }
-  for (int i = 0; i < 32; i++) {
-    mock_sig.push_back(static_cast<uint8_t>((hash2 >> (i % 8)) ^ (i * 31)));
-  }
+    for (int i = 0; i < 32; i++) {
+      mock_sig.push_back(static_cast<uint8_t>((hash1 >> (i % 8)) ^ (i * 17)));
+    }
+    for (int i = 0; i < 32; i++) {
+      mock_sig.push_back(static_cast<uint8_t>((hash2 >> (i % 8)) ^ (i * 31)));
+    }
 
-  sig.data = mock_sig;
+    sig.data = mock_sig;
+    return sig;
+  }
 
-#else
-#ifdef KYTIN_TPM_ENABLED
+#if defined(KYTIN_TPM_ENABLED) && !defined(MOCK_TPM)
   // Real TPM signing using tss2-esys
   ESYS_CONTEXT *ctx = static_cast<ESYS_CONTEXT *>(m_tpm_context);
 
-  // Create digest from payload
+  // Sign the SHA-256 of the whole payload (sequence prefix included)
   TPM2B_DIGEST digest = {.size = 32};
-  // SHA256 hash of payload would go here
-  memcpy(digest.buffer, payload.data(), std::min(payload.size(), (size_t)32));
+  const auto hash = Sha256::hash(payload.data(), payload.size());
+  memcpy(digest.buffer, hash.data(), hash.size());
 
   TPMT_SIGNATURE *signature = nullptr;
   TSS2_RC rc = Esys_Sign(ctx, SIGNING_KEY_HANDLE, ESYS_TR_PASSWORD,
@@ -231,8 +355,7 @@ TPMInterface::sign(const std::vector<uint8_t> &payload) {
                          &signature);
 
   if (rc != TSS2_RC_SUCCESS) {
-    std::cerr << "[KYTIN-TPM] Signing failed: " << Tss2_RC_Decode(rc)
-              << std::endl;
+    KYTIN_LOG_ERROR("KYTIN-TPM", "Signing failed: ", Tss2_RC_Decode(rc));
     return std::nullopt;
   }
 
@@ -245,10 +368,10 @@ TPMInterface::sign(const std::vector<uint8_t> &payload) {
                       signature->signature.ecdsa.signatureS.size);
 
   Esys_Free(signature);
-#endif
-#endif
-
   return sig;
+#else
+  return std::nullopt; // Only the mock comes up without tss2
+#endif
 }
 
 std::optional<std::string>
@@ -263,6 +386,263 @@ TPMInterface::sign_transaction(const std::string &tx_hash) {
   return base64_encode(sig->data);
 }
 
+// ============================================================================
+// TPM INTERFACE - ATTESTATION
+// ============================================================================
+
+static void put_be(std::vector<uint8_t> &out, uint64_t value, int bytes) {
+  for (int i = bytes - 1; i >= 0; i--)
+    out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+}
+
+static void put_sized(std::vector<uint8_t> &out, const uint8_t *data,
+                      size_t len) {
+  put_be(out, len, 2);
+  out.insert(out.end(), data, data + len);
+}
+
+std::optional<TPMInterface::Quote>
+TPMInterface::quote(const std::vector<uint8_t> &qualifying_data) {
+  if (!m_initialized) {
+    KYTIN_LOG_ERROR("KYTIN-TPM", "TPM not initialized");
+    return std::nullopt;
+  }
+  if (qualifying_data.size() > 64) {
+    KYTIN_LOG_ERROR("KYTIN-TPM", "Quote: qualifying data exceeds 64 bytes");
+    return std::nullopt;
+  }
+
+  KYTIN_TRACE_SPAN("tpm.quote");
+
+  Quote out;
+  out.pcr_selection = "sha256:0-7";
+
+  if (m_is_mock) {
+    // Mock: a TPMS_ATTEST with the real layout (so verifiers can parse it)
+    // and zeroed PCRs, signed through the regular mock signing path
+    auto pubkey = get_public_key();
+    std::vector<uint8_t> name = {0x00, 0x0B}; // TPM2_ALG_SHA256
+    std::hash<std::string> hasher;
+    for (int i = 0; i < 4; i++) {
+      uint64_t h = hasher(std::string(pubkey.begin(), pubkey.end()) +
+                          static_cast<char>(i));
+      put_be(name, h, 8);
+    }
+
+    uint64_t clock_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                            std::chrono::steady_clock::now().time_since_epoch())
+                            .count();
+
+    std::vector<uint8_t> &attest = out.attest;
+    put_be(attest, 0xFF544347, 4);  // TPM_GENERATED_VALUE
+    put_be(attest, 0x8018, 2);      // TPM_ST_ATTEST_QUOTE
+    put_sized(attest, name.data(), name.size());
+    put_sized(attest, qualifying_data.data(), qualifying_data.size());
+    put_be(attest, clock_ms, 8);    // clockInfo.clock
+    put_be(attest, 0, 4);           // clockInfo.resetCount
+    put_be(attest, 0, 4);           // clockInfo.restartCount
+    attest.push_back(1);            // clockInfo.safe
+    put_be(attest, 0x0001000000000000ull, 8); // firmwareVersion
+    put_be(attest, 1, 4);           // pcrSelect.count
+    put_be(attest, 0x000B, 2);      // hash = SHA256
+    attest.push_back(3);            // sizeofSelect
+    attest.insert(attest.end(), {0xFF, 0x00, 0x00});
+    std::vector<uint8_t> pcr_digest(32, 0);
+    put_sized(attest, pcr_digest.data(), pcr_digest.size());
+
+    auto sig = sign(attest);
+    if (!sig)
+      return std::nullopt;
+    out.signature = std::move(*sig);
+    return out;
+  }
+
+#if defined(KYTIN_TPM_ENABLED) && !defined(MOCK_TPM)
+  std::lock_guard<std::mutex> command(m_command_mutex);
+  ESYS_CONTEXT *ctx = static_cast<ESYS_CONTEXT *>(m_tpm_context);
+
+  TPM2B_DATA extra = {.size = static_cast<UINT16>(qualifying_data.size())};
+  memcpy(extra.buffer, qualifying_data.data(), qualifying_data.size());
+
+  TPMT_SIG_SCHEME scheme = {.scheme = TPM2_ALG_NULL};
+  TPML_PCR_SELECTION pcrs = {};
+  pcrs.count = 1;
+  pcrs.pcrSelections[0].hash = TPM2_ALG_SHA256;
+  pcrs.pcrSelections[0].sizeofSelect = 3;
+  pcrs.pcrSelections[0].pcrSelect[0] = 0xFF;
+
+  TPM2B_ATTEST *quoted = nullptr;
+  TPMT_SIGNATURE *signature = nullptr;
+  TSS2_RC rc = Esys_Quote(ctx, SIGNING_KEY_HANDLE, ESYS_TR_PASSWORD,
+                          ESYS_TR_NONE, ESYS_TR_NONE, &extra, &scheme, &pcrs,
+                          &quoted, &signature);
+  if (rc != TSS2_RC_SUCCESS) {
+    KYTIN_LOG_ERROR("KYTIN-TPM", "Quote failed: ", Tss2_RC_Decode(rc));
+    return std::nullopt;
+  }
+
+  out.attest.assign(quoted->attestationData,
+                    quoted->attestationData + quoted->size);
+  out.signature.algorithm = "Secp256r1";
+  out.signature.timestamp = get_timestamp();
+  const auto &ecdsa = signature->signature.ecdsa;
+  out.signature.data.insert(out.signature.data.end(), ecdsa.signatureR.buffer,
+                            ecdsa.signatureR.buffer + ecdsa.signatureR.size);
+  out.signature.data.insert(out.signature.data.end(), ecdsa.signatureS.buffer,
+                            ecdsa.signatureS.buffer + ecdsa.signatureS.size);
+
+  Esys_Free(quoted);
+  Esys_Free(signature);
+  return out;
+#else
+  return std::nullopt; // Only the mock comes up without tss2
+#endif
+}
+
+// ============================================================================
+// TPM INTERFACE - NV COUNTERS
+// ============================================================================
+
+std::optional<uint64_t> TPMInterface::increment_counter(uint32_t nv_index) {
+  if (!m_initialized) {
+    KYTIN_LOG_ERROR("KYTIN-TPM", "TPM not initialized");
+    return std::nullopt;
+  }
+
+  KYTIN_TRACE_SPAN("tpm.nv_increment");
+
+  if (m_is_mock) {
+    std::lock_guard<std::mutex> lock(m_mock_mutex);
+    auto [it, inserted] = m_mock_counters.try_emplace(nv_index, 0);
+    if (inserted) {
+      // A real counter survives restarts; start above any earlier run
+      it->second = std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::system_clock::now().time_since_epoch())
+                       .count();
+    }
+    return ++it->second;
+  }
+
+#ifdef KYTIN_TPM_ENABLED
+  std::lock_guard<std::mutex> command(m_command_mutex);
+  ESYS_CONTEXT *ctx = static_cast<ESYS_CONTEXT *>(m_tpm_context);
+
+  ESYS_TR nv = ESYS_TR_NONE;
+  TSS2_RC rc = Esys_TR_FromTPMPublic(ctx, nv_index, ESYS_TR_NONE,
+                                     ESYS_TR_NONE, ESYS_TR_NONE, &nv);
+  if (rc != TSS2_RC_SUCCESS) {
+    // First use: an 8-byte counter written and read with its own empty auth
+    TPM2B_NV_PUBLIC pub = {};
+    pub.nvPublic.nvIndex = nv_index;
+    pub.nvPublic.nameAlg = TPM2_ALG_SHA256;
+    pub.nvPublic.attributes =
+        TPMA_NV_AUTHWRITE | TPMA_NV_AUTHREAD | TPMA_NV_NO_DA |
+        (TPM2_NT_COUNTER << TPMA_NV_TPM2_NT_SHIFT);
+    pub.nvPublic.dataSize = 8;
+    TPM2B_AUTH auth = {};
+    rc = Esys_NV_DefineSpace(ctx, ESYS_TR_RH_OWNER, ESYS_TR_PASSWORD,
+                             ESYS_TR_NONE, ESYS_TR_NONE, &auth, &pub, &nv);
+    if (rc != TSS2_RC_SUCCESS) {
+      KYTIN_LOG_ERROR("KYTIN-TPM", "NV define failed: ", Tss2_RC_Decode(rc));
+      return std::nullopt;
+    }
+    char name[11];
+    std::snprintf(name, sizeof(name), "0x%08X", nv_index);
+    KYTIN_LOG_INFO("KYTIN-TPM", "Defined NV counter ", name);
+  }
+
+  std::optional<uint64_t> value;
+  rc = Esys_NV_Increment(ctx, nv, nv, ESYS_TR_PASSWORD, ESYS_TR_NONE,
+                         ESYS_TR_NONE);
+  if (rc == TSS2_RC_SUCCESS) {
+    TPM2B_MAX_NV_BUFFER *data = nullptr;
+    rc = Esys_NV_Read(ctx, nv, nv, ESYS_TR_PASSWORD, ESYS_TR_NONE,
+                      ESYS_TR_NONE, 8, 0, &data);
+    if (rc == TSS2_RC_SUCCESS && data->size == 8) {
+      uint64_t v = 0;
+      for (int i = 0; i < 8; i++)
+        v = (v << 8) | data->buffer[i];
+      value = v;
+    }
+    Esys_Free(data);
+  }
+  if (!value)
+    KYTIN_LOG_ERROR("KYTIN-TPM", "NV increment failed: ", Tss2_RC_Decode(rc));
+  Esys_TR_Close(ctx, &nv);
+  return value;
+#else
+  return std::nullopt;
+#endif
+}
+
+// ============================================================================
+// TPM INTERFACE - MOCK TIMING MODEL
+// ============================================================================
+
+void TPMInterface::set_mock_profile(MockProfile profile) {
+  std::lock_guard<std::mutex> lock(m_mock_mutex);
+  profile.error_rate = std::clamp(profile.error_rate, 0.0, 1.0);
+  m_mock_profile = std::move(profile);
+  m_mock_trace_pos = 0;
+}
+
+void TPMInterface::set_mock_counter(uint32_t nv_index, uint64_t value) {
+  std::lock_guard<std::mutex> lock(m_mock_mutex);
+  m_mock_counters[nv_index] = value;
+}
+
+/**
+ * Sample latency for the next mock command.
+ * @return false if this command should fail (error injection)
+ */
+bool TPMInterface::sample_mock_command(double &latency_ms, bool &serialize) {
+  std::lock_guard<std::mutex> lock(m_mock_mutex);
+  const MockProfile &p = m_mock_profile;
+
+  switch (p.latency) {
+  case MockProfile::Latency::FIXED:
+    latency_ms = p.fixed_ms;
+    break;
+  case MockProfile::Latency::NORMAL:
+    latency_ms = std::max(
+        0.0, std::normal_distribution<double>(p.mean_ms, p.stddev_ms)(
+                 m_mock_rng));
+    break;
+  case MockProfile::Latency::TRACE:
+    if (!p.trace_ms.empty()) {
+      latency_ms = p.trace_ms[m_mock_trace_pos];
+      m_mock_trace_pos = (m_mock_trace_pos + 1) % p.trace_ms.size();
+    }
+    break;
+  case MockProfile::Latency::NONE:
+    break;
+  }
+
+  serialize = p.serialize;
+  return !(p.error_rate > 0.0 &&
+           std::bernoulli_distribution(p.error_rate)(m_mock_rng));
+}
+
+bool load_latency_trace(const std::string &path, std::vector<double> &out) {
+  std::ifstream in(path);
+  if (!in)
+    return false;
+
+  out.clear();
+  std::string line;
+  while (std::getline(in, line)) {
+    auto start = line.find_first_not_of(" \t");
+    if (start == std::string::npos || line[start] == '#')
+      continue;
+    try {
+      out.push_back(std::max(0.0, std::stod(line.substr(start))));
+    } catch (const std::exception &) {
+      return false;
+    }
+  }
+  return !out.empty();
+}
+
 std::string
 TPMInterface::generate_mock_signature(const std::vector<uint8_t> &payload) {
   auto sig = sign(payload);
@@ -281,25 +661,25 @@ std::vector<uint8_t> TPMInterface::get_public_key() const {
     return {};
   }
 
-#ifdef MOCK_TPM
-  // Mock: Return a valid-looking uncompressed EC public key (65 bytes)
-  // 0x04 prefix + 32 bytes X + 32 bytes Y
-  std::vector<uint8_t> pubkey(65);
-  pubkey[0] = 0x04; // Uncompressed point marker
+  if (m_is_mock) {
+    // Mock: Return a valid-looking uncompressed EC public key (65 bytes)
+    // 0x04 prefix + 32 bytes X + 32 bytes Y
+    std::vector<uint8_t> pubkey(65);
+    pubkey[0] = 0x04; // Uncompressed point marker
 
-  std::hash<std::string> hasher;
-  size_t h = hasher(m_hardware_id);
+    std::hash<std::string> hasher;
+    size_t h = hasher(m_hardware_id);
 
-  for (int i = 1; i <= 64; i++) {
-    pubkey[i] = static_cast<uint8_t>((h >> ((i - 1) % 8)) ^ (i * 7));
+    for (int i = 1; i <= 64; i++) {
+      pubkey[i] = static_cast<uint8_t>((h >> ((i - 1) % 8)) ^ (i * 7));
+    }
+
+    return pubkey;
   }
 
-  return pubkey;
-#else
   // Real TPM: Read public key from loaded key handle
   // Implementation would use Esys_ReadPublic
   return std::vector<uint8_t>(65, 0x04);
-#endif
 }
 
 TPMInterface::HardwareInfo TPMInterface::get_hardware_info() const {
@@ -313,15 +693,9 @@ void TPMInterface::shutdown() {
   if (!m_initialized)
     return;
 
-#if defined(KYTIN_TPM_ENABLED) && !defined(MOCK_TPM)
-  if (m_tpm_context) {
-    Esys_Finalize(static_cast<ESYS_CONTEXT **>(&m_tpm_context));
-    m_tpm_context = nullptr;
-  }
-#endif
-
+  close_context();
   m_initialized = false;
-  std::cout << "[KYTIN-TPM] TPM context shutdown complete" << std::endl;
+  KYTIN_LOG_INFO("KYTIN-TPM", "TPM context shutdown complete");
 }
 
 TPMInterface::~TPMInterface() { shutdown(); }
@@ -0,0 +1,305 @@
+/*
+ * Kytin Protocol - TPM Signing Farm
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ */
+
+#include "kytin_tpm_farm.hpp"
+#include "kytin_log.hpp"
+
+#include <algorithm>
+#include <future>
+
+namespace kytin {
+
+using Clock = std::chrono::steady_clock;
+
+// Weight of the newest sample in a device's latency average
+static constexpr double LATENCY_ALPHA = 0.1;
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+TPMFarm::TPMFarm(TPMInterface &primary) : m_primary(primary) {}
+
+TPMFarm::~TPMFarm() { shutdown(); }
+
+bool TPMFarm::initialize(const TPMFarmOptions &options) {
+  std::vector<Device> devices(std::max<size_t>(1, options.devices.size()));
+  devices[0].tpm = &m_primary;
+  if (!options.devices.empty())
+    m_primary.set_tcti(options.devices[0]);
+  for (size_t i = 1; i < devices.size(); i++) {
+    devices[i].owned = std::make_unique<TPMInterface>();
+    devices[i].owned->set_tcti(options.devices[i]);
+    devices[i].tpm = devices[i].owned.get();
+  }
+
+  TPMInterface::MockProfile profile;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    profile = m_mock_profile;
+  }
+
+  // Each chip answers on its own, so bring them up side by side
+  std::vector<std::future<bool>> started;
+  for (auto &device : devices) {
+    device.tpm->set_mock_profile(profile);
+    started.push_back(std::async(std::launch::async, [tpm = device.tpm] {
+      return tpm->initialize();
+    }));
+  }
+
+  size_t up = 0;
+  const auto now = Clock::now();
+  for (size_t i = 0; i < devices.size(); i++) {
+    Device &device = devices[i];
+    device.up = started[i].get();
+    device.last_ok = now;
+    if (device.up) {
+      device.hardware_id = device.tpm->get_hardware_id();
+      device.public_key = device.tpm->get_public_key();
+      up++;
+    } else if (i > 0) {
+      KYTIN_LOG_WARN("KYTIN-TPM", "Farm device ", i, " (",
+                     device.tpm->tcti(), ") is down; retrying every ",
+                     options.health_interval_ms, " ms");
+    }
+  }
+  const bool primary_up = devices[0].up;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_options = options;
+    m_options.down_after = std::max<uint32_t>(1, m_options.down_after);
+    m_devices = std::move(devices);
+  }
+
+  if (m_devices.size() > 1) {
+    KYTIN_LOG_INFO("KYTIN-TPM", "Signing farm: ", up, " of ",
+                   m_devices.size(), " devices up");
+    if (primary_up) {
+      std::lock_guard<std::mutex> lock(m_thread_mutex);
+      m_stopping = false;
+      m_thread = std::thread(&TPMFarm::run, this);
+    }
+  }
+  return primary_up;
+}
+
+void TPMFarm::shutdown() {
+  {
+    std::lock_guard<std::mutex> lock(m_thread_mutex);
+    m_stopping = true;
+  }
+  m_wake.notify_all();
+  if (m_thread.joinable())
+    m_thread.join();
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto &device : m_devices)
+    device.up = false;
+  // The primary also goes when the farm never came up
+  m_primary.shutdown();
+  for (auto &device : m_devices)
+    device.tpm->shutdown();
+}
+
+void TPMFarm::set_mock_profile(const TPMInterface::MockProfile &profile) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_mock_profile = profile;
+  for (auto &device : m_devices)
+    device.tpm->set_mock_profile(profile);
+}
+
+// ============================================================================
+// DISPATCH
+// ============================================================================
+
+std::optional<TPMInterface::Signature>
+TPMFarm::sign(std::span<const uint8_t> payload) {
+  uint64_t tried = 0;
+  while (auto index = acquire(tried)) {
+    tried |= uint64_t{1} << *index;
+
+    const auto started = Clock::now();
+    auto signature = m_devices[*index].tpm->sign(payload);
+    release(*index, signature.has_value(),
+            std::chrono::duration<double, std::milli>(Clock::now() - started)
+                .count());
+    if (signature) {
+      signature->device = static_cast<uint32_t>(*index);
+      return signature;
+    }
+  }
+  return std::nullopt;
+}
+
+/**
+ * Reserve the up device, not yet tried, with the fewest commands in flight.
+ * The scan starts after the last pick, so equally loaded devices take turns.
+ */
+std::optional<size_t> TPMFarm::acquire(uint64_t tried) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const size_t n = m_devices.size();
+  std::optional<size_t> best;
+  for (size_t k = 0; k < n; k++) {
+    const size_t i = (m_next + k) % n;
+    const Device &device = m_devices[i];
+    if (!device.up || (tried >> i & 1))
+      continue;
+    if (!best || device.in_flight < m_devices[*best].in_flight)
+      best = i;
+  }
+  if (best) {
+    m_devices[*best].in_flight++;
+    m_next = *best + 1;
+  }
+  return best;
+}
+
+void TPMFarm::release(size_t index, bool ok, double latency_ms) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  Device &device = m_devices[index];
+  device.in_flight--;
+  if (!ok) {
+    failed_locked(index);
+    return;
+  }
+  device.signs++;
+  device.consecutive_failures = 0;
+  device.last_ok = Clock::now();
+  if (device.signs == 1)
+    device.latency_ms = latency_ms;
+  else
+    device.latency_ms += LATENCY_ALPHA * (latency_ms - device.latency_ms);
+}
+
+/**
+ * Count a failed command; enough in a row take the device out of rotation,
+ * unless no other device is up to take its place
+ */
+void TPMFarm::failed_locked(size_t index) {
+  Device &device = m_devices[index];
+  device.failures++;
+  if (++device.consecutive_failures < m_options.down_after || !device.up ||
+      up_count_locked() <= 1)
+    return;
+
+  device.up = false;
+  device.downs++;
+  KYTIN_LOG_WARN("KYTIN-TPM", "Farm device ", index, " (",
+                 device.tpm->tcti(), ") marked down after ",
+                 device.consecutive_failures, " consecutive failures");
+}
+
+size_t TPMFarm::up_count_locked() const {
+  return std::count_if(m_devices.begin(), m_devices.end(),
+                       [](const Device &device) { return device.up; });
+}
+
+bool TPMFarm::is_available() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return up_count_locked() > 0;
+}
+
+const std::string &TPMFarm::hardware_id(uint32_t device) const {
+  // Written under m_mutex before the device is first marked up, never
+  // after: whoever saw it sign can read it without the lock
+  static const std::string none;
+  return device < m_devices.size() ? m_devices[device].hardware_id : none;
+}
+
+std::vector<TPMFarm::DeviceStats> TPMFarm::stats() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  std::vector<DeviceStats> out;
+  out.reserve(m_devices.size());
+  for (const auto &device : m_devices) {
+    DeviceStats s;
+    s.tcti = device.tpm->tcti();
+    s.hardware_id = device.hardware_id;
+    s.public_key = device.public_key;
+    s.up = device.up;
+    s.in_flight = device.in_flight;
+    s.signs = device.signs;
+    s.failures = device.failures;
+    s.downs = device.downs;
+    s.latency_ms = device.latency_ms;
+    out.push_back(std::move(s));
+  }
+  return out;
+}
+
+// ============================================================================
+// HEALTH CHECKS
+// ============================================================================
+
+void TPMFarm::run() {
+  std::unique_lock<std::mutex> lock(m_thread_mutex);
+  while (!m_stopping) {
+    m_wake.wait_for(lock,
+                    std::chrono::milliseconds(
+                        std::max<uint32_t>(1, m_options.health_interval_ms)),
+                    [&] { return m_stopping; });
+    if (m_stopping)
+      break;
+    lock.unlock();
+    for (size_t i = 0; i < m_devices.size(); i++)
+      check(i);
+    lock.lock();
+  }
+}
+
+/**
+ * Probe one idle device. An up device that fails counts a failure like a
+ * failed signature; a down one is reopened first (its TCTI connection may
+ * be gone) and returns to rotation once it answers.
+ */
+void TPMFarm::check(size_t index) {
+  const auto interval =
+      std::chrono::milliseconds(m_options.health_interval_ms);
+  Device &device = m_devices[index];
+  bool was_up;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (device.in_flight || device.checking)
+      return;
+    // Recent good signatures already say it is healthy
+    if (device.up && Clock::now() - device.last_ok < interval)
+      return;
+    device.checking = true;
+    was_up = device.up;
+  }
+
+  TPMInterface &tpm = *device.tpm;
+  bool ok = tpm.probe();
+  if (!ok && !was_up)
+    ok = tpm.reopen() && tpm.probe();
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  device.checking = false;
+  if (!ok) {
+    if (was_up)
+      failed_locked(index);
+    return;
+  }
+  device.consecutive_failures = 0;
+  device.last_ok = Clock::now();
+  if (!device.up) {
+    device.up = true;
+    // Readers hold no lock: set once, on the first time up (a device that
+    // was down from the start), and left alone on every recovery after
+    if (device.hardware_id.empty()) {
+      device.hardware_id = tpm.get_hardware_id();
+      device.public_key = tpm.get_public_key();
+    }
+    KYTIN_LOG_INFO("KYTIN-TPM", "Farm device ", index, " (", tpm.tcti(),
+                   ") is back up");
+  }
+}
+
+} // namespace kytin
@@ -0,0 +1,175 @@
+/*
+ * Kytin Protocol - Span Tracing
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ */
+
+#include "kytin_trace.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using json = nlohmann::json;
+
+namespace kytin {
+
+namespace detail {
+std::atomic<uint64_t> g_trace_threshold{0};
+thread_local TraceThreadState t_trace{false, 0};
+} // namespace detail
+
+namespace {
+
+std::atomic<uint32_t> g_buffer_spans{4096};
+std::atomic<uint64_t> g_next_trace_id{1};
+std::atomic<uint32_t> g_next_tid{1};
+
+struct SpanRecord {
+  const char *name;
+  uint64_t start_ns;
+  uint64_t end_ns;
+  uint64_t trace_id;
+};
+
+/**
+ * One thread's spans. The owning thread appends; the exporter reads. The
+ * mutex is uncontended except during an export.
+ */
+struct TraceBuffer {
+  std::mutex mutex;
+  std::vector<SpanRecord> ring;
+  uint64_t head = 0; // Total spans ever written
+  uint64_t tail = 0; // First span not yet cleared
+  uint32_t tid = 0;
+};
+
+struct TraceRegistry {
+  std::mutex mutex;
+  std::vector<std::shared_ptr<TraceBuffer>> buffers;
+};
+
+TraceRegistry &registry() {
+  static TraceRegistry instance;
+  return instance;
+}
+
+TraceBuffer &thread_buffer() {
+  thread_local std::shared_ptr<TraceBuffer> buffer;
+  if (!buffer) {
+    buffer = std::make_shared<TraceBuffer>();
+    buffer->ring.resize(std::max<uint32_t>(1, g_buffer_spans.load()));
+    buffer->tid = g_next_tid.fetch_add(1);
+    auto &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.buffers.push_back(buffer);
+  }
+  return *buffer;
+}
+
+/**
+ * Per-thread xorshift64 draw for the sampling decision
+ */
+uint64_t thread_random() {
+  thread_local uint64_t state =
+      0x9E3779B97F4A7C15ull ^ reinterpret_cast<uintptr_t>(&state) ^
+      static_cast<uint64_t>(
+          std::chrono::steady_clock::now().time_since_epoch().count());
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
+}
+
+} // namespace
+
+void set_trace_options(const TraceOptions &options) {
+  double rate = std::clamp(options.sample_rate, 0.0, 1.0);
+  uint64_t threshold =
+      rate >= 1.0 ? UINT64_MAX : static_cast<uint64_t>(rate * 0x1p64);
+  if (rate > 0.0 && threshold == 0)
+    threshold = 1;
+  detail::g_trace_threshold.store(threshold, std::memory_order_relaxed);
+  g_buffer_spans.store(options.buffer_spans);
+}
+
+namespace detail {
+
+uint64_t trace_now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+bool trace_begin_request() {
+  uint64_t threshold = g_trace_threshold.load(std::memory_order_relaxed);
+  if (threshold != UINT64_MAX && thread_random() >= threshold)
+    return false;
+  t_trace.active = true;
+  t_trace.trace_id = g_next_trace_id.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+void trace_end_request() { t_trace.active = false; }
+
+void trace_record(const char *name, uint64_t start_ns, uint64_t end_ns) {
+  TraceBuffer &buffer = thread_buffer();
+  std::lock_guard<std::mutex> lock(buffer.mutex);
+  buffer.ring[buffer.head % buffer.ring.size()] = {name, start_ns, end_ns,
+                                                   t_trace.trace_id};
+  buffer.head++;
+}
+
+} // namespace detail
+
+std::string trace_dump_chrome_json(bool clear) {
+  std::vector<std::shared_ptr<TraceBuffer>> buffers;
+  {
+    auto &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    buffers = reg.buffers;
+  }
+
+  json events = json::array();
+  for (const auto &buffer : buffers) {
+    std::lock_guard<std::mutex> lock(buffer->mutex);
+    uint64_t size = buffer->ring.size();
+    uint64_t first = std::max(buffer->tail, buffer->head > size
+                                                ? buffer->head - size
+                                                : 0);
+    if (first == buffer->head)
+      continue;
+
+    events.push_back({{"name", "thread_name"},
+                      {"ph", "M"},
+                      {"pid", 1},
+                      {"tid", buffer->tid},
+                      {"args", {{"name", "worker-" +
+                                             std::to_string(buffer->tid)}}}});
+    for (uint64_t i = first; i < buffer->head; i++) {
+      const SpanRecord &span = buffer->ring[i % size];
+      events.push_back({{"name", span.name},
+                        {"cat", "kytin"},
+                        {"ph", "X"},
+                        {"ts", span.start_ns / 1000.0},
+                        {"dur", (span.end_ns - span.start_ns) / 1000.0},
+                        {"pid", 1},
+                        {"tid", buffer->tid},
+                        {"args", {{"trace_id", span.trace_id}}}});
+    }
+    if (clear)
+      buffer->tail = buffer->head;
+  }
+
+  return json{{"traceEvents", std::move(events)}, {"displayTimeUnit", "ms"}}
+      .dump();
+}
+
+} // namespace kytin
@@ -0,0 +1,501 @@
+/*
+ * Kytin Protocol - Batch Signature Verification
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ *
+ * ECDSA verification of (r, s) over digest e with public key Q:
+ *   w  = s^-1 mod n
+ *   u1 = e * w mod n,  u2 = r * w mod n
+ *   R  = u1 * G + u2 * Q,  valid iff R != O and x(R) mod n == r
+ *
+ * The per-signature inversion dominates the scalar work, so a batch shares
+ * one inversion via Montgomery's trick. The double-scalar multiplication
+ * uses OpenSSL's constant-table P-256 implementation.
+ */
+
+#include "kytin_verify.hpp"
+
+#include <nlohmann/json.hpp>
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <openssl/obj_mac.h>
+#include <openssl/sha.h>
+
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+using json = nlohmann::json;
+
+namespace kytin {
+
+// ============================================================================
+// HELPER FUNCTIONS
+// ============================================================================
+
+static int hex_value(char c) {
+  if (c >= '0' && c <= '9')
+    return c - '0';
+  if (c >= 'a' && c <= 'f')
+    return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F')
+    return c - 'A' + 10;
+  return -1;
+}
+
+std::vector<uint8_t> hex_decode(const std::string &hex) {
+  if (hex.size() % 2)
+    return {};
+
+  std::vector<uint8_t> out(hex.size() / 2);
+  for (size_t i = 0; i < out.size(); i++) {
+    int hi = hex_value(hex[2 * i]);
+    int lo = hex_value(hex[2 * i + 1]);
+    if (hi < 0 || lo < 0)
+      return {};
+    out[i] = static_cast<uint8_t>((hi << 4) | lo);
+  }
+  return out;
+}
+
+bool base64_decode(const std::string &in, std::vector<uint8_t> &out) {
+  static const auto table = [] {
+    std::array<int8_t, 256> t{};
+    t.fill(-1);
+    const char *chars =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    for (int i = 0; i < 64; i++)
+      t[static_cast<uint8_t>(chars[i])] = static_cast<int8_t>(i);
+    return t;
+  }();
+
+  out.clear();
+  out.reserve(in.size() * 3 / 4);
+  int val = 0, valb = -8;
+  for (char c : in) {
+    if (c == '=')
+      break;
+    int d = table[static_cast<uint8_t>(c)];
+    if (d < 0)
+      return false;
+    val = (val << 6) | d;
+    valb += 6;
+    if (valb >= 0) {
+      out.push_back(static_cast<uint8_t>((val >> valb) & 0xFF));
+      valb -= 8;
+    }
+  }
+  return true;
+}
+
+const char *verify_status_name(VerifyStatus status) {
+  switch (status) {
+  case VerifyStatus::VALID:
+    return "VALID";
+  case VerifyStatus::INVALID:
+    return "INVALID";
+  case VerifyStatus::MALFORMED:
+    return "MALFORMED";
+  }
+  return "UNKNOWN";
+}
+
+// ============================================================================
+// RECORD PARSING
+// ============================================================================
+
+bool parse_verify_record(const std::string &line,
+                         const std::vector<uint8_t> &default_public_key,
+                         VerifyItem &out, std::string &error) {
+  json record = json::parse(line, nullptr, /*allow_exceptions=*/false);
+  if (!record.is_object()) {
+    error = "not a JSON object";
+    return false;
+  }
+
+  auto string_field = [&](const char *key) -> const std::string * {
+    auto it = record.find(key);
+    if (it == record.end() || !it->is_string())
+      return nullptr;
+    return it->get_ptr<const std::string *>();
+  };
+
+  // Signature: /heartbeat and /sign use "signature", /migrate the last will
+  const std::string *sig = string_field("signature");
+  if (!sig)
+    sig = string_field("last_will_signature");
+  if (!sig || !base64_decode(*sig, out.signature) ||
+      out.signature.size() != 64) {
+    error = "missing or malformed signature";
+    return false;
+  }
+
+  if (const std::string *key = string_field("public_key")) {
+    out.public_key = hex_decode(*key);
+  } else {
+    out.public_key = default_public_key;
+  }
+  if (out.public_key.empty()) {
+    error = "missing public_key";
+    return false;
+  }
+
+  // Heartbeats and transactions are signed as sequence || payload
+  std::vector<uint8_t> message;
+  auto sequence = record.find("sequence");
+  if (sequence != record.end()) {
+    // A decimal string on the wire (may exceed 2^53), or a plain number
+    uint64_t seq = 0;
+    bool ok = sequence->is_number_unsigned();
+    if (ok) {
+      seq = sequence->get<uint64_t>();
+    } else if (sequence->is_string()) {
+      const auto &text = sequence->get_ref<const std::string &>();
+      auto [end, ec] =
+          std::from_chars(text.data(), text.data() + text.size(), seq);
+      ok = ec == std::errc() && end == text.data() + text.size() &&
+           !text.empty();
+    }
+    if (!ok) {
+      error = "malformed sequence";
+      return false;
+    }
+    for (int i = 0; i < 8; i++)
+      message.push_back(static_cast<uint8_t>(seq >> (56 - 8 * i)));
+  }
+
+  if (const std::string *payload = string_field("payload")) {
+    message.insert(message.end(), payload->begin(), payload->end());
+    SHA256(message.data(), message.size(), out.digest.data());
+  } else if (const std::string *payload_b64 = string_field("payload_b64")) {
+    std::vector<uint8_t> bytes;
+    if (!base64_decode(*payload_b64, bytes)) {
+      error = "malformed payload_b64";
+      return false;
+    }
+    message.insert(message.end(), bytes.begin(), bytes.end());
+    SHA256(message.data(), message.size(), out.digest.data());
+  } else if (const std::string *digest = string_field("digest")) {
+    auto bytes = hex_decode(*digest);
+    if (bytes.size() != out.digest.size()) {
+      error = "digest must be 32 bytes of hex";
+      return false;
+    }
+    std::copy(bytes.begin(), bytes.end(), out.digest.begin());
+  } else {
+    error = "record has no payload, payload_b64 or digest";
+    return false;
+  }
+
+  return true;
+}
+
+// ============================================================================
+// BATCH VERIFIER
+// ============================================================================
+
+struct BatchVerifier::Impl {
+  EC_GROUP *group = nullptr;
+  const BIGNUM *order = nullptr;
+  BN_CTX *ctx = nullptr;
+
+  // Last decoded public key (archives are usually one key per sentinel)
+  std::vector<uint8_t> cached_key;
+  EC_POINT *cached_point = nullptr;
+
+  Impl() {
+    group = EC_GROUP_new_by_curve_name(NID_X9_62_prime256v1);
+    order = EC_GROUP_get0_order(group);
+    ctx = BN_CTX_new();
+    cached_point = EC_POINT_new(group);
+  }
+
+  ~Impl() {
+    EC_POINT_free(cached_point);
+    BN_CTX_free(ctx);
+    EC_GROUP_free(group);
+  }
+
+  const EC_POINT *decode_key(const std::vector<uint8_t> &key) {
+    if (key == cached_key)
+      return cached_point;
+    if (!EC_POINT_oct2point(group, cached_point, key.data(), key.size(),
+                            ctx)) {
+      cached_key.clear();
+      return nullptr;
+    }
+    cached_key = key;
+    return cached_point;
+  }
+
+  bool in_scalar_range(const BIGNUM *v) const {
+    return !BN_is_zero(v) && !BN_is_negative(v) && BN_cmp(v, order) < 0;
+  }
+};
+
+BatchVerifier::BatchVerifier() : m_impl(std::make_unique<Impl>()) {}
+
+BatchVerifier::~BatchVerifier() = default;
+
+std::vector<VerifyStatus>
+BatchVerifier::verify(const std::vector<VerifyItem> &batch) {
+  Impl &im = *m_impl;
+  const size_t n = batch.size();
+  std::vector<VerifyStatus> results(n, VerifyStatus::MALFORMED);
+
+  BN_CTX_start(im.ctx);
+
+  // Decode r and s; only items with both in [1, n-1] take part
+  std::vector<BIGNUM *> r(n), s(n), prefix(n);
+  std::vector<size_t> live;
+  live.reserve(n);
+  for (size_t i = 0; i < n; i++) {
+    r[i] = BN_new();
+    s[i] = BN_new();
+    prefix[i] = BN_new();
+    const auto &sig = batch[i].signature;
+    if (sig.size() != 64)
+      continue;
+    BN_bin2bn(sig.data(), 32, r[i]);
+    BN_bin2bn(sig.data() + 32, 32, s[i]);
+    if (im.in_scalar_range(r[i]) && im.in_scalar_range(s[i]))
+      live.push_back(i);
+  }
+
+  // Montgomery's trick: prefix products, one inversion, then walk back.
+  // After the loop s[i] holds s_i^-1 mod n for every live item.
+  if (!live.empty()) {
+    BIGNUM *inv = BN_CTX_get(im.ctx);
+    BIGNUM *tmp = BN_CTX_get(im.ctx);
+
+    BN_copy(prefix[live[0]], s[live[0]]);
+    for (size_t k = 1; k < live.size(); k++) {
+      BN_mod_mul(prefix[live[k]], prefix[live[k - 1]], s[live[k]], im.order,
+                 im.ctx);
+    }
+
+    BN_mod_inverse(inv, prefix[live.back()], im.order, im.ctx);
+    for (size_t k = live.size() - 1; k > 0; k--) {
+      size_t i = live[k];
+      BN_mod_mul(tmp, inv, prefix[live[k - 1]], im.order, im.ctx); // s_i^-1
+      BN_mod_mul(inv, inv, s[i], im.order, im.ctx);
+      BN_copy(s[i], tmp);
+    }
+    BN_copy(s[live[0]], inv);
+  }
+
+  // Per-item double-scalar multiplication and x-coordinate check
+  BIGNUM *e = BN_CTX_get(im.ctx);
+  BIGNUM *u1 = BN_CTX_get(im.ctx);
+  BIGNUM *u2 = BN_CTX_get(im.ctx);
+  BIGNUM *x = BN_CTX_get(im.ctx);
+  EC_POINT *point = EC_POINT_new(im.group);
+
+  for (size_t i : live) {
+    const EC_POINT *q = im.decode_key(batch[i].public_key);
+    if (!q)
+      continue; // MALFORMED
+
+    const BIGNUM *w = s[i];
+    BN_bin2bn(batch[i].digest.data(), 32, e);
+    BN_mod_mul(u1, e, w, im.order, im.ctx);
+    BN_mod_mul(u2, r[i], w, im.order, im.ctx);
+
+    results[i] = VerifyStatus::INVALID;
+    if (!EC_POINT_mul(im.group, point, u1, q, u2, im.ctx) ||
+        EC_POINT_is_at_infinity(im.group, point)) {
+      continue;
+    }
+    if (!EC_POINT_get_affine_coordinates(im.group, point, x, nullptr,
+                                         im.ctx)) {
+      continue;
+    }
+    BN_nnmod(x, x, im.order, im.ctx);
+    if (BN_cmp(x, r[i]) == 0)
+      results[i] = VerifyStatus::VALID;
+  }
+
+  EC_POINT_free(point);
+  for (size_t i = 0; i < n; i++) {
+    BN_free(r[i]);
+    BN_free(s[i]);
+    BN_free(prefix[i]);
+  }
+  BN_CTX_end(im.ctx);
+
+  return results;
+}
+
+// ============================================================================
+// STREAMING AUDIT
+// ============================================================================
+
+namespace {
+
+struct Chunk {
+  uint64_t first_line = 0;
+  std::vector<std::string> lines;
+};
+
+/**
+ * Bounded single-producer / multi-consumer queue of line chunks
+ */
+class ChunkQueue {
+public:
+  explicit ChunkQueue(size_t capacity) : m_capacity(capacity) {}
+
+  void push(Chunk chunk) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_not_full.wait(lock, [&] { return m_chunks.size() < m_capacity; });
+    m_chunks.push_back(std::move(chunk));
+    m_not_empty.notify_one();
+  }
+
+  std::optional<Chunk> pop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_not_empty.wait(lock, [&] { return !m_chunks.empty() || m_closed; });
+    if (m_chunks.empty())
+      return std::nullopt;
+    Chunk chunk = std::move(m_chunks.front());
+    m_chunks.pop_front();
+    m_not_full.notify_one();
+    return chunk;
+  }
+
+  void close() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_closed = true;
+    m_not_empty.notify_all();
+  }
+
+private:
+  size_t m_capacity;
+  std::deque<Chunk> m_chunks;
+  bool m_closed = false;
+  std::mutex m_mutex;
+  std::condition_variable m_not_empty;
+  std::condition_variable m_not_full;
+};
+
+} // namespace
+
+VerifyStreamReport verify_stream(std::istream &in,
+                                 const VerifyStreamOptions &options,
+                                 const VerifyFailureCallback &on_failure) {
+  const auto start = std::chrono::steady_clock::now();
+
+  unsigned threads = options.threads;
+  if (threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  const size_t batch_size = std::max<size_t>(1, options.batch_size);
+
+  ChunkQueue queue(threads * 2);
+  std::mutex report_mutex;
+  VerifyStreamReport report;
+
+  auto worker = [&] {
+    BatchVerifier verifier;
+    std::vector<VerifyItem> items;
+    std::vector<uint64_t> item_lines;
+    VerifyStreamReport local;
+
+    while (auto chunk = queue.pop()) {
+      items.clear();
+      item_lines.clear();
+      items.reserve(chunk->lines.size());
+
+      std::vector<std::pair<uint64_t, std::string>> rejects;
+      for (size_t i = 0; i < chunk->lines.size(); i++) {
+        uint64_t line_no = chunk->first_line + i;
+        if (chunk->lines[i].find_first_not_of(" \t\r") == std::string::npos)
+          continue;
+
+        VerifyItem item;
+        std::string error;
+        if (parse_verify_record(chunk->lines[i], options.default_public_key,
+                                item, error)) {
+          items.push_back(std::move(item));
+          item_lines.push_back(line_no);
+        } else {
+          rejects.emplace_back(line_no, std::move(error));
+        }
+      }
+
+      auto results = verifier.verify(items);
+
+      uint64_t chunk_valid = 0;
+      local.total += items.size() + rejects.size();
+      local.malformed += rejects.size();
+      for (auto status : results) {
+        if (status == VerifyStatus::VALID)
+          chunk_valid++;
+        else if (status == VerifyStatus::INVALID)
+          local.invalid++;
+        else
+          local.malformed++;
+      }
+      local.valid += chunk_valid;
+
+      bool chunk_clean = rejects.empty() && chunk_valid == results.size();
+      if (on_failure && !chunk_clean) {
+        std::lock_guard<std::mutex> lock(report_mutex);
+        for (auto &[line_no, reason] : rejects)
+          on_failure(line_no, VerifyStatus::MALFORMED, reason);
+        for (size_t i = 0; i < results.size(); i++) {
+          if (results[i] == VerifyStatus::INVALID) {
+            on_failure(item_lines[i], results[i], "signature mismatch");
+          } else if (results[i] == VerifyStatus::MALFORMED) {
+            on_failure(item_lines[i], results[i],
+                       "invalid public key or r/s out of range");
+          }
+        }
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(report_mutex);
+    report.total += local.total;
+    report.valid += local.valid;
+    report.invalid += local.invalid;
+    report.malformed += local.malformed;
+  };
+
+  std::vector<std::thread> pool;
+  pool.reserve(threads);
+  for (unsigned i = 0; i < threads; i++)
+    pool.emplace_back(worker);
+
+  // Reader: slice the stream into line chunks for the workers
+  uint64_t line_no = 1;
+  Chunk chunk;
+  chunk.first_line = line_no;
+  std::string line;
+  while (std::getline(in, line)) {
+    chunk.lines.push_back(std::move(line));
+    line_no++;
+    if (chunk.lines.size() == batch_size) {
+      queue.push(std::move(chunk));
+      chunk = Chunk{};
+      chunk.first_line = line_no;
+    }
+  }
+  if (!chunk.lines.empty())
+    queue.push(std::move(chunk));
+
+  queue.close();
+  for (auto &t : pool)
+    t.join();
+
+  report.elapsed_seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+          .count();
+  return report;
+}
+
+} // namespace kytin
@@ -5,24 +5,73 @@
  * Endpoints:
  *   POST /heartbeat - Consume Resin, sign payload with TPM
  *   POST /sign      - Policy-checked transaction signing
+ *   POST /policy/evaluate - Would these transactions pass policy? (no signing)
  *   GET  /status    - Health check and status
+ *   GET  /ready     - 200 once signing is possible, 503 until then
+ *   POST /attest    - TPM quote covering a verifier nonce (GET: latest quote)
+ *   POST /verify-skill - Skill bundle signature check (cached by content)
+ *   GET  /events    - Server-Sent Events stream (heartbeat/sign/resin/...)
+ *   GET  /history   - Signature audit log, by time range
+ *   GET  /timeseries - Resin burn and SOL spend per second/minute/hour
+ *   POST /admin/reload - Re-read the config file (also on SIGHUP)
+ *   GET  /admin/trace  - Sampled request spans as Chrome trace JSON
+ *
+ * Signals: SIGHUP reloads the config, SIGTERM/SIGINT drain in-flight
+ * requests and exit, SIGUSR2 hands the listening socket and state to a
+ * freshly started copy of the binary (see kytin_handoff.hpp).
  *
  * State-Locked Protocol™ (Patent Pending)
  * Copyright (c) 2026 Kytin Protocol
  */
 
 #include "kytin.hpp"
-#include "kytin_tpm.hpp"
+#include "kytin_arena.hpp"
+#include "kytin_attest.hpp"
+#include "kytin_capture.hpp"
+#include "kytin_core.hpp"
+#include "kytin_handoff.hpp"
+#include "kytin_log.hpp"
+#include "kytin_pipeline.hpp"
+#include "kytin_ratelimit.hpp"
+#include "kytin_resin_sync.hpp"
+#include "kytin_scheduler.hpp"
+#include "kytin_sha256.hpp"
+#include "kytin_skill.hpp"
+#include "kytin_trace.hpp"
 
 #include <httplib.h>
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
 #include <atomic>
-#include <chrono>
+#include <cctype>
+#include <cerrno>
+#include <cmath>
 #include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
 #include <iostream>
+#include <memory>
 #include <mutex>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char **environ;
+#endif
 
 using json = nlohmann::json;
 
@@ -32,82 +81,245 @@ namespace kytin {
 // GLOBAL STATE
 // ============================================================================
 
-// Initial Resin balance: 22,000 credits (10 years of ECO heartbeats)
-static ResinTank g_resin_tank = {.balance = 22000,
-                                 .lifetime_burned = 0,
-                                 .daily_limit = 1000,
-                                 .daily_consumed = 0,
-                                 .last_reset =
-                                     std::chrono::system_clock::now()};
+// Resin, policy, TPM and Soul Transfer state live in the core, g_core
+// (kytin_pipeline.cpp, with the signing endpoints); this file is the rest
+// of the HTTP front end.
+static std::atomic<bool> g_running{true};    // false once SIGTERM arrives
+static std::atomic<bool> g_handing_off{false}; // New process is READY
 
-// Daily spending limit in SOL (hardcoded for now)
-static constexpr double DAILY_LIMIT_SOL = 10.0;
-static double g_daily_spent_sol = 0.0;
-static std::mutex g_state_mutex;
+// Heartbeats for the agents listed in the config's "heartbeat" section
+static HeartbeatScheduler g_scheduler(g_core);
 
-static TPMInterface g_tpm;
-static std::atomic<bool> g_running{true};
+// Each SSE subscriber occupies one HTTP worker thread for its lifetime, so
+// cap them well below the pool size to keep signers from being starved
+static constexpr int MAX_EVENT_SUBSCRIBERS = 4;
+static std::atomic<int> g_event_subscribers{0};
 
-// Soul Transfer: When true, this Sentinel is "dead" and cannot sign
-static std::atomic<bool> g_is_dead{false};
-static std::string g_death_signature; // Last Will signature
-static std::string g_child_key;       // Successor's public key
+// Traffic capture (--capture <file>): arrival time of the request this
+// worker thread is currently serving
+static TraceWriter g_capture;
+static thread_local uint64_t t_request_arrival_us = 0;
 
 // ============================================================================
-// CONFIGURATION
+// SOLANA RPC
 // ============================================================================
 
-static constexpr const char *LISTEN_HOST = "127.0.0.1";
-static constexpr int LISTEN_PORT = 18789;
-static constexpr const char *CLAWHUB_REGISTRY = "https://clawhub.kytin.io";
+/**
+ * JSON-RPC transport for BurnSync: POST `body` to the configured
+ * `solana_rpc` URL ("https://host[:port][/path]" or "http://...")
+ */
+static bool solana_rpc_post(const std::string &url, const std::string &body,
+                            std::string &response, std::string &error) {
+  size_t scheme_end = url.find("://");
+  size_t path_start =
+      url.find('/', scheme_end == std::string::npos ? 0 : scheme_end + 3);
+  std::string origin = url.substr(0, path_start);
+  std::string path =
+      path_start == std::string::npos ? "/" : url.substr(path_start);
+
+  httplib::Client client(origin);
+  if (!client.is_valid()) {
+    error = "unsupported RPC URL " + url +
+            " (https needs a build with OpenSSL)";
+    return false;
+  }
+  client.set_connection_timeout(5);
+  client.set_read_timeout(30);
+
+  auto res = client.Post(path, body, "application/json");
+  if (!res) {
+    error = "no response from " + origin;
+    return false;
+  }
+  if (res->status != 200) {
+    error = origin + " returned HTTP " + std::to_string(res->status);
+    return false;
+  }
+  response = res->body;
+  return true;
+}
+
+// Credits on-chain RESIN burns (config "burn_sync") to the tank
+static BurnSync g_burn_sync(g_core, solana_rpc_post);
+
+// One TPM quote per batch of verifier nonces (config "attest")
+static Attestor g_attestor(g_core);
+
+#ifdef KYTIN_SKILL_VERIFY
+// Skill signature verdicts, cached by content; sized from the config at
+// startup (trusted keys follow reloads)
+static std::unique_ptr<SkillVerifier> g_skill_verifier;
+#endif
+
+// Per-client buckets on the signing endpoints; sized from the config at
+// startup (rates follow reloads)
+static std::unique_ptr<RateLimiter> g_rate_limiter;
 
 // ============================================================================
-// HEARTBEAT MODES
+// RATE LIMITING
 // ============================================================================
 
-enum class HeartbeatMode {
-  ECO,  // 1 Resin per 4 hours
-  TURBO // 240 Resin per 4 hours (1 per minute)
-};
+/**
+ * Take a token from the caller's bucket before a signing endpoint runs and
+ * answer 429 if it is empty. The client is the socket peer, or the
+ * configured key header (API key or skill ID) when the peer is trusted to
+ * set it.
+ * @return true if a response was written
+ */
+static bool reply_rate_limited(const httplib::Request &req,
+                               httplib::Response &res) {
+  if (req.path != "/heartbeat" && req.path != "/sign" &&
+      req.path != "/migrate")
+    return false;
+
+  const auto policy = g_core.policy();
+  const auto &options = policy->rate_limit;
+  if (!options.enabled || !g_rate_limiter)
+    return false;
+
+  std::string key;
+  if (options.trusts_key_header(req.remote_addr))
+    key = req.get_header_value(options.key_header);
+  std::string_view client = key.empty() ? req.remote_addr : key;
+  auto decision = g_rate_limiter->acquire(client, options.limit_for(client));
+  if (decision.allowed)
+    return false;
+
+  // Answered before routing, so the body is never read and the connection
+  // cannot be reused (as for PAYLOAD_TOO_LARGE)
+  res.status = http::LIMIT_EXCEEDED;
+  res.set_header("Connection", "close");
+  res.set_header("Retry-After",
+                 std::to_string((decision.retry_after_ms + 999) / 1000));
+  res.set_content(json{{"error", "RATE_LIMITED"},
+                       {"message", "Too many signing requests from this "
+                                   "client. Slow down."},
+                       {"retry_after_ms", decision.retry_after_ms}}
+                      .dump(),
+                  "application/json");
+  return true;
+}
 
-static uint64_t get_resin_cost(HeartbeatMode mode) {
-  switch (mode) {
-  case HeartbeatMode::ECO:
-    return 1;
-  case HeartbeatMode::TURBO:
-    return 1; // Still 1 per call, but called more frequently
-  default:
-    return 1;
-  }
+// ============================================================================
+// REQUEST BODIES
+// ============================================================================
+
+// Body of the request this worker thread just served, for the capture
+// logger (content-reader routes leave req.body empty)
+static thread_local std::string t_captured_body;
+
+static uint32_t body_limit(const BodyLimits &limits, const std::string &path) {
+  if (path == "/heartbeat")
+    return limits.heartbeat;
+  if (path == "/sign")
+    return limits.sign;
+  if (path == "/migrate")
+    return limits.migrate;
+  if (path == "/attest")
+    return limits.attest;
+  if (path == "/verify-skill")
+    return limits.verify_skill;
+  if (path == "/policy/evaluate")
+    return limits.evaluate;
+  return limits.other;
 }
 
-static HeartbeatMode parse_heartbeat_mode(const std::string &mode_str) {
-  if (mode_str == "TURBO")
-    return HeartbeatMode::TURBO;
-  return HeartbeatMode::ECO; // Default
+static void reply_payload_too_large(httplib::Response &res, uint32_t limit) {
+  // The rest of the body is never read, so the connection cannot be reused
+  res.status = http::PAYLOAD_TOO_LARGE;
+  res.set_header("Connection", "close");
+  res.set_content(json{{"error", "PAYLOAD_TOO_LARGE"},
+                       {"message", "Request body exceeds this endpoint's "
+                                   "limit."},
+                       {"limit_bytes", limit}}
+                      .dump(),
+                  "application/json");
 }
 
-// ============================================================================
-// DEATH CHECK HELPER
-// ============================================================================
+/**
+ * Reject a POST whose Content-Length is over its endpoint's limit, from the
+ * headers alone (pre-routing and Expect: 100-continue). Chunked bodies are
+ * checked as they stream in instead.
+ * @return true if a response was written
+ */
+static bool reject_oversized_body(const httplib::Request &req,
+                                  httplib::Response &res) {
+  if (req.method != "POST" || !req.has_header("Content-Length"))
+    return false;
+  const auto policy = g_core.policy();
+  const uint32_t limit = body_limit(policy->body_limits, req.path);
+  const std::string declared = req.get_header_value("Content-Length");
+  if (declared.size() < 20 &&
+      std::strtoull(declared.c_str(), nullptr, 10) <= limit)
+    return false;
+  reply_payload_too_large(res, limit);
+  return true;
+}
 
 /**
- * Check if this Sentinel is dead and return 410 GONE if so
+ * Adapt a body handler to a content-reader route. The body is reserved
+ * once from Content-Length, fed to SHA-256 as each chunk arrives, and
+ * abandoned as soon as it exceeds the endpoint's limit or outlasts
+ * body_limits.timeout_ms (slow-drip uploads). The body and everything the
+ * handler builds in the arena are released together when it returns.
  */
-bool check_if_dead(httplib::Response &res) {
-  if (g_is_dead.load()) {
-    res.status = 410; // Gone
-    res.set_content(
-        json{{"error", "AGENT_DEAD"},
-             {"message",
-              "This Sentinel has executed Soul Transfer. Authority migrated."},
-             {"child_key", g_child_key},
-             {"last_will_signature", g_death_signature}}
-            .dump(),
-        "application/json");
-    return true;
-  }
-  return false;
+static httplib::Server::HandlerWithContentReader streamed(BodyHandler handler) {
+  return [handler](const httplib::Request &req, httplib::Response &res,
+                   const httplib::ContentReader &reader) {
+    RequestArena::Scope arena;
+    const auto policy = g_core.policy();
+    const uint32_t limit = body_limit(policy->body_limits, req.path);
+    const auto deadline =
+        std::chrono::steady_clock::now() +
+        std::chrono::milliseconds(policy->body_limits.timeout_ms);
+
+    RequestBody body;
+    if (req.has_header("Content-Length")) {
+      // Already checked against the limit before routing
+      body.data.reserve(std::min<uint64_t>(
+          limit, std::strtoull(req.get_header_value("Content-Length").c_str(),
+                               nullptr, 10)));
+    }
+
+    Sha256 hash;
+    bool too_large = false;
+    bool too_slow = false;
+    bool received = reader([&](const char *data, size_t len) {
+      if (body.data.size() + len > limit) {
+        too_large = true;
+        return false;
+      }
+      if (std::chrono::steady_clock::now() > deadline) {
+        too_slow = true;
+        return false;
+      }
+      hash.update(data, len);
+      body.data.append(data, len);
+      return true;
+    });
+
+    if (too_large) {
+      reply_payload_too_large(res, limit);
+      return;
+    }
+    if (too_slow || !received) {
+      res.status = too_slow ? http::REQUEST_TIMEOUT : http::BAD_REQUEST;
+      res.set_header("Connection", "close");
+      res.set_content(json{{"error", too_slow ? "BODY_TIMEOUT" : "BAD_BODY"},
+                           {"message", too_slow ? "Request body arrived too "
+                                                  "slowly."
+                                                : "Request body could not be "
+                                                  "read."}}
+                          .dump(),
+                      "application/json");
+      return;
+    }
+
+    body.sha256 = hash.finish();
+    handler(req, res, body);
+    if (g_capture.is_open())
+      t_captured_body.assign(body.data.data(), body.data.size());
+  };
 }
 
 // ============================================================================
@@ -115,402 +327,1199 @@ bool check_if_dead(httplib::Response &res) {
 // ============================================================================
 
 /**
- * POST /heartbeat
- * Input: { "mode": "ECO" | "TURBO" }
- *
- * The core "proof of life" endpoint. Each heartbeat:
- * 1. Checks Resin balance
- * 2. Signs the payload with TPM key
- * 3. Deducts Resin based on mode
- *
- * Returns 402 Payment Required if tank is empty.
- * Returns 410 Gone if Soul Transfer has occurred.
+ * One candidate: a bare amount, or a /sign request body ("tx" is accepted
+ * but not needed, as policy only looks at the amount). Amounts /sign would
+ * refuse are left to the core, which judges them INVALID_ARGUMENT.
  */
-void handle_heartbeat(const httplib::Request &req, httplib::Response &res) {
-  std::lock_guard<std::mutex> lock(g_state_mutex);
+static bool parse_candidate(const json &item, double &amount_sol) {
+  if (item.is_number()) {
+    amount_sol = item.get<double>();
+    return true;
+  }
+  if (!item.is_object())
+    return false;
+  auto amount = item.find("amount");
+  auto tx = item.find("tx");
+  if ((amount != item.end() && !amount->is_number()) ||
+      (tx != item.end() && !tx->is_string()))
+    return false;
+  amount_sol = amount != item.end() ? amount->get<double>() : 0.0;
+  return true;
+}
 
-  // Check if dead (Soul Transfer executed)
-  if (check_if_dead(res))
-    return;
+/**
+ * POST /policy/evaluate
+ * Input: { "items": [ 1.5, { "tx": "base64_transaction", "amount": 2 } ],
+ *          "cumulative": false }
+ *
+ * What-if check for planners: would /sign accept each candidate right now?
+ * All items are judged against one snapshot of the daily limit and spend;
+ * with "cumulative", in order, as if each allowed item were signed before
+ * the next. Nothing is signed and no accounting changes. Always 200 with
+ * per-item results once the request parses.
+ */
+void handle_policy_evaluate(const httplib::Request &req,
+                            httplib::Response &res, const RequestBody &body) {
+  KYTIN_TRACE_REQUEST("POST /policy/evaluate");
 
-  // Parse request body
-  json request_json;
-  HeartbeatMode mode = HeartbeatMode::ECO;
+  constexpr size_t MAX_BATCH = 16384;
+  std::vector<double> amounts;
+  std::vector<bool> parsed;
+  bool cumulative = false;
 
   try {
-    if (!req.body.empty()) {
-      request_json = json::parse(req.body);
-      if (request_json.contains("mode")) {
-        mode = parse_heartbeat_mode(request_json["mode"].get<std::string>());
-      }
+    KYTIN_TRACE_SPAN("parse");
+    json request_json = json::parse(body.data);
+    auto items = request_json.find("items");
+    if (items == request_json.end() || !items->is_array() ||
+        items->size() > MAX_BATCH) {
+      res.status = http::BAD_REQUEST;
+      res.set_content(json{{"error", "INVALID_REQUEST"},
+                           {"message", "items must be an array of at most " +
+                                           std::to_string(MAX_BATCH)}}
+                          .dump(),
+                      "application/json");
+      return;
     }
+    cumulative = request_json.value("cumulative", false);
+
+    amounts.resize(items->size());
+    parsed.resize(items->size());
+    for (size_t i = 0; i < items->size(); i++)
+      parsed[i] = parse_candidate((*items)[i], amounts[i]);
   } catch (const json::exception &e) {
-    res.status = 400;
-    res.set_content(
-        json{{"error", "INVALID_JSON"}, {"message", e.what()}}.dump(),
-        "application/json");
+    reply_invalid_json(res, e);
     return;
   }
 
-  uint64_t resin_cost = get_resin_cost(mode);
+  // Malformed items are left out, so they take no allowance in cumulative
+  // mode
+  std::vector<double> valid;
+  valid.reserve(amounts.size());
+  for (size_t i = 0; i < amounts.size(); i++)
+    if (parsed[i])
+      valid.push_back(amounts[i]);
+
+  SentinelCore::EvaluateResult result;
+  {
+    KYTIN_TRACE_SPAN("core.evaluate");
+    result = g_core.evaluate(valid, cumulative);
+  }
+
+  KYTIN_TRACE_SPAN("serialize");
+  json out = json::array();
+  size_t allowed = 0;
+  for (size_t i = 0, next = 0; i < amounts.size(); i++) {
+    if (!parsed[i]) {
+      out.push_back({{"allowed", false}, {"reason", "INVALID_REQUEST"}});
+      continue;
+    }
+    const auto &item = result.items[next++];
+    if (item.status == SentinelCore::Status::INVALID_ARGUMENT) {
+      out.push_back({{"allowed", false}, {"reason", "INVALID_REQUEST"}});
+    } else if (item.status == SentinelCore::Status::OK) {
+      allowed++;
+      out.push_back({{"allowed", true}, {"remaining_sol", item.remaining_sol}});
+    } else {
+      out.push_back({{"allowed", false},
+                     {"reason", core_status_name(item.status)},
+                     {"remaining_sol", item.remaining_sol}});
+    }
+  }
+
+  res.status = 200;
+  res.set_content(json{{"results", std::move(out)},
+                       {"allowed", allowed},
+                       {"total", amounts.size()},
+                       {"cumulative", cumulative},
+                       {"daily_limit_sol", result.daily_limit_sol},
+                       {"daily_spent_sol", result.daily_spent_sol},
+                       {"policy_generation", result.policy_generation}}
+                      .dump(),
+                  "application/json");
+}
+
+/**
+ * GET /status
+ *
+ * Health check and status endpoint.
+ */
+void handle_status(const httplib::Request &req, httplib::Response &res) {
+  const auto snap = g_core.snapshot();
+  const auto &policy = snap.policy;
+  const auto &hw_info = snap.hardware;
+  const auto schedule = g_scheduler.stats();
+  const auto burns = g_burn_sync.stats();
+  const auto attest = g_attestor.stats();
+  const auto sequence = g_core.sequence_stats();
+  const auto arena = RequestArena::stats();
+  const auto farm = g_core.farm().stats();
+#ifdef KYTIN_SKILL_VERIFY
+  const auto skills = g_skill_verifier->stats();
+#else
+  const SkillVerifier::Stats skills;
+#endif
+
+  const uint64_t resin_daily_remaining =
+      policy->resin_daily_limit > snap.resin.daily_consumed
+          ? policy->resin_daily_limit - snap.resin.daily_consumed
+          : 0;
+
+  // Signing farm, device 0 first (the identity TPM above)
+  json devices = json::array();
+  for (const auto &device : farm)
+    devices.push_back({{"tcti", device.tcti},
+                       {"hardware_id", device.hardware_id},
+                       {"public_key", base64_encode(device.public_key)},
+                       {"up", device.up},
+                       {"in_flight", device.in_flight},
+                       {"signs", device.signs},
+                       {"failures", device.failures},
+                       {"downs", device.downs},
+                       {"latency_ms", device.latency_ms}});
+
+  res.status = 200;
+  set_reply(req, res, json{{"protocol", "kytin"},
+                           {"version", "1.0.0"},
+                           {"ready", g_core.is_ready()},
+                           {"tpm",
+                            {{"available", snap.tpm_available},
+                             {"mock_mode", hw_info.is_mock},
+                             {"hardware_id", hw_info.hardware_id},
+                             {"manufacturer", hw_info.manufacturer},
+                             {"firmware", hw_info.firmware_version},
+                             {"devices", std::move(devices)}}},
+                           {"resin",
+                            {{"balance", snap.resin.balance},
+                             {"lifetime_burned", snap.resin.lifetime_burned},
+                             {"daily_limit", policy->resin_daily_limit},
+                             {"daily_remaining", resin_daily_remaining}}},
+                           {"policy",
+                            {{"daily_limit_sol", policy->daily_limit_sol},
+                             {"daily_spent_sol", snap.daily_spent_sol},
+                             {"generation", policy->generation}}},
+                           {"burn_sync",
+                            {{"enabled", burns.enabled},
+                             {"last_signature", burns.last_signature},
+                             {"last_slot", burns.last_slot},
+                             {"burns", burns.burns},
+                             {"credited_resin", burns.credited_resin},
+                             {"rpc_requests", burns.rpc_requests},
+                             {"rpc_errors", burns.rpc_errors},
+                             {"last_sync", burns.last_sync_unix}}},
+                           {"attest",
+                            {{"quotes", attest.quotes},
+                             {"nonces", attest.nonces},
+                             {"cache_hits", attest.cache_hits},
+                             {"failures", attest.failures},
+                             {"largest_batch", attest.largest_batch}}},
+                           {"sequence",
+                            {{"nv_index", policy->sequence.nv_index},
+                             {"issued", sequence.issued},
+                             {"blocks", sequence.blocks},
+                             {"failures", sequence.failures}}},
+                           {"arena",
+                            {{"requests", arena.requests},
+                             {"allocations", arena.allocations},
+                             {"bytes", arena.bytes},
+                             {"heap_chunks", arena.heap_chunks},
+                             {"peak_bytes", arena.peak_bytes}}},
+                           {"skills",
+                            {{"cache_hits", skills.hits},
+                             {"cache_misses", skills.misses},
+                             {"evictions", skills.evictions},
+                             {"capacity", skills.capacity}}},
+                           {"rate_limit",
+                            {{"enabled", policy->rate_limit.enabled},
+                             {"rejected", g_rate_limiter
+                                              ? g_rate_limiter->rejected()
+                                              : 0}}},
+                           {"scheduler",
+                            {{"agents", schedule.agents},
+                             {"fired", schedule.fired},
+                             {"failed", schedule.failed},
+                             {"sink_errors", schedule.sink_errors}}},
+                           {"clawhub", policy->config.clawhub_registry}});
+}
 
-  // Check Resin balance
-  if (g_resin_tank.balance < resin_cost) {
-    res.status = 402; // Payment Required
-    res.set_content(json{{"error", "RESIN_DEPLETED"},
-                         {"message", "Resin tank empty. Burn $KYT to refill."},
-                         {"clawhub", std::string(CLAWHUB_REGISTRY) + "/refill"}}
+/**
+ * GET /ready
+ *
+ * Readiness probe, distinct from /status: 200 only once the TPM is
+ * initialized and the Sentinel can sign. The port accepts connections
+ * before that, so orchestrators should route traffic on this endpoint.
+ */
+void handle_ready(const httplib::Request &req, httplib::Response &res) {
+  const char *reason = nullptr;
+  if (!g_running || g_handing_off)
+    reason = "draining";
+  else if (!g_core.is_ready())
+    reason = "initializing";
+  else if (g_core.is_dead())
+    reason = "dead";
+  else if (!g_core.farm().is_available())
+    reason = "tpm_unavailable";
+
+  json body = {{"ready", reason == nullptr}};
+  if (reason)
+    body["reason"] = reason;
+  else
+    body["startup_ms"] = g_core.startup_ms();
+
+  res.status = reason ? 503 : 200;
+  res.set_content(body.dump(), "application/json");
+}
+
+/**
+ * Decode a hex nonce; empty on bad input
+ */
+static std::vector<uint8_t> decode_hex(const std::string &hex) {
+  auto nibble = [](char c) {
+    if (c >= '0' && c <= '9')
+      return c - '0';
+    if (c >= 'a' && c <= 'f')
+      return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+      return c - 'A' + 10;
+    return -1;
+  };
+  std::vector<uint8_t> out;
+  if (hex.size() % 2)
+    return out;
+  for (size_t i = 0; i < hex.size(); i += 2) {
+    int hi = nibble(hex[i]), lo = nibble(hex[i + 1]);
+    if (hi < 0 || lo < 0)
+      return {};
+    out.push_back(static_cast<uint8_t>(hi << 4 | lo));
+  }
+  return out;
+}
+
+static json evidence_json(const Attestor::Evidence &evidence) {
+  const auto &quote = evidence.quote;
+  return {{"attest", base64_encode(quote.attest)},
+          {"signature", base64_encode(quote.signature.data)},
+          {"algorithm", quote.signature.algorithm},
+          {"pcr_selection", quote.pcr_selection},
+          {"public_key", base64_encode(g_core.tpm().get_public_key())},
+          {"hardware_id", g_core.tpm().get_hardware_id()},
+          {"mock", g_core.tpm().is_mock_mode()},
+          {"root", digest_hex(evidence.root)},
+          {"quoted_at", evidence.quoted_unix}};
+}
+
+/**
+ * POST /attest
+ * Input: { "nonce": "<hex, 8-64 bytes>" }
+ *
+ * TPM quote whose qualifying data is the Merkle root of every nonce
+ * received in the same batch window, plus this nonce's inclusion path:
+ * fold SHA-256(0x00 || nonce) with each step ("left" siblings are hashed
+ * first, as SHA-256(0x01 || left || right)) to reproduce "root".
+ *
+ * GET /attest
+ *
+ * The most recent quote while it is within attest.freshness_s (no
+ * inclusion path; freshness comes from the quote's clock).
+ */
+void handle_attest(const httplib::Request &req, httplib::Response &res,
+                   const RequestBody &body) {
+  KYTIN_TRACE_REQUEST("/attest");
+
+  if (!g_core.is_ready()) {
+    res.status = 503;
+    res.set_content(json{{"error", "NOT_READY"},
+                         {"message", "TPM is still initializing."}}
                         .dump(),
                     "application/json");
     return;
   }
 
-  // Check TPM availability
-  if (!g_tpm.is_available()) {
-    res.status = 403;
-    res.set_content(json{{"error", "TPM_UNAVAILABLE"},
-                         {"message", "Hardware root of trust not initialized."}}
-                        .dump(),
+  std::string error;
+  if (req.method == "GET") {
+    auto evidence = g_attestor.latest(&error);
+    if (!evidence) {
+      res.status = 500;
+      res.set_content(
+          json{{"error", "QUOTE_FAILED"}, {"message", error}}.dump(),
+          "application/json");
+      return;
+    }
+    res.status = 200;
+    res.set_content(json{{"quote", evidence_json(*evidence)}}.dump(),
                     "application/json");
     return;
   }
 
-  // Sign the heartbeat payload
-  std::vector<uint8_t> payload(req.body.begin(), req.body.end());
-  auto signature = g_tpm.sign(payload);
-
-  if (!signature) {
-    res.status = 500;
-    res.set_content(json{{"error", "SIGNING_FAILED"},
-                         {"message", "TPM signing operation failed."}}
+  std::vector<uint8_t> nonce;
+  try {
+    nonce = decode_hex(json::parse(body.data).value("nonce", ""));
+  } catch (const json::exception &) {
+  }
+  if (nonce.size() < 8 || nonce.size() > 64) {
+    res.status = http::BAD_REQUEST;
+    res.set_content(json{{"error", "INVALID_NONCE"},
+                         {"message", "nonce must be 8-64 bytes of hex"}}
                         .dump(),
                     "application/json");
     return;
   }
 
-  // Deduct Resin
-  g_resin_tank.balance -= resin_cost;
-  g_resin_tank.lifetime_burned += resin_cost;
-  g_resin_tank.daily_consumed += resin_cost;
-
-  // Build signature string (base64)
-  std::string sig_b64;
-  {
-    static const char *b64 =
-        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-    int val = 0, valb = -6;
-    for (uint8_t c : signature->data) {
-      val = (val << 8) + c;
-      valb += 8;
-      while (valb >= 0) {
-        sig_b64.push_back(b64[(val >> valb) & 0x3F]);
-        valb -= 6;
-      }
-    }
-    if (valb > -6)
-      sig_b64.push_back(b64[((val << 8) >> (valb + 8)) & 0x3F]);
-    while (sig_b64.size() % 4)
-      sig_b64.push_back('=');
+  auto proof = g_attestor.attest(nonce, &error);
+  if (!proof) {
+    res.status = 500;
+    res.set_content(json{{"error", "QUOTE_FAILED"}, {"message", error}}.dump(),
+                    "application/json");
+    return;
   }
 
-  // Success response
+  json path = json::array();
+  for (const auto &step : proof->path)
+    path.push_back({{step.sibling_left ? "left" : "right",
+                     digest_hex(step.sibling)}});
+
   res.status = 200;
-  res.set_content(json{{"status", "signed"},
-                       {"hardware_id", g_tpm.get_hardware_id()},
-                       {"signature", sig_b64},
-                       {"algorithm", signature->algorithm},
-                       {"resin_remaining", g_resin_tank.balance},
-                       {"mode", mode == HeartbeatMode::TURBO ? "TURBO" : "ECO"}}
+  res.set_content(json{{"quote", evidence_json(*proof->evidence)},
+                       {"merkle",
+                        {{"leaf", digest_hex(proof->leaf)},
+                         {"index", proof->index},
+                         {"batch_size", proof->batch_size},
+                         {"path", std::move(path)}}}}
                       .dump(),
                   "application/json");
 }
 
+// ============================================================================
+// SKILL VERIFICATION
+// ============================================================================
+
+#ifdef KYTIN_SKILL_VERIFY
+/**
+ * One bundle from a /verify-skill body: code, or a content hash of code
+ * verified earlier
+ */
+static bool parse_skill_check(const json &entry, SkillCheck &check) {
+  // No throwing: one malformed entry must not fail a whole directory
+  if (!entry.is_object())
+    return false;
+  auto string_field = [&](const char *key, std::string &out) {
+    auto it = entry.find(key);
+    if (it == entry.end())
+      return true;
+    if (!it->is_string())
+      return false;
+    out = it->get<std::string>();
+    return true;
+  };
+
+  if (!string_field("signature", check.signature) ||
+      !string_field("developer_key", check.developer_key))
+    return false;
+  if (entry.contains("code"))
+    return string_field("code", check.code);
+  std::string content_hash;
+  if (!string_field("content_hash", content_hash))
+    return false;
+  auto hash = decode_hex(content_hash);
+  if (hash.size() != check.content_hash.size())
+    return false;
+  std::copy(hash.begin(), hash.end(), check.content_hash.begin());
+  check.has_code = false;
+  return true;
+}
+
+static json skill_result_json(const SkillVerifier::Result &result) {
+  json out = {{"valid", result.verdict == SkillVerdict::VALID},
+              {"content_hash", digest_hex(result.content_hash)},
+              {"cached", result.cached}};
+  if (result.verdict != SkillVerdict::VALID) {
+    out["error"] = skill_verdict_name(result.verdict);
+    out["message"] = result.verdict == SkillVerdict::NOT_CACHED
+                         ? "Unknown content hash; resend with the code."
+                         : "Skill signature rejected.";
+  }
+  return out;
+}
+#endif
+
 /**
- * POST /sign
- * Input: { "tx": "base64_transaction", "amount": 1.5 }
+ * POST /verify-skill
+ * Input: { "code": "...", "signature": "<base64>", "developer_key": "..." }
+ *    or: { "content_hash": "<hex SHA-256 of code>", "signature", ... }
+ *    or: { "skills": [ <either form>, ... ] }      (whole skill directory)
  *
- * Policy-checked transaction signing for Solana.
- * Enforces daily limits and per-transaction caps.
- * Returns 410 Gone if Soul Transfer has occurred.
+ * Ed25519 check of a skill bundle against the trusted developer keys,
+ * answered from the verdict cache when the same bundle was seen before.
+ * A content_hash the cache does not know gets 404 NOT_CACHED: resend with
+ * the code. Single checks fail with 403 (untrusted or bad signature) or
+ * 400 (malformed); {"skills"} requests always return 200 with per-skill
+ * results.
  */
-void handle_sign(const httplib::Request &req, httplib::Response &res) {
-  std::lock_guard<std::mutex> lock(g_state_mutex);
+void handle_verify_skill(const httplib::Request &req, httplib::Response &res,
+                         const RequestBody &body) {
+#ifdef KYTIN_SKILL_VERIFY
+  KYTIN_TRACE_REQUEST("POST /verify-skill");
 
-  // Check if dead (Soul Transfer executed)
-  if (check_if_dead(res))
-    return;
+  constexpr size_t MAX_BATCH = 4096;
+  const auto policy = g_core.policy();
+  const auto &trusted = policy->skills.trusted_keys;
 
-  // Parse request
   json request_json;
-  std::string tx_data;
-  double amount_sol = 0.0;
-
   try {
-    request_json = json::parse(req.body);
-    tx_data = request_json.value("tx", "");
-    amount_sol = request_json.value("amount", 0.0);
-  } catch (const json::exception &e) {
-    res.status = 400;
-    res.set_content(
-        json{{"error", "INVALID_JSON"}, {"message", e.what()}}.dump(),
-        "application/json");
-    return;
-  }
+    KYTIN_TRACE_SPAN("parse");
+    request_json = json::parse(body.data);
+
+    if (request_json.contains("skills")) {
+      const auto &skills = request_json["skills"];
+      if (!skills.is_array() || skills.size() > MAX_BATCH) {
+        res.status = http::BAD_REQUEST;
+        res.set_content(json{{"error", "INVALID_REQUEST"},
+                             {"message", "skills must be an array of at most " +
+                                             std::to_string(MAX_BATCH)}}
+                            .dump(),
+                        "application/json");
+        return;
+      }
 
-  // Check daily limit
-  if (g_daily_spent_sol + amount_sol > DAILY_LIMIT_SOL) {
-    res.status = 403;
-    res.set_content(
-        json{{"error", "POLICY_VIOLATION"},
-             {"message", "Transaction would exceed daily spending limit."},
-             {"daily_limit_sol", DAILY_LIMIT_SOL},
-             {"daily_spent_sol", g_daily_spent_sol},
-             {"requested_sol", amount_sol}}
-            .dump(),
-        "application/json");
-    return;
+      std::vector<SkillCheck> checks(skills.size());
+      std::vector<bool> parsed(skills.size());
+      for (size_t i = 0; i < skills.size(); i++)
+        parsed[i] = parse_skill_check(skills[i], checks[i]);
+
+      auto results = g_skill_verifier->verify_each(std::move(checks), trusted);
+      json out = json::array();
+      size_t valid = 0;
+      for (size_t i = 0; i < results.size(); i++) {
+        if (!parsed[i]) {
+          out.push_back({{"valid", false}, {"error", "INVALID_REQUEST"}});
+          continue;
+        }
+        valid += results[i].verdict == SkillVerdict::VALID;
+        out.push_back(skill_result_json(results[i]));
+      }
+      res.status = 200;
+      res.set_content(json{{"results", std::move(out)},
+                           {"valid", valid},
+                           {"total", results.size()}}
+                          .dump(),
+                      "application/json");
+      return;
+    }
+  } catch (const json::exception &) {
+    request_json = nullptr;
   }
 
-  // Check TPM availability
-  if (!g_tpm.is_available()) {
-    res.status = 403;
-    res.set_content(json{{"error", "TPM_UNAVAILABLE"},
-                         {"message", "Hardware root of trust not initialized."}}
+  SkillCheck check;
+  if (!request_json.is_object() || !parse_skill_check(request_json, check)) {
+    res.status = http::BAD_REQUEST;
+    res.set_content(json{{"error", "INVALID_REQUEST"},
+                         {"message", "Expected code or content_hash, "
+                                     "signature and developer_key"}}
                         .dump(),
                     "application/json");
     return;
   }
 
-  // Sign the transaction
-  std::vector<uint8_t> payload(tx_data.begin(), tx_data.end());
-  auto signature = g_tpm.sign(payload);
+  auto result = g_skill_verifier->verify(std::move(check), trusted);
+  switch (result.verdict) {
+  case SkillVerdict::VALID:
+    res.status = 200;
+    break;
+  case SkillVerdict::NOT_CACHED:
+    res.status = 404;
+    break;
+  case SkillVerdict::UNTRUSTED_SOURCE:
+  case SkillVerdict::SIGNATURE_INVALID:
+    res.status = http::FORBIDDEN;
+    break;
+  default:
+    res.status = http::BAD_REQUEST;
+    break;
+  }
+  res.set_content(skill_result_json(result).dump(), "application/json");
+#else
+  res.status = 501;
+  res.set_content(json{{"error", "NOT_SUPPORTED"},
+                       {"message", "Sentinel built without OpenSSL; verify "
+                                   "skills in the bridge."}}
+                      .dump(),
+                  "application/json");
+#endif
+}
 
-  if (!signature) {
-    res.status = 500;
-    res.set_content(json{{"error", "SIGNING_FAILED"},
-                         {"message", "TPM signing operation failed."}}
+/**
+ * GET /events
+ * Header (optional): Last-Event-ID: <id>
+ *
+ * Server-Sent Events stream of heartbeat, sign, resin and soul_transfer
+ * events, replacing /status polling. Reconnecting clients resume after
+ * Last-Event-ID; if that is older than the retained backlog, an "overrun"
+ * event reports how many were missed (refetch /status in that case).
+ */
+void handle_events(const httplib::Request &req, httplib::Response &res) {
+  if (g_event_subscribers.fetch_add(1) >= MAX_EVENT_SUBSCRIBERS) {
+    g_event_subscribers.fetch_sub(1);
+    res.status = 503;
+    res.set_content(json{{"error", "TOO_MANY_SUBSCRIBERS"},
+                         {"message", "Event stream subscriber limit reached."}}
                         .dump(),
                     "application/json");
     return;
   }
 
-  // Update daily spent
-  g_daily_spent_sol += amount_sol;
-
-  // Build signature string (base64)
-  std::string sig_b64;
-  {
-    static const char *b64 =
-        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-    int val = 0, valb = -6;
-    for (uint8_t c : signature->data) {
-      val = (val << 8) + c;
-      valb += 8;
-      while (valb >= 0) {
-        sig_b64.push_back(b64[(val >> valb) & 0x3F]);
-        valb -= 6;
-      }
+  uint64_t cursor = g_core.events().last_id();
+  if (req.has_header("Last-Event-ID")) {
+    try {
+      cursor = std::stoull(req.get_header_value("Last-Event-ID"));
+    } catch (const std::exception &) {
+      // Malformed id: start from live events only
     }
-    if (valb > -6)
-      sig_b64.push_back(b64[((val << 8) >> (valb + 8)) & 0x3F]);
-    while (sig_b64.size() % 4)
-      sig_b64.push_back('=');
   }
 
-  // Success response
-  res.status = 200;
-  res.set_content(
-      json{{"signed", true},
-           {"signature", sig_b64},
-           {"algorithm", signature->algorithm},
-           {"amount_sol", amount_sol},
-           {"daily_remaining_sol", DAILY_LIMIT_SOL - g_daily_spent_sol}}
-          .dump(),
-      "application/json");
+  res.set_header("Cache-Control", "no-cache");
+  res.set_chunked_content_provider(
+      "text/event-stream",
+      [cursor, batch = std::vector<SentinelEvent>(),
+       idle_s = 0](size_t offset, httplib::DataSink &sink) mutable {
+        std::string out;
+        if (offset == 0)
+          out = "retry: 3000\n\n";
+
+        if (!g_running) {
+          sink.done();
+          return true;
+        }
+
+        // Wait in short slices so a quiet stream does not hold up a drain
+        if (!g_core.events().wait(cursor, std::chrono::seconds(1))) {
+          if (++idle_s < 15 && out.empty())
+            return true;
+          idle_s = 0;
+          out += ": keepalive\n\n";
+          return sink.write(out.data(), out.size());
+        }
+        idle_s = 0;
+
+        batch.clear();
+        auto read = g_core.events().read(cursor, batch, 64);
+        if (read.dropped) {
+          out += "event: overrun\ndata: {\"dropped\":" +
+                 std::to_string(read.dropped) + "}\n\n";
+        }
+        for (const auto &ev : batch) {
+          out += "id: " + std::to_string(ev.id) + "\nevent: " +
+                 event_type_name(ev.type) + "\ndata: " + ev.data + "\n\n";
+        }
+        cursor = read.next_cursor;
+        return sink.write(out.data(), out.size());
+      },
+      [](bool) { g_event_subscribers.fetch_sub(1); });
 }
 
 /**
- * POST /migrate
- * Input: { "child_key": "hex_pubkey", "auth_token": "..." }
- *
- * SOUL TRANSFER PROTOCOL - Death Certificate Signing
- * This is IRREVERSIBLE. After execution:
- * 1. Signs "MIGRATE_AUTHORITY_TO:<child_key>"
- * 2. Sets is_dead = true
- * 3. All future /sign and /heartbeat calls return 410 GONE
+ * Unix seconds (fractions allowed) as microseconds; throws on values that
+ * are not finite, negative, or beyond what microseconds can hold
+ */
+static uint64_t unix_us_param(const std::string &text) {
+  const double seconds = std::stod(text);
+  if (!(seconds >= 0.0 && seconds * 1e6 < 0x1p64))
+    throw std::out_of_range("timestamp out of range");
+  return static_cast<uint64_t>(seconds * 1e6);
+}
+
+/**
+ * GET /history?from=<unix s>&to=<unix s>&after_seq=<n>&limit=<n>
  *
- * Returns the "Last Will" signature for on-chain migration.
+ * Signatures recorded by the audit log, oldest first. Page through a large
+ * range by passing next_after_seq back as after_seq while truncated is true.
  */
-void handle_migrate(const httplib::Request &req, httplib::Response &res) {
-  std::lock_guard<std::mutex> lock(g_state_mutex);
-
-  // If already dead, return error
-  if (g_is_dead.load()) {
-    res.status = 410;
-    res.set_content(json{{"error", "ALREADY_DEAD"},
-                         {"message", "Soul Transfer already executed."},
-                         {"child_key", g_child_key},
-                         {"last_will_signature", g_death_signature}}
+void handle_history(const httplib::Request &req, httplib::Response &res) {
+  if (!g_core.is_ready()) {
+    reply_core_failure(SentinelCore::Status::NOT_READY, res);
+    return;
+  }
+
+  const AuditLog *audit = g_core.audit();
+  if (!audit) {
+    res.status = 404;
+    res.set_content(json{{"error", "AUDIT_DISABLED"},
+                         {"message", "No audit.dir configured."}}
                         .dump(),
                     "application/json");
     return;
   }
 
-  // Parse request
-  json request_json;
-  std::string child_key;
-  std::string auth_token;
-
+  AuditQuery query;
   try {
-    request_json = json::parse(req.body);
-    child_key = request_json.value("child_key", "");
-    auth_token = request_json.value("auth_token", "");
-  } catch (const json::exception &e) {
+    if (req.has_param("from"))
+      query.from_us = unix_us_param(req.get_param_value("from"));
+    if (req.has_param("to"))
+      query.to_us = unix_us_param(req.get_param_value("to"));
+    if (req.has_param("after_seq"))
+      query.after_seq = std::stoull(req.get_param_value("after_seq"));
+    if (req.has_param("limit"))
+      query.limit = std::stoul(req.get_param_value("limit"));
+  } catch (const std::exception &) {
     res.status = 400;
-    res.set_content(
-        json{{"error", "INVALID_JSON"}, {"message", e.what()}}.dump(),
-        "application/json");
+    res.set_content(json{{"error", "INVALID_QUERY"},
+                         {"message", "from/to must be Unix seconds >= 0; "
+                                     "after_seq/limit must be numbers"}}
+                        .dump(),
+                    "application/json");
     return;
   }
-
-  // Validate child_key
-  if (child_key.empty()) {
-    res.status = 400;
-    res.set_content(
-        json{{"error", "MISSING_CHILD_KEY"},
-             {"message", "child_key is required for Soul Transfer."}}
-            .dump(),
-        "application/json");
-    return;
+  query.limit = std::clamp<size_t>(query.limit, 1, 10000);
+
+  // Ask for one extra record to learn whether the range continues
+  const size_t limit = query.limit;
+  query.limit++;
+  auto records = audit->query(query);
+  const bool truncated = records.size() > limit;
+  if (truncated)
+    records.resize(limit);
+
+  json items = json::array();
+  for (const auto &r : records) {
+    Sha256::Digest digest;
+    std::memcpy(digest.data(), r.payload_sha256, digest.size());
+    items.push_back(
+        {{"seq", r.seq},
+         {"timestamp_us", r.timestamp_us},
+         {"kind", audit_kind_name(static_cast<AuditKind>(r.kind))},
+         {"mode", heartbeat_mode_name(static_cast<HeartbeatMode>(r.mode))},
+         {"resin_after", r.resin_after},
+         {"amount_sol", r.amount_sol},
+         {"payload_sha256", digest_hex(digest)},
+         {"signature",
+          base64_encode(std::vector<uint8_t>(
+              r.signature, r.signature + r.signature_len))},
+         {"detail", std::string(r.detail, strnlen(r.detail, sizeof(r.detail)))}});
   }
 
-  // Check TPM availability
-  if (!g_tpm.is_available()) {
-    res.status = 403;
-    res.set_content(json{{"error", "TPM_UNAVAILABLE"},
-                         {"message", "Hardware root of trust not initialized."}}
+  res.status = 200;
+  res.set_content(json{{"records", std::move(items)},
+                       {"truncated", truncated},
+                       {"next_after_seq",
+                        records.empty() ? query.after_seq : records.back().seq},
+                       {"last_seq", audit->last_seq()}}
+                      .dump(),
+                  "application/json");
+}
+
+/**
+ * GET /timeseries?resolution=second|minute|hour&points=<n>
+ *
+ * Resin burned and SOL spent per period, oldest first, with average rates
+ * over the last minute, hour and day, and projections at the last hour's
+ * rate. Without `resolution`, all three series are returned (60 seconds,
+ * 60 minutes and 24 hours unless `points` says otherwise).
+ */
+void handle_timeseries(const httplib::Request &req, httplib::Response &res) {
+  std::vector<Resolution> resolutions = {Resolution::SECOND,
+                                         Resolution::MINUTE, Resolution::HOUR};
+  size_t points = 0; // Per-resolution default
+  if (req.has_param("resolution")) {
+    auto resolution = parse_resolution(req.get_param_value("resolution"));
+    if (!resolution) {
+      res.status = 400;
+      res.set_content(json{{"error", "INVALID_QUERY"},
+                           {"message", "resolution must be second, minute "
+                                       "or hour"}}
+                          .dump(),
+                      "application/json");
+      return;
+    }
+    resolutions = {*resolution};
+  }
+  try {
+    if (req.has_param("points"))
+      points = std::stoul(req.get_param_value("points"));
+  } catch (const std::exception &) {
+    res.status = 400;
+    res.set_content(json{{"error", "INVALID_QUERY"},
+                         {"message", "points must be a number"}}
                         .dump(),
                     "application/json");
     return;
   }
 
-  // Construct migration payload
-  std::string migrate_payload = "MIGRATE_AUTHORITY_TO:" + child_key;
-  std::vector<uint8_t> payload(migrate_payload.begin(), migrate_payload.end());
+  const auto snap = g_core.snapshot();
+  const Timeseries &timeseries = g_core.timeseries();
+  const uint64_t now = static_cast<uint64_t>(std::time(nullptr));
+
+  json series = json::object();
+  for (Resolution resolution : resolutions) {
+    const size_t count =
+        points ? points : (resolution == Resolution::HOUR ? 24 : 60);
+    const Series s = timeseries.series(resolution, count, now);
+    json sol = json::array();
+    for (uint64_t lamports : s.lamports)
+      sol.push_back(static_cast<double>(lamports) / 1e9);
+    series[resolution_name(resolution)] = {{"width_s", s.width_s},
+                                           {"start", s.start},
+                                           {"resin", s.resin},
+                                           {"sol", std::move(sol)},
+                                           {"heartbeats", s.heartbeats},
+                                           {"signs", s.signs}};
+  }
+
+  const Rate rates[] = {timeseries.rate(Resolution::SECOND, 60, now),
+                        timeseries.rate(Resolution::MINUTE, 60, now),
+                        timeseries.rate(Resolution::HOUR, 24, now)};
+  const char *windows[] = {"last_minute", "last_hour", "last_day"};
+  json resin_per_hour = json::object();
+  json sol_per_hour = json::object();
+  for (int i = 0; i < 3; i++) {
+    resin_per_hour[windows[i]] = rates[i].resin_per_s * 3600.0;
+    sol_per_hour[windows[i]] = rates[i].sol_per_s * 3600.0;
+  }
+
+  // Projections at the last hour's average; null while nothing is burning
+  const Rate &hourly = rates[1];
+  json seconds_to_empty = nullptr;
+  if (hourly.resin_per_s > 0.0)
+    seconds_to_empty = snap.resin.balance / hourly.resin_per_s;
+  json seconds_to_limit = nullptr;
+  const double sol_left = snap.policy->daily_limit_sol - snap.daily_spent_sol;
+  if (hourly.sol_per_s > 0.0)
+    seconds_to_limit = std::max(0.0, sol_left) / hourly.sol_per_s;
 
-  // Sign the migration payload - THIS IS THE "LAST WILL"
-  auto signature = g_tpm.sign(payload);
+  res.status = 200;
+  set_reply(req, res,
+            json{{"now", now},
+                 {"resin",
+                  {{"balance", snap.resin.balance},
+                   {"per_hour", std::move(resin_per_hour)},
+                   {"seconds_to_empty", std::move(seconds_to_empty)}}},
+                 {"sol",
+                  {{"daily_spent", snap.daily_spent_sol},
+                   {"daily_limit", snap.policy->daily_limit_sol},
+                   {"per_hour", std::move(sol_per_hour)},
+                   {"seconds_to_limit", std::move(seconds_to_limit)}}},
+                 {"series", std::move(series)}});
+}
+
+// ============================================================================
+// CONFIG RELOAD
+// ============================================================================
 
-  if (!signature) {
+/**
+ * POST /admin/reload
+ *
+ * Re-read the config file and install it as a new policy snapshot.
+ * Requests already in flight finish on the snapshot they started with.
+ */
+void handle_reload(const httplib::Request &req, httplib::Response &res) {
+  std::string error;
+  if (!g_core.reload_policy(&error)) {
     res.status = 500;
-    res.set_content(json{{"error", "SIGNING_FAILED"},
-                         {"message", "TPM signing operation failed."}}
-                        .dump(),
-                    "application/json");
+    res.set_content(
+        json{{"error", "CONFIG_INVALID"}, {"message", error}}.dump(),
+        "application/json");
     return;
   }
 
-  // Build signature string (base64)
-  std::string sig_b64;
-  {
-    static const char *b64 =
-        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-    int val = 0, valb = -6;
-    for (uint8_t c : signature->data) {
-      val = (val << 8) + c;
-      valb += 8;
-      while (valb >= 0) {
-        sig_b64.push_back(b64[(val >> valb) & 0x3F]);
-        valb -= 6;
-      }
-    }
-    if (valb > -6)
-      sig_b64.push_back(b64[((val << 8) >> (valb + 8)) & 0x3F]);
-    while (sig_b64.size() % 4)
-      sig_b64.push_back('=');
-  }
-
-  // ***** CRITICAL: SET IS_DEAD FLAG *****
-  // This is IRREVERSIBLE - the Sentinel is now dead
-  g_is_dead.store(true);
-  g_death_signature = sig_b64;
-  g_child_key = child_key;
-
-  std::cout << "\n";
-  std::cout
-      << "╔══════════════════════════════════════════════════════════════╗\n";
-  std::cout
-      << "║  ⚰️  SOUL TRANSFER EXECUTED - THIS SENTINEL IS NOW DEAD  ⚰️  ║\n";
-  std::cout
-      << "╠══════════════════════════════════════════════════════════════╣\n";
-  std::cout << "║  Authority transferred to: " << child_key.substr(0, 32)
-            << "...  ║\n";
-  std::cout
-      << "║  All future signing requests will fail with 410 GONE        ║\n";
-  std::cout
-      << "╚══════════════════════════════════════════════════════════════╝\n";
-  std::cout << std::endl;
-
-  // Success response - the "Death Certificate"
+  auto policy = g_core.policy();
   res.status = 200;
-  res.set_content(
-      json{{"status", "soul_transferred"},
-           {"last_will_signature", sig_b64},
-           {"parent_pubkey", g_tpm.get_hardware_id()},
-           {"child_key", child_key},
-           {"payload", migrate_payload},
-           {"algorithm", signature->algorithm},
-           {"message", "This Sentinel is now dead. Broadcast "
-                       "last_will_signature to Solana to complete migration."}}
-          .dump(),
-      "application/json");
+  res.set_content(json{{"status", "reloaded"},
+                       {"generation", policy->generation},
+                       {"source", policy->source}}
+                      .dump(),
+                  "application/json");
 }
 
 /**
- * GET /status
+ * GET /admin/trace[?clear=1]
  *
- * Health check and status endpoint.
+ * Buffered spans of sampled requests as Chrome trace JSON; save the body
+ * and open it in ui.perfetto.dev or chrome://tracing. Sampling is set by
+ * the "trace" config section (off by default).
  */
-void handle_status(const httplib::Request &req, httplib::Response &res) {
-  std::lock_guard<std::mutex> lock(g_state_mutex);
-
-  auto hw_info = g_tpm.get_hardware_info();
-
+void handle_trace(const httplib::Request &req, httplib::Response &res) {
   res.status = 200;
-  res.set_content(json{{"protocol", "kytin"},
-                       {"version", "1.0.0"},
-                       {"tpm",
-                        {{"available", g_tpm.is_available()},
-                         {"mock_mode", hw_info.is_mock},
-                         {"hardware_id", hw_info.hardware_id},
-                         {"manufacturer", hw_info.manufacturer},
-                         {"firmware", hw_info.firmware_version}}},
-                       {"resin",
-                        {{"balance", g_resin_tank.balance},
-                         {"lifetime_burned", g_resin_tank.lifetime_burned},
-                         {"daily_limit", g_resin_tank.daily_limit},
-                         {"daily_remaining", g_resin_tank.daily_limit -
-                                                 g_resin_tank.daily_consumed}}},
-                       {"policy",
-                        {{"daily_limit_sol", DAILY_LIMIT_SOL},
-                         {"daily_spent_sol", g_daily_spent_sol}}},
-                       {"clawhub", CLAWHUB_REGISTRY}}
-                      .dump(),
+  res.set_content(trace_dump_chrome_json(req.get_param_value("clear") == "1"),
                   "application/json");
 }
 
-} // namespace kytin
+// ============================================================================
+// LISTENING SOCKET & SYSTEMD
+// ============================================================================
+
+/**
+ * httplib::Server that can also serve on a socket it did not create
+ */
+class SentinelServer : public httplib::Server {
+public:
+  /**
+   * Serve on an already bound, listening socket (socket activation)
+   */
+  bool listen_on_socket(int fd) {
+    svr_sock_ = fd;
+    return listen_after_bind();
+  }
+
+  /**
+   * Listening socket after bind_to_port(), or -1
+   */
+  int socket() const { return svr_sock_; }
+
+  /**
+   * Stop accepting and let in-flight requests finish, like stop(), but
+   * leave the socket open: connections already waiting in its backlog are
+   * kept for whoever serves it next. The accept loop notices within one
+   * idle interval.
+   */
+  int release_socket() { return svr_sock_.exchange(-1); }
+};
+
+/**
+ * The listening socket passed by systemd socket activation (sd_listen_fds
+ * protocol: LISTEN_PID/LISTEN_FDS, first fd is 3), or -1 if there is none
+ */
+static int systemd_listen_fd() {
+#ifndef _WIN32
+  const char *pid = std::getenv("LISTEN_PID");
+  const char *fds = std::getenv("LISTEN_FDS");
+  if (!pid || !fds || std::strtol(pid, nullptr, 10) != getpid())
+    return -1;
+
+  long count = std::strtol(fds, nullptr, 10);
+  unsetenv("LISTEN_PID");
+  unsetenv("LISTEN_FDS");
+  unsetenv("LISTEN_FDNAMES");
+  if (count < 1)
+    return -1;
+  if (count > 1) {
+    KYTIN_LOG_WARN("KYTIN", "LISTEN_FDS=", count,
+                   "; serving only the first socket");
+  }
+
+  constexpr int SD_LISTEN_FDS_START = 3;
+  fcntl(SD_LISTEN_FDS_START, F_SETFD, FD_CLOEXEC);
+  return SD_LISTEN_FDS_START;
+#else
+  return -1;
+#endif
+}
+
+/**
+ * Send a state change to systemd (Type=notify), e.g. "READY=1". No-op when
+ * not started by systemd.
+ */
+static void systemd_notify(const std::string &msg) {
+#ifndef _WIN32
+  const char *path = std::getenv("NOTIFY_SOCKET");
+  if (!path || (path[0] != '/' && path[0] != '@'))
+    return;
+
+  sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  size_t len = std::min(std::strlen(path), sizeof(addr.sun_path) - 1);
+  std::memcpy(addr.sun_path, path, len);
+  if (addr.sun_path[0] == '@')
+    addr.sun_path[0] = '\0'; // Abstract namespace
+
+  int fd = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+  if (fd < 0)
+    return;
+  sendto(fd, msg.data(), msg.size(), 0, reinterpret_cast<sockaddr *>(&addr),
+         static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + len));
+  close(fd);
+#endif
+}
 
 // ============================================================================
-// SIGNAL HANDLER
+// SHUTDOWN & HOT UPGRADE
 // ============================================================================
 
-void signal_handler(int signal) {
-  std::cout << "\n[KYTIN] Received shutdown signal. Closing Sentinel..."
-            << std::endl;
-  kytin::g_running = false;
+static SentinelServer *g_server = nullptr;
+static std::string g_exe_path;          // Resolved at startup
+static std::vector<std::string> g_args; // argv, to start our successor
+
+/**
+ * Successor process that reported READY; the main thread completes the
+ * handoff once the server has drained
+ */
+struct Successor {
+  pid_t pid = -1;
+  int channel = -1; // Our end of the socketpair
+};
+static std::mutex g_successor_mutex;
+static Successor g_successor;
+static std::atomic<bool> g_upgrading{false}; // SIGUSR2 being handled
+
+/**
+ * SIGTERM/SIGINT: stop accepting new connections, let in-flight requests
+ * finish, and exit even if some never do
+ */
+static void begin_drain() {
+  if (!g_running.exchange(false))
+    return;
+  const uint32_t timeout_s = g_core.policy()->shutdown.drain_timeout_s;
+  KYTIN_LOG_INFO("KYTIN", "Shutdown requested: draining (up to ", timeout_s,
+                 "s)");
+  systemd_notify("STOPPING=1");
+  // Only stop accepting. The socket is never shut down: one inherited from
+  // systemd is shared with its listener, which keeps queueing connections
+  // for the next instance. main() closes our descriptor once drained.
+  if (g_server)
+    g_server->release_socket();
+
+  std::thread([timeout_s]() {
+    std::this_thread::sleep_for(std::chrono::seconds(timeout_s));
+    KYTIN_LOG_WARN("KYTIN", "Drain timed out after ", timeout_s,
+                   "s; exiting with requests in flight");
+    std::_Exit(1);
+  }).detach();
+}
+
+#ifndef _WIN32
+static void abandon_successor(Successor &successor) {
+  if (successor.pid > 0) {
+    kill(successor.pid, SIGKILL);
+    waitpid(successor.pid, nullptr, 0);
+  }
+  if (successor.channel >= 0)
+    close(successor.channel);
+  successor = Successor{};
+}
+#endif
+
+/**
+ * SIGUSR2: start the new binary and wait until it has initialized its TPM
+ * context. Only then does this process stop accepting; until then (and if
+ * the new process fails) nothing changes for clients.
+ */
+static void begin_upgrade() {
+#ifndef _WIN32
+  const uint32_t timeout_s = g_core.policy()->shutdown.upgrade_timeout_s;
+
+  int pair[2];
+  if (socketpair(AF_UNIX, SOCK_STREAM, 0, pair) != 0) {
+    KYTIN_LOG_ERROR("KYTIN", "Upgrade: socketpair: ", std::strerror(errno));
+    g_upgrading = false;
+    return;
+  }
+  fcntl(pair[0], F_SETFD, FD_CLOEXEC); // pair[1] is inherited
+
+  std::vector<std::string> env;
+  for (char **e = environ; *e; e++) {
+    if (std::strncmp(*e, "KYTIN_UPGRADE_FD=", 17) != 0)
+      env.emplace_back(*e);
+  }
+  env.push_back("KYTIN_UPGRADE_FD=" + std::to_string(pair[1]));
+  std::vector<char *> envp, argv;
+  for (auto &e : env)
+    envp.push_back(e.data());
+  envp.push_back(nullptr);
+  for (auto &a : g_args)
+    argv.push_back(a.data());
+  argv.push_back(nullptr);
+
+  // Signals are blocked in this thread; the successor starts with none
+  posix_spawnattr_t attr;
+  posix_spawnattr_init(&attr);
+  sigset_t none;
+  sigemptyset(&none);
+  posix_spawnattr_setsigmask(&attr, &none);
+  posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSIGMASK);
+
+  Successor successor;
+  successor.channel = pair[0];
+  int err = posix_spawn(&successor.pid, g_exe_path.c_str(), nullptr, &attr,
+                        argv.data(), envp.data());
+  posix_spawnattr_destroy(&attr);
+  close(pair[1]);
+  if (err != 0) {
+    KYTIN_LOG_ERROR("KYTIN", "Upgrade: cannot start ", g_exe_path, ": ",
+                    std::strerror(err));
+    successor.pid = -1;
+    abandon_successor(successor);
+    g_upgrading = false;
+    return;
+  }
+  KYTIN_LOG_INFO("KYTIN", "Upgrade: started ", g_exe_path, " (pid ",
+                 successor.pid, "), waiting for it to initialize");
+
+  std::string reply, error;
+  if (!handoff_recv(successor.channel, reply, nullptr, timeout_s * 1000,
+                    &error) ||
+      reply != "READY") {
+    KYTIN_LOG_ERROR("KYTIN", "Upgrade aborted, new process not ready: ",
+                    error.empty() ? reply : error);
+    abandon_successor(successor);
+    g_upgrading = false;
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(g_successor_mutex);
+    g_successor = successor;
+  }
+  g_handing_off = true;
+  KYTIN_LOG_INFO("KYTIN", "Upgrade: new process ready, draining");
+  if (g_server)
+    g_server->release_socket();
+#else
+  g_upgrading = false;
+#endif
+}
+
+/**
+ * Called on the main thread once the server has drained after
+ * begin_upgrade(). Hands over the socket and state.
+ *
+ * @return true if the successor took over (this process should exit);
+ *         false if this process keeps serving on `listen_fd`
+ */
+static bool complete_upgrade(int listen_fd) {
+#ifndef _WIN32
+  Successor successor;
+  {
+    std::lock_guard<std::mutex> lock(g_successor_mutex);
+    std::swap(successor, g_successor);
+  }
+
+  if (!g_running) {
+    // SIGTERM arrived while draining for the upgrade: plain shutdown
+    abandon_successor(successor);
+    g_handing_off = false;
+    g_upgrading = false;
+    return false;
+  }
+
+  g_scheduler.stop();
+  g_burn_sync.stop();
+  g_core.close_audit();
+  g_core.close_status_page();
+
+  // From here on systemd tracks the successor; its READY=1 must not arrive
+  // before this does
+  systemd_notify("MAINPID=" + std::to_string(successor.pid));
+
+  Handoff handoff{g_core.export_state(), g_scheduler.parked()};
+  std::string reply, error;
+  const uint32_t timeout_s = g_core.policy()->shutdown.upgrade_timeout_s;
+  bool ok = handoff_send(successor.channel, encode_handoff(handoff),
+                         listen_fd) &&
+            handoff_recv(successor.channel, reply, nullptr, timeout_s * 1000,
+                         &error) &&
+            reply == "OK";
+  if (ok) {
+    KYTIN_LOG_INFO("KYTIN", "Upgrade: pid ", successor.pid,
+                   " took over; exiting");
+    close(successor.channel);
+    close(listen_fd);
+    return true;
+  }
+
+  KYTIN_LOG_ERROR("KYTIN", "Upgrade aborted during handoff",
+                  error.empty() ? "" : ": ", error, "; resuming service");
+  abandon_successor(successor);
+  systemd_notify("MAINPID=" + std::to_string(getpid()));
+  g_core.open_audit();
+  g_core.open_status_page();
+  g_scheduler.resume(handoff.beats);
+  g_scheduler.start();
+  g_burn_sync.start(false);
+  g_handing_off = false;
+  g_upgrading = false;
+  return false;
+#else
+  return false;
+#endif
+}
+
+/**
+ * Successor side of the handoff (KYTIN_UPGRADE_FD set): initialize, report
+ * READY, adopt the predecessor's state and take its listening socket.
+ *
+ * @return the listening socket, or -1 (the predecessor keeps serving)
+ */
+static int adopt_predecessor(int channel) {
+#ifndef _WIN32
+  fcntl(channel, F_SETFD, FD_CLOEXEC);
+  if (!g_core.initialize(false)) {
+    KYTIN_LOG_ERROR("KYTIN", "FATAL: Sentinel initialization failed.");
+    return -1;
+  }
+  if (!handoff_send(channel, "READY"))
+    return -1;
+
+  std::string payload, error;
+  int listen_fd = -1;
+  Handoff handoff;
+  if (!handoff_recv(channel, payload, &listen_fd, 0, &error) ||
+      !decode_handoff(payload, handoff, &error) || listen_fd < 0) {
+    KYTIN_LOG_ERROR("KYTIN", "FATAL: handoff failed: ",
+                    error.empty() ? "no listening socket" : error);
+    if (listen_fd >= 0)
+      close(listen_fd);
+    return -1;
+  }
+
+  g_core.import_state(handoff.core);
+  g_scheduler.resume(handoff.beats);
+  if (!g_core.open_audit() || !handoff_send(channel, "OK")) {
+    close(listen_fd);
+    return -1;
+  }
+  close(channel);
+  g_core.open_status_page();
+  KYTIN_LOG_INFO("KYTIN", "Took over from previous process (Resin ",
+                 handoff.core.resin.balance, ", event ",
+                 handoff.core.last_event_id, ")");
+  return listen_fd;
+#else
+  return -1;
+#endif
+}
+
+/**
+ * Block SIGHUP, SIGTERM, SIGINT and SIGUSR2 in every thread and handle them
+ * on a dedicated sigwait thread. Must run before any other thread exists
+ * so they all inherit the mask.
+ */
+static void start_signal_watcher() {
+#ifndef _WIN32
+  sigset_t set;
+  sigemptyset(&set);
+  sigaddset(&set, SIGHUP);
+  sigaddset(&set, SIGTERM);
+  sigaddset(&set, SIGINT);
+  sigaddset(&set, SIGUSR2);
+  pthread_sigmask(SIG_BLOCK, &set, nullptr);
+
+  std::thread([set]() {
+    int sig = 0;
+    while (sigwait(&set, &sig) == 0) {
+      if (sig == SIGTERM || sig == SIGINT) {
+        begin_drain();
+      } else if (sig == SIGUSR2) {
+        if (!g_running || !g_core.is_ready() || g_upgrading.exchange(true)) {
+          KYTIN_LOG_WARN("KYTIN", "SIGUSR2 ignored: not ready or already "
+                                  "upgrading");
+          continue;
+        }
+        std::thread(begin_upgrade).detach();
+      } else {
+        std::string error;
+        if (g_core.reload_policy(&error)) {
+          KYTIN_LOG_INFO("KYTIN", "SIGHUP: policy reloaded (generation ",
+                         g_core.policy()->generation, ")");
+        } else {
+          KYTIN_LOG_ERROR("KYTIN", "SIGHUP: reload failed, keeping current "
+                                   "policy: ",
+                          error);
+        }
+      }
+    }
+  }).detach();
+#endif
 }
 
+} // namespace kytin
+
 // ============================================================================
 // MAIN - SERVER ENTRY POINT
 // ============================================================================
@@ -530,73 +1539,252 @@ int main(int argc, char *argv[]) {
     ╚═══════════════════════════════════════════════════════════╝
     )" << std::endl;
 
-  // Register signal handler
-  std::signal(SIGINT, signal_handler);
-  std::signal(SIGTERM, signal_handler);
-
-  // Initialize TPM
-  if (!kytin::g_tpm.initialize()) {
-    std::cerr << "[KYTIN] FATAL: TPM initialization failed." << std::endl;
-    return 1;
+  // Signals are handled on a sigwait thread; block them before any thread
+  // (the logger's included) starts
+  kytin::start_signal_watcher();
+  kytin::g_args.assign(argv, argv + argc);
+#ifndef _WIN32
+  char exe[4096];
+  ssize_t exe_len = readlink("/proc/self/exe", exe, sizeof(exe) - 1);
+  kytin::g_exe_path = exe_len > 0 ? std::string(exe, exe_len) : argv[0];
+#endif
+
+  // Load config: --config <path> or $KYTIN_CONFIG (defaults otherwise)
+  const char *config_path = std::getenv("KYTIN_CONFIG");
+  const char *capture_path = std::getenv("KYTIN_CAPTURE");
+  for (int i = 1; i + 1 < argc; i++) {
+    if (std::strcmp(argv[i], "--config") == 0)
+      config_path = argv[i + 1];
+    else if (std::strcmp(argv[i], "--capture") == 0)
+      capture_path = argv[i + 1];
+  }
+  if (config_path) {
+    std::string error;
+    if (!kytin::g_core.load_policy(config_path, &error)) {
+      KYTIN_LOG_ERROR("KYTIN", "FATAL: ", error);
+      return 1;
+    }
+  }
+  if (capture_path) {
+    std::string error;
+    if (!kytin::g_capture.open(capture_path, &error)) {
+      KYTIN_LOG_ERROR("KYTIN", "FATAL: ", error);
+      return 1;
+    }
   }
 
-  auto hw_info = kytin::g_tpm.get_hardware_info();
-
-  std::cout << "[KYTIN] Sentinel Configuration:" << std::endl;
-  std::cout << "        Host:       " << kytin::LISTEN_HOST << ":"
-            << kytin::LISTEN_PORT << std::endl;
-  std::cout << "        Hardware:   " << hw_info.hardware_id << std::endl;
-  std::cout << "        Mock Mode:  " << (hw_info.is_mock ? "YES" : "NO")
-            << std::endl;
-  std::cout << "        Resin:      " << kytin::g_resin_tank.balance
-            << " credits" << std::endl;
-  std::cout << "        Daily Limit:" << kytin::DAILY_LIMIT_SOL << " SOL"
-            << std::endl;
-  std::cout << "        Registry:   " << kytin::CLAWHUB_REGISTRY << std::endl;
-  std::cout << std::endl;
-
-  // Create HTTP server
-  httplib::Server svr;
+  const auto policy = kytin::g_core.policy();
+  const auto &config = policy->config;
+  kytin::g_rate_limiter =
+      std::make_unique<kytin::RateLimiter>(policy->rate_limit.capacity);
+#ifdef KYTIN_SKILL_VERIFY
+  kytin::g_skill_verifier =
+      std::make_unique<kytin::SkillVerifier>(policy->skills.cache_entries);
+#endif
+
+  // Take the listening socket before anything slow: while the TPM
+  // initializes, clients connect and get 503 NOT_READY (and /ready says so)
+  // instead of connection refused. A successor started by SIGUSR2 instead
+  // receives the socket from its predecessor once its own TPM is up.
+  kytin::SentinelServer svr;
+  kytin::g_server = &svr;
+  const char *upgrade_fd = std::getenv("KYTIN_UPGRADE_FD");
+  const bool upgrading = upgrade_fd != nullptr;
+  int listen_fd = -1;
+  if (upgrading) {
+    int channel = std::atoi(upgrade_fd);
+    unsetenv("KYTIN_UPGRADE_FD");
+    listen_fd = kytin::adopt_predecessor(channel);
+    if (listen_fd < 0)
+      return 1;
+  } else {
+    listen_fd = kytin::systemd_listen_fd();
+  }
+  const bool inherited = listen_fd >= 0;
+  if (!inherited) {
+    if (!svr.bind_to_port(config.listen_host, config.listen_port)) {
+      KYTIN_LOG_ERROR("KYTIN", "Failed to bind HTTP server to ",
+                      config.listen_host, ":", config.listen_port);
+      return 1;
+    }
+    listen_fd = svr.socket();
+  }
+#ifndef _WIN32
+  fcntl(listen_fd, F_SETFD, FD_CLOEXEC); // Passed on explicitly, if at all
+#endif
+
+  KYTIN_LOG_INFO("KYTIN", "Sentinel Configuration:");
+  if (upgrading)
+    KYTIN_LOG_INFO("KYTIN", "  Socket:     inherited from previous process");
+  else if (inherited)
+    KYTIN_LOG_INFO("KYTIN", "  Socket:     inherited from systemd");
+  else
+    KYTIN_LOG_INFO("KYTIN", "  Host:       ", config.listen_host, ":",
+                   config.listen_port);
+  KYTIN_LOG_INFO("KYTIN", "  Resin:      ",
+                 kytin::g_core.snapshot().resin.balance, " credits");
+  KYTIN_LOG_INFO("KYTIN", "  Daily Limit:", policy->daily_limit_sol, " SOL");
+  KYTIN_LOG_INFO("KYTIN", "  Registry:   ", config.clawhub_registry);
+  KYTIN_LOG_INFO("KYTIN", "  Config:     ",
+                 policy->source.empty() ? "(built-in defaults)"
+                                        : policy->source.c_str());
+  KYTIN_LOG_INFO("KYTIN", "  Audit Log:  ",
+                 policy->audit.dir.empty() ? "(disabled)"
+                                           : policy->audit.dir.c_str());
+  KYTIN_LOG_INFO("KYTIN", "  Log Level:  ", kytin::log_level_name(policy->log_level));
+  KYTIN_LOG_INFO("KYTIN", "  Capture:    ",
+                 capture_path ? capture_path : "(disabled)");
+  if (policy->rate_limit.enabled)
+    KYTIN_LOG_INFO("KYTIN", "  Rate Limit: ", policy->rate_limit.limit.rate,
+                   "/s per client (burst ", policy->rate_limit.limit.burst,
+                   ")");
+  else
+    KYTIN_LOG_INFO("KYTIN", "  Rate Limit: (disabled)");
 
   // Register endpoints
-  svr.Post("/heartbeat", kytin::handle_heartbeat);
-  svr.Post("/sign", kytin::handle_sign);
-  svr.Post("/migrate", kytin::handle_migrate); // Soul Transfer
+  // Bodies of POST endpoints stream through size and time checks
+  svr.Post("/heartbeat",
+           kytin::streamed(kytin::handle_heartbeat));
+  svr.Post("/sign",
+           kytin::streamed(kytin::handle_sign));
+  svr.Post("/policy/evaluate", kytin::streamed(kytin::handle_policy_evaluate));
+  svr.Post("/migrate", // Soul Transfer
+           kytin::streamed(kytin::handle_migrate));
   svr.Get("/status", kytin::handle_status);
+  svr.Get("/ready", kytin::handle_ready);
+  svr.Post("/attest", kytin::streamed(kytin::handle_attest));
+  svr.Get("/attest", [](const httplib::Request &req, httplib::Response &res) {
+    kytin::handle_attest(req, res, kytin::RequestBody{});
+  });
+  svr.Post("/verify-skill", kytin::streamed(kytin::handle_verify_skill));
+  svr.Get("/events", kytin::handle_events);
+  svr.Get("/history", kytin::handle_history);
+  svr.Get("/timeseries", kytin::handle_timeseries);
+  svr.Post("/admin/reload", kytin::handle_reload);
+  svr.Get("/admin/trace", kytin::handle_trace);
 
   // CORS: Handle preflight OPTIONS requests for browser access
   svr.set_pre_routing_handler(
       [](const httplib::Request &req, httplib::Response &res) {
         res.set_header("Access-Control-Allow-Origin", "*");
         res.set_header("Access-Control-Allow-Methods", "POST, GET, OPTIONS");
-        res.set_header("Access-Control-Allow-Headers", "Content-Type");
+        res.set_header("Access-Control-Allow-Headers",
+                       "Content-Type, Last-Event-ID, X-Kytin-Client");
         res.set_header("X-Kytin-Version", "1.0.0");
+        if (!kytin::g_running || kytin::g_handing_off)
+          res.set_header("Connection", "close"); // Draining
+
+        if (kytin::g_capture.is_open())
+          kytin::t_request_arrival_us = kytin::g_capture.now_us();
 
         // Handle OPTIONS preflight requests
         if (req.method == "OPTIONS") {
           res.status = 200;
           return httplib::Server::HandlerResponse::Handled;
         }
+        if (kytin::reject_oversized_body(req, res))
+          return httplib::Server::HandlerResponse::Handled;
+        if (req.method == "POST" && kytin::reply_rate_limited(req, res))
+          return httplib::Server::HandlerResponse::Handled;
         return httplib::Server::HandlerResponse::Unhandled;
       });
 
-  std::cout << "[KYTIN] Sentinel listening on http://" << kytin::LISTEN_HOST
-            << ":" << kytin::LISTEN_PORT << std::endl;
-  std::cout << "[KYTIN] Endpoints: POST /heartbeat, POST /sign, POST /migrate, "
-               "GET /status"
-            << std::endl;
-  std::cout << std::endl;
-
-  // Start server
-  if (!svr.listen(kytin::LISTEN_HOST, kytin::LISTEN_PORT)) {
-    std::cerr << "[KYTIN] Failed to start HTTP server on port "
-              << kytin::LISTEN_PORT << std::endl;
+  // Clients that wait for 100 Continue never send an oversized body at all
+  svr.set_expect_100_continue_handler(
+      [](const httplib::Request &req, httplib::Response &res) {
+        return kytin::reject_oversized_body(req, res) ? res.status : 100;
+      });
+
+  // Hard cap for every route, including those without their own limit
+  const auto &limits = policy->body_limits;
+  svr.set_payload_max_length(
+      std::max({limits.heartbeat, limits.sign, limits.migrate, limits.attest,
+                limits.verify_skill, limits.evaluate, limits.other}));
+
+  // Capture: record each completed request for tools/kytin_replay. The event
+  // stream is long-lived and preflights carry no work, so neither is kept.
+  if (kytin::g_capture.is_open()) {
+    svr.set_logger([](const httplib::Request &req,
+                      const httplib::Response &res) {
+      std::string streamed_body = std::move(kytin::t_captured_body);
+      kytin::t_captured_body.clear();
+      if (req.method == "OPTIONS" || req.path == "/events")
+        return;
+      kytin::g_capture.record(req.method,
+                              req.target.empty() ? req.path : req.target,
+                              req.body.empty() ? streamed_body : req.body,
+                              res.status, kytin::t_request_arrival_us);
+    });
+  }
+
+  KYTIN_LOG_INFO("KYTIN", "Endpoints: POST /heartbeat, POST /sign, "
+                          "POST /policy/evaluate, "
+                          "POST /migrate, GET /status, GET /ready, "
+                          "POST /attest, POST /verify-skill, GET /events, "
+                          "GET /history, GET /timeseries, POST /admin/reload, "
+                          "GET /admin/trace");
+
+  // The accept loop wakes this often to notice release_socket()
+  svr.set_idle_interval(0, 100000);
+
+  // TPM and audit log come up in the background while the server accepts
+  // (already done by a successor before it took the socket)
+  std::atomic<bool> init_failed{false};
+  std::thread init([&svr, &init_failed, upgrading]() {
+    if (upgrading) {
+      kytin::g_scheduler.start();
+      kytin::g_burn_sync.start(false); // The handed-over tank has it all
+      kytin::systemd_notify("READY=1");
+      return;
+    }
+    if (!kytin::g_core.initialize()) {
+      KYTIN_LOG_ERROR("KYTIN", "FATAL: Sentinel initialization failed.");
+      init_failed = true;
+      svr.wait_until_ready();
+      svr.stop();
+      return;
+    }
+    auto hw_info = kytin::g_core.tpm().get_hardware_info();
+    KYTIN_LOG_INFO("KYTIN", "Ready in ", kytin::g_core.startup_ms(),
+                   " ms - hardware ", hw_info.hardware_id,
+                   hw_info.is_mock ? " (MOCK)" : "");
+    kytin::g_core.open_status_page();
+    kytin::g_scheduler.start();
+    kytin::g_burn_sync.start();
+    kytin::systemd_notify("READY=1");
+  });
+
+  KYTIN_LOG_INFO("KYTIN", "Sentinel listening on http://", config.listen_host,
+                 ":", config.listen_port);
+  bool served = svr.listen_on_socket(listen_fd);
+  bool handed_over = false;
+  while (served && kytin::g_handing_off) {
+    // Drained for an upgrade: hand over, or keep serving if that fails
+    handed_over = kytin::complete_upgrade(listen_fd);
+    if (handed_over || !kytin::g_running)
+      break;
+    served = svr.listen_on_socket(listen_fd);
+  }
+#ifndef _WIN32
+  // Released, not closed, by the drain (httplib closes it itself when the
+  // accept loop fails)
+  if (served && !handed_over)
+    close(listen_fd);
+#endif
+  init.join();
+  if (init_failed)
+    return 1;
+  if (!served) {
+    KYTIN_LOG_ERROR("KYTIN", "HTTP server stopped with an error");
     return 1;
   }
 
   // Cleanup
-  kytin::g_tpm.shutdown();
-  std::cout << "[KYTIN] Sentinel shutdown complete." << std::endl;
+  kytin::g_scheduler.stop();
+  kytin::g_burn_sync.stop();
+  kytin::g_capture.close();
+  kytin::g_core.shutdown();
+  KYTIN_LOG_INFO("KYTIN", "Sentinel shutdown complete.");
 
   return 0;
 }
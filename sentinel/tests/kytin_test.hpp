@@ -0,0 +1,70 @@
+/*
+ * Kytin Protocol - Unit Test Checks
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ *
+ * Each test is a plain executable registered with CTest. A failed check
+ * prints where and why and the test keeps going; main() ends with
+ * `return kytin::test::result();`. Checks stay live in Release builds,
+ * unlike assert().
+ */
+
+#ifndef KYTIN_TEST_HPP
+#define KYTIN_TEST_HPP
+
+#include <iostream>
+
+namespace kytin::test {
+
+/**
+ * @brief Exit status CTest reports as skipped (e.g. a test that needs the
+ *        mock TPM in a hardware build)
+ */
+constexpr int SKIPPED = 77;
+
+inline int& failures() {
+    static int count = 0;
+    return count;
+}
+
+inline bool check(bool ok, const char* expr, const char* file, int line) {
+    if (!ok) {
+        std::cerr << file << ":" << line << ": check failed: " << expr
+                  << "\n";
+        failures()++;
+    }
+    return ok;
+}
+
+template <typename A, typename B>
+bool check_eq(const A& a, const B& b, const char* expr, const char* file,
+              int line) {
+    if (a == b)
+        return true;
+    std::cerr << file << ":" << line << ": check failed: " << expr << " ("
+              << a << " vs " << b << ")\n";
+    failures()++;
+    return false;
+}
+
+/**
+ * @brief Exit status for main(): 0 if every check passed
+ */
+inline int result() {
+    if (failures())
+        std::cerr << failures() << " check(s) failed\n";
+    return failures() ? 1 : 0;
+}
+
+} // namespace kytin::test
+
+#define KYTIN_CHECK(expr) \
+    ::kytin::test::check(static_cast<bool>(expr), #expr, __FILE__, __LINE__)
+
+#define KYTIN_CHECK_EQ(a, b) \
+    ::kytin::test::check_eq((a), (b), #a " == " #b, __FILE__, __LINE__)
+
+#endif // KYTIN_TEST_HPP
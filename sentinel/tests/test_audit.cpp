@@ -0,0 +1,173 @@
+/*
+ * Kytin Protocol - Audit Log Tests
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ */
+
+#include "kytin_audit.hpp"
+#include "kytin_test.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <thread>
+
+#include <unistd.h>
+
+using namespace kytin;
+namespace fs = std::filesystem;
+
+static constexpr uint32_t SEGMENT = 4096;   // Four cold blocks per segment
+static constexpr uint64_t RECORDS = 3 * SEGMENT + 500;
+static constexpr uint64_t T0 = 1800000000ull * 1000000;
+
+// Record n (1-based) is stamped T0 + 10n us
+static uint64_t ts(uint64_t seq) { return T0 + 10 * seq; }
+
+static size_t count_files(const std::string &dir, const std::string &ext) {
+  size_t n = 0;
+  for (const auto &entry : fs::directory_iterator(dir))
+    n += entry.path().extension() == ext;
+  return n;
+}
+
+static AuditOptions options(const std::string &dir) {
+  AuditOptions o;
+  o.dir = dir;
+  o.segment_records = SEGMENT;
+  o.hot_segments = 1;
+  return o;
+}
+
+static bool fill(AuditLog &log) {
+  for (uint64_t i = 1; i <= RECORDS; i++) {
+    AuditRecord r{};
+    r.kind = static_cast<uint8_t>(i % 2 ? AuditKind::HEARTBEAT
+                                        : AuditKind::SIGN);
+    r.timestamp_us = ts(i);
+    std::snprintf(r.detail, sizeof(r.detail), "record %llu",
+                  static_cast<unsigned long long>(i));
+    if (log.append(r) != i)
+      return false;
+  }
+  return true;
+}
+
+// Records [first, last] in order, each intact
+static bool is_run(const std::vector<AuditRecord> &records, uint64_t first,
+                   uint64_t last) {
+  if (records.size() != last - first + 1)
+    return false;
+  for (uint64_t i = 0; i < records.size(); i++) {
+    const AuditRecord &r = records[i];
+    const std::string detail = "record " + std::to_string(first + i);
+    if (r.seq != first + i || r.timestamp_us != ts(first + i) ||
+        detail != r.detail)
+      return false;
+  }
+  return true;
+}
+
+static void test_queries(const AuditLog &log) {
+  AuditQuery all;
+  all.limit = RECORDS + 10;
+  KYTIN_CHECK(is_run(log.query(all), 1, RECORDS));
+
+  // Cold segment, second block -> sealed hot segment -> active segment
+  AuditQuery span;
+  span.from_us = ts(1500);
+  span.to_us = ts(3 * SEGMENT + 100);
+  span.limit = RECORDS;
+  KYTIN_CHECK(is_run(log.query(span), 1500, 3 * SEGMENT + 100));
+
+  // Bounds between two records, inside one cold block
+  AuditQuery inner;
+  inner.from_us = ts(2000) - 5;
+  inner.to_us = ts(2010) + 5;
+  KYTIN_CHECK(is_run(log.query(inner), 2000, 2010));
+
+  // Nothing there
+  AuditQuery before;
+  before.to_us = ts(1) - 1;
+  KYTIN_CHECK(log.query(before).empty());
+  AuditQuery after;
+  after.from_us = ts(RECORDS) + 1;
+  KYTIN_CHECK(log.query(after).empty());
+
+  // Paging with the seq cursor across every segment boundary
+  AuditQuery page;
+  page.limit = 999;
+  uint64_t next = 1;
+  bool intact = true;
+  for (;;) {
+    auto records = log.query(page);
+    if (records.empty())
+      break;
+    intact &= is_run(records, next, next + records.size() - 1);
+    next += records.size();
+    page.after_seq = records.back().seq;
+  }
+  KYTIN_CHECK(intact);
+  KYTIN_CHECK_EQ(next, RECORDS + 1);
+
+  // A cursor inside a cold segment combined with a time range
+  AuditQuery mixed;
+  mixed.from_us = ts(100);
+  mixed.to_us = ts(5000);
+  mixed.after_seq = 4000;
+  mixed.limit = 2000;
+  KYTIN_CHECK(is_run(log.query(mixed), 4001, 5000));
+}
+
+int main() {
+  const std::string dir =
+      (fs::temp_directory_path() /
+       ("kytin-test-audit-" + std::to_string(getpid())))
+          .string();
+  fs::remove_all(dir);
+
+  {
+    AuditLog log;
+    std::string error;
+    if (!KYTIN_CHECK(log.open(options(dir), &error)) ||
+        !KYTIN_CHECK(fill(log))) {
+      fs::remove_all(dir);
+      return kytin::test::result();
+    }
+
+#ifdef KYTIN_AUDIT_ZLIB
+    // The two oldest segments go cold in the background
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (count_files(dir, ".segz") < 2 &&
+           std::chrono::steady_clock::now() < deadline)
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    while (count_files(dir, ".seg") > 2 &&
+           std::chrono::steady_clock::now() < deadline)
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    KYTIN_CHECK_EQ(count_files(dir, ".segz"), 2u);
+#endif
+    KYTIN_CHECK_EQ(count_files(dir, ".seg") + count_files(dir, ".segz"), 4u);
+
+    test_queries(log);
+  }
+
+  // Reopened from disk: same answers, and appends carry on
+  {
+    AuditLog log;
+    if (KYTIN_CHECK(log.open(options(dir)))) {
+      KYTIN_CHECK_EQ(log.last_seq(), RECORDS);
+      test_queries(log);
+      AuditRecord r{};
+      r.timestamp_us = ts(RECORDS + 1);
+      KYTIN_CHECK_EQ(log.append(r), RECORDS + 1);
+    }
+  }
+
+  fs::remove_all(dir);
+  return kytin::test::result();
+}
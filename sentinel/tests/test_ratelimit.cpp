@@ -0,0 +1,116 @@
+/*
+ * Kytin Protocol - Rate Limiter Tests
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ */
+
+#include "kytin_ratelimit.hpp"
+#include "kytin_test.hpp"
+
+#include <string>
+
+using namespace kytin;
+
+static constexpr uint64_t MS = 1000000;
+static constexpr uint64_t T0 = 1000 * MS;
+
+static void test_burst_then_refill() {
+  RateLimiter limiter(1024);
+  const RateLimitOptions::Limit limit{.rate = 10.0, .burst = 5.0};
+
+  for (int i = 0; i < 5; i++)
+    KYTIN_CHECK(limiter.acquire("skill", limit, T0).allowed);
+  auto decision = limiter.acquire("skill", limit, T0);
+  KYTIN_CHECK(!decision.allowed);
+  KYTIN_CHECK_EQ(decision.retry_after_ms, 100u);
+
+  // One token per 100 ms
+  KYTIN_CHECK(!limiter.acquire("skill", limit, T0 + 99 * MS).allowed);
+  KYTIN_CHECK(limiter.acquire("skill", limit, T0 + 100 * MS).allowed);
+  KYTIN_CHECK(!limiter.acquire("skill", limit, T0 + 100 * MS).allowed);
+
+  // Idle long enough, the whole burst is back, and no more
+  const uint64_t later = T0 + 2000 * MS;
+  for (int i = 0; i < 5; i++)
+    KYTIN_CHECK(limiter.acquire("skill", limit, later).allowed);
+  KYTIN_CHECK(!limiter.acquire("skill", limit, later).allowed);
+
+  KYTIN_CHECK_EQ(limiter.rejected(), 4u);
+}
+
+static void test_clients_are_independent() {
+  RateLimiter limiter(1024);
+  const RateLimitOptions::Limit limit{.rate = 1.0, .burst = 1.0};
+
+  KYTIN_CHECK(limiter.acquire("a", limit, T0).allowed);
+  KYTIN_CHECK(!limiter.acquire("a", limit, T0).allowed);
+  KYTIN_CHECK(limiter.acquire("b", limit, T0).allowed);
+
+  // rate 0 means unlimited
+  const RateLimitOptions::Limit unlimited{.rate = 0.0, .burst = 1.0};
+  for (int i = 0; i < 100; i++)
+    KYTIN_CHECK(limiter.acquire("a", unlimited, T0).allowed);
+}
+
+static void test_slot_takeover() {
+  RateLimiter limiter(1024);
+  const RateLimitOptions::Limit limit{.rate = 1.0, .burst = 1.0};
+
+  // Far more active clients than slots: every probe window fills up
+  for (int i = 0; i < 8 * 1024; i++)
+    limiter.acquire("client-" + std::to_string(i), limit, T0);
+
+  // Saturated: a newcomer gets no bucket, and signing is not blocked
+  for (int i = 0; i < 3; i++)
+    KYTIN_CHECK(limiter.acquire("newcomer", limit, T0).allowed);
+  // Clients already in the table keep their buckets
+  KYTIN_CHECK(!limiter.acquire("client-0", limit, T0).allowed);
+
+  // Once buckets have refilled, the newcomer takes over an idle slot and
+  // is limited like anyone else
+  const uint64_t later = T0 + 2000 * MS;
+  KYTIN_CHECK(limiter.acquire("newcomer", limit, later).allowed);
+  KYTIN_CHECK(!limiter.acquire("newcomer", limit, later).allowed);
+}
+
+static void test_key_header_trust() {
+  RateLimitOptions options;
+  KYTIN_CHECK(!options.trusts_key_header("10.0.0.1"));
+
+  options.key_header = "X-Kytin-Client";
+  KYTIN_CHECK(options.trusts_key_header("10.0.0.1"));
+
+  options.trusted_proxies = {"127.0.0.1"};
+  KYTIN_CHECK(options.trusts_key_header("127.0.0.1"));
+  KYTIN_CHECK(!options.trusts_key_header("10.0.0.1"));
+}
+
+static void test_extreme_limits() {
+  RateLimiter limiter(1024);
+  constexpr uint64_t YEAR_MS = 365ull * 86400 * 1000;
+
+  // A rate far below anything the config accepts: one request, then a
+  // Retry-After capped at a year rather than an overflowed interval
+  const RateLimitOptions::Limit glacial{.rate = 1e-300, .burst = 1.0};
+  KYTIN_CHECK(limiter.acquire("slow", glacial, T0).allowed);
+  auto decision = limiter.acquire("slow", glacial, T0);
+  KYTIN_CHECK(!decision.allowed);
+  KYTIN_CHECK_EQ(decision.retry_after_ms, YEAR_MS);
+
+  // A burst too deep to express in nanoseconds is capped the same way
+  const RateLimitOptions::Limit deep{.rate = 1.0, .burst = 1e300};
+  for (int i = 0; i < 1000; i++)
+    KYTIN_CHECK(limiter.acquire("deep", deep, T0).allowed);
+}
+
+int main() {
+  test_burst_then_refill();
+  test_clients_are_independent();
+  test_slot_takeover();
+  test_key_header_trust();
+  test_extreme_limits();
+  return kytin::test::result();
+}
@@ -0,0 +1,351 @@
+/*
+ * Kytin Protocol - On-Chain Burn Sync Tests
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ */
+
+#include "kytin_core.hpp"
+#include "kytin_resin_sync.hpp"
+#include "kytin_test.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace kytin;
+using json = nlohmann::json;
+namespace fs = std::filesystem;
+
+static const std::string RPC_URL = "http://rpc.test";
+static const std::string ADDRESS = "BurnAccount1111111111111111111111111111111";
+static const std::string MINT = "ResinMint111111111111111111111111111111111";
+static constexpr uint64_t UNITS_PER_RESIN = 1000;
+
+// ============================================================================
+// STAND-IN JSON-RPC SERVER
+// ============================================================================
+
+/**
+ * Answers getSignaturesForAddress and batched getTransaction from an
+ * in-memory chain, like a Solana node would, and records what was asked
+ */
+class StandInRpc {
+public:
+  struct Tx {
+    std::string signature;
+    json instructions = json::array();
+    json inner = json::array();     // innerInstructions entries
+    bool failed = false;            // Transaction errored on chain
+  };
+
+  std::vector<Tx> chain;            // Oldest first; slot = index + 1
+  std::vector<json> signature_queries;
+  std::vector<size_t> batches;      // getTransaction calls per request
+  std::vector<std::string> fetched; // Signatures, in request order
+  bool down = false;
+
+  void append(json instructions, bool failed = false) {
+    Tx tx;
+    tx.signature = "sig-" + std::to_string(chain.size() + 1);
+    tx.instructions = std::move(instructions);
+    tx.failed = failed;
+    chain.push_back(std::move(tx));
+  }
+
+  RpcTransport transport() {
+    return [this](const std::string &url, const std::string &body,
+                  std::string &response, std::string &error) {
+      if (down || url != RPC_URL) {
+        error = "connection refused";
+        return false;
+      }
+      json request = json::parse(body);
+      response = (request.is_array() ? get_transactions(request)
+                                     : get_signatures(request))
+                     .dump();
+      return true;
+    };
+  }
+
+private:
+  size_t index_of(const std::string &signature) const {
+    for (size_t i = 0; i < chain.size(); i++)
+      if (chain[i].signature == signature)
+        return i;
+    return chain.size();
+  }
+
+  // Newest first, strictly between `until` and `before`
+  json get_signatures(const json &request) {
+    const json &config = request["params"][1];
+    signature_queries.push_back(config);
+
+    size_t end = config.contains("before")
+                     ? index_of(config["before"].get<std::string>())
+                     : chain.size();
+    size_t stop = config.contains("until")
+                      ? index_of(config["until"].get<std::string>()) + 1
+                      : 0;
+    size_t limit = config.value("limit", size_t{1000});
+
+    json result = json::array();
+    for (size_t i = end; i > stop && result.size() < limit; i--) {
+      const Tx &tx = chain[i - 1];
+      result.push_back(
+          {{"signature", tx.signature},
+           {"slot", i},
+           {"err", tx.failed ? json{{"InstructionError", {0, "Custom"}}}
+                             : json(nullptr)}});
+    }
+    return {{"jsonrpc", "2.0"}, {"id", request["id"]}, {"result", result}};
+  }
+
+  json get_transactions(const json &requests) {
+    batches.push_back(requests.size());
+    json replies = json::array();
+    for (const auto &request : requests) {
+      std::string signature = request["params"][0];
+      fetched.push_back(signature);
+      size_t i = index_of(signature);
+      json result = nullptr;
+      if (i < chain.size()) {
+        const Tx &tx = chain[i];
+        result = {{"slot", i + 1},
+                  {"meta", {{"err", nullptr}, {"innerInstructions", tx.inner}}},
+                  {"transaction",
+                   {{"message", {{"instructions", tx.instructions}}}}}};
+      }
+      replies.push_back(
+          {{"jsonrpc", "2.0"}, {"id", request["id"]}, {"result", result}});
+    }
+    return replies;
+  }
+};
+
+// SPL-Token burn of `units` from ADDRESS (burnChecked carries tokenAmount)
+static json burn(uint64_t units, bool checked = false,
+                 const std::string &mint = MINT) {
+  json info = {{"mint", mint}, {"account", ADDRESS}, {"authority", "Owner1"}};
+  if (checked)
+    info["tokenAmount"] = {{"amount", std::to_string(units)}, {"decimals", 9}};
+  else
+    info["amount"] = std::to_string(units);
+  return {{"program", "spl-token"},
+          {"parsed", {{"type", checked ? "burnChecked" : "burn"},
+                      {"info", info}}}};
+}
+
+static json burns(std::vector<json> instructions) {
+  return json(std::move(instructions));
+}
+
+// ============================================================================
+// FIXTURE
+// ============================================================================
+
+/**
+ * A core whose policy polls ADDRESS through the stand-in server
+ */
+static bool configure(SentinelCore &core, const std::string &dir,
+                      uint32_t batch_size, const std::string &cache_file) {
+  const std::string path = dir + "/config.json";
+  std::ofstream(path) << json{{"solana_rpc", RPC_URL},
+                              {"burn_sync",
+                               {{"address", ADDRESS},
+                                {"mint", MINT},
+                                {"units_per_resin", UNITS_PER_RESIN},
+                                {"batch_size", batch_size},
+                                {"cache_file", cache_file}}}}
+                             .dump();
+  std::string error;
+  return KYTIN_CHECK(core.load_policy(path, &error));
+}
+
+static uint64_t balance(const SentinelCore &core) {
+  return core.snapshot().resin.balance;
+}
+
+// ============================================================================
+// TESTS
+// ============================================================================
+
+static void test_paging_and_batching(const std::string &dir) {
+  constexpr size_t TXS = 2100; // Three signature pages: 1000 + 1000 + 100
+  constexpr uint32_t BATCH = 64;
+
+  StandInRpc rpc;
+  for (size_t i = 0; i < TXS; i++)
+    rpc.append(burns({burn(UNITS_PER_RESIN)}));
+
+  SentinelCore core(0);
+  if (!configure(core, dir, BATCH, ""))
+    return;
+  BurnSync sync(core, rpc.transport());
+  std::string error;
+  KYTIN_CHECK(sync.sync_once(&error));
+  KYTIN_CHECK_EQ(balance(core), TXS);
+
+  // Pages walk back with `before` until a short page
+  if (KYTIN_CHECK_EQ(rpc.signature_queries.size(), 3u)) {
+    KYTIN_CHECK(!rpc.signature_queries[0].contains("before"));
+    KYTIN_CHECK_EQ(rpc.signature_queries[1].value("before", ""), "sig-1101");
+    KYTIN_CHECK_EQ(rpc.signature_queries[2].value("before", ""), "sig-101");
+    KYTIN_CHECK(!rpc.signature_queries[0].contains("until"));
+  }
+
+  // Full batches, oldest transaction first
+  KYTIN_CHECK_EQ(rpc.batches.size(), (TXS + BATCH - 1) / BATCH);
+  for (size_t i = 0; i + 1 < rpc.batches.size(); i++)
+    KYTIN_CHECK_EQ(rpc.batches[i], size_t{BATCH});
+  KYTIN_CHECK_EQ(rpc.fetched.size(), TXS);
+  for (size_t i = 0; i < rpc.fetched.size(); i++)
+    if (!KYTIN_CHECK_EQ(rpc.fetched[i], "sig-" + std::to_string(i + 1)))
+      break;
+
+  auto stats = sync.stats();
+  KYTIN_CHECK_EQ(stats.last_signature, "sig-2100");
+  KYTIN_CHECK_EQ(stats.last_slot, TXS);
+  KYTIN_CHECK_EQ(stats.burns, TXS);
+  KYTIN_CHECK_EQ(stats.rpc_requests, 3 + rpc.batches.size());
+
+  // The next cycle asks only for what is newer than the cursor
+  rpc.append(burns({burn(2 * UNITS_PER_RESIN)}));
+  rpc.signature_queries.clear();
+  rpc.fetched.clear();
+  KYTIN_CHECK(sync.sync_once(&error));
+  KYTIN_CHECK_EQ(balance(core), TXS + 2);
+  if (KYTIN_CHECK_EQ(rpc.signature_queries.size(), 1u))
+    KYTIN_CHECK_EQ(rpc.signature_queries[0].value("until", ""), "sig-2100");
+  KYTIN_CHECK_EQ(rpc.fetched.size(), 1u);
+
+  // Nothing new: no getTransaction request at all
+  const size_t batches = rpc.batches.size();
+  KYTIN_CHECK(sync.sync_once(&error));
+  KYTIN_CHECK_EQ(rpc.batches.size(), batches);
+}
+
+static void test_fractional_carry_over(const std::string &dir) {
+  StandInRpc rpc;
+  rpc.append(burns({burn(400)}));
+  rpc.append(burns({burn(400, true)}));
+
+  SentinelCore core(0);
+  if (!configure(core, dir, 50, ""))
+    return;
+  BurnSync sync(core, rpc.transport());
+
+  // 800 units: not a whole Resin yet
+  KYTIN_CHECK(sync.sync_once());
+  KYTIN_CHECK_EQ(balance(core), 0u);
+  KYTIN_CHECK_EQ(sync.stats().burns, 2u);
+
+  // The remainder carries into the next cycle: 800 + 400 + 700 = 1.9k
+  rpc.append(burns({burn(400)}));
+  rpc.chain.back().inner = json::array(
+      {{{"index", 0}, {"instructions", burns({burn(700, true)})}}});
+  KYTIN_CHECK(sync.sync_once());
+  KYTIN_CHECK_EQ(balance(core), 1u);
+
+  // Not credited: a failed transaction, another mint, someone else's burn
+  rpc.append(burns({burn(5 * UNITS_PER_RESIN)}), true);
+  rpc.append(burns({burn(5 * UNITS_PER_RESIN, false, "OtherMint")}));
+  json foreign = burn(5 * UNITS_PER_RESIN);
+  foreign["parsed"]["info"]["account"] = "SomeoneElse";
+  foreign["parsed"]["info"]["authority"] = "SomeoneElse";
+  rpc.append(burns({foreign}));
+  KYTIN_CHECK(sync.sync_once());
+  KYTIN_CHECK_EQ(balance(core), 1u);
+  KYTIN_CHECK_EQ(sync.stats().last_signature, "sig-6");
+
+  // The failed transaction is never fetched
+  for (const auto &signature : rpc.fetched)
+    KYTIN_CHECK(signature != "sig-4");
+
+  // 900 + 100 left over = 1 more; 2.5k = 2 more, 500 left over
+  rpc.append(burns({burn(100), burn(2500, true)}));
+  KYTIN_CHECK(sync.sync_once());
+  KYTIN_CHECK_EQ(balance(core), 4u);
+  KYTIN_CHECK_EQ(sync.stats().credited_resin, 4u);
+}
+
+static void test_restart_from_cache(const std::string &dir) {
+  const std::string cache = dir + "/burn-sync.json";
+  fs::remove(cache);
+
+  StandInRpc rpc;
+  rpc.append(burns({burn(1500)}));
+  rpc.append(burns({burn(2 * UNITS_PER_RESIN)}));
+
+  {
+    SentinelCore core(0);
+    if (!configure(core, dir, 50, cache))
+      return;
+    BurnSync sync(core, rpc.transport());
+    KYTIN_CHECK(sync.sync_once());
+    KYTIN_CHECK_EQ(balance(core), 3u); // 500 units left over
+  }
+
+  std::ifstream in(cache);
+  if (!KYTIN_CHECK(in))
+    return;
+  json saved = json::parse(in);
+  KYTIN_CHECK_EQ(saved.value("last_signature", ""), "sig-2");
+  KYTIN_CHECK_EQ(saved.value("credited_resin", uint64_t{0}), 3u);
+  KYTIN_CHECK_EQ(saved.value("remainder_units", uint64_t{0}), 500u);
+
+  // A new process re-credits the cached total, then resumes after the
+  // cursor with the saved remainder
+  rpc.append(burns({burn(500)}));
+  rpc.signature_queries.clear();
+  rpc.fetched.clear();
+  {
+    SentinelCore core(0);
+    if (!configure(core, dir, 50, cache))
+      return;
+    BurnSync sync(core, rpc.transport());
+    KYTIN_CHECK(sync.sync_once());
+    KYTIN_CHECK_EQ(balance(core), 4u);
+    if (KYTIN_CHECK_EQ(rpc.signature_queries.size(), 1u))
+      KYTIN_CHECK_EQ(rpc.signature_queries[0].value("until", ""), "sig-2");
+    KYTIN_CHECK_EQ(rpc.fetched.size(), 1u);
+    KYTIN_CHECK_EQ(sync.stats().burns, 3u);
+  }
+
+  // An RPC outage keeps the cached state; nothing is credited twice
+  rpc.down = true;
+  {
+    SentinelCore core(0);
+    if (!configure(core, dir, 50, cache))
+      return;
+    BurnSync sync(core, rpc.transport());
+    std::string error;
+    KYTIN_CHECK(!sync.sync_once(&error));
+    KYTIN_CHECK_EQ(error, "connection refused");
+    KYTIN_CHECK_EQ(balance(core), 4u);
+    KYTIN_CHECK_EQ(sync.stats().rpc_errors, 1u);
+  }
+}
+
+int main() {
+  const std::string dir =
+      (fs::temp_directory_path() /
+       ("kytin-test-resin-sync-" + std::to_string(getpid())))
+          .string();
+  fs::remove_all(dir);
+  fs::create_directories(dir);
+
+  test_paging_and_batching(dir);
+  test_fractional_carry_over(dir);
+  test_restart_from_cache(dir);
+
+  fs::remove_all(dir);
+  return kytin::test::result();
+}
@@ -0,0 +1,106 @@
+/*
+ * Kytin Protocol - Sequence Allocator Tests
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ */
+
+#include "kytin_sequence.hpp"
+#include "kytin_test.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+using namespace kytin;
+
+static constexpr uint32_t NV_INDEX = SequenceOptions{}.nv_index;
+
+static void test_block_refill(TPMInterface &tpm) {
+  tpm.set_mock_counter(NV_INDEX, 9);
+  SequenceAllocator allocator(tpm);
+
+  // The first number comes from the block the first increment reserves
+  KYTIN_CHECK_EQ(allocator.next().value_or(0), 10 * SEQUENCE_BLOCK);
+  for (uint64_t i = 1; i < SEQUENCE_BLOCK; i++)
+    if (!KYTIN_CHECK_EQ(allocator.next().value_or(0),
+                        10 * SEQUENCE_BLOCK + i))
+      break;
+
+  // Block used up: the next one is reserved on demand
+  KYTIN_CHECK_EQ(allocator.next().value_or(0), 11 * SEQUENCE_BLOCK);
+  auto stats = allocator.stats();
+  KYTIN_CHECK_EQ(stats.blocks, 2u);
+  KYTIN_CHECK_EQ(stats.issued, SEQUENCE_BLOCK + 1);
+
+  // A restart skips the rest of the block rather than reissue it
+  SequenceAllocator restarted(tpm);
+  KYTIN_CHECK_EQ(restarted.next().value_or(0), 12 * SEQUENCE_BLOCK);
+}
+
+static void test_concurrent_refills(TPMInterface &tpm) {
+  constexpr int THREADS = 4;
+  constexpr uint64_t PER_THREAD = 3 * SEQUENCE_BLOCK / 2;
+
+  tpm.set_mock_counter(NV_INDEX, 0);
+  SequenceAllocator allocator(tpm);
+  std::vector<std::vector<uint64_t>> drawn(THREADS);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < THREADS; t++) {
+    threads.emplace_back([&, t] {
+      drawn[t].reserve(PER_THREAD);
+      for (uint64_t i = 0; i < PER_THREAD; i++)
+        drawn[t].push_back(allocator.next().value_or(0));
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  std::vector<uint64_t> all;
+  for (const auto &numbers : drawn) {
+    // Increasing as seen by each caller
+    KYTIN_CHECK(std::is_sorted(numbers.begin(), numbers.end()));
+    KYTIN_CHECK(std::adjacent_find(numbers.begin(), numbers.end()) ==
+                numbers.end());
+    all.insert(all.end(), numbers.begin(), numbers.end());
+  }
+  std::sort(all.begin(), all.end());
+  KYTIN_CHECK(std::adjacent_find(all.begin(), all.end()) == all.end());
+  KYTIN_CHECK(all.front() >= SEQUENCE_BLOCK); // Never 0 (failure)
+  KYTIN_CHECK_EQ(allocator.stats().issued, THREADS * PER_THREAD);
+  // Every number comes from a reserved block (counter 0 -> blocks 1..n). A
+  // caller preempted past a whole refill may skip its number, so a few
+  // gaps are allowed; duplicates are not.
+  KYTIN_CHECK(all.back() < (allocator.stats().blocks + 1) * SEQUENCE_BLOCK);
+}
+
+static void test_overflow_guard(TPMInterface &tpm) {
+  // The last block whose numbers all fit in 64 bits
+  constexpr uint64_t LAST_BLOCK = ~uint64_t{0} / SEQUENCE_BLOCK - 1;
+
+  tpm.set_mock_counter(NV_INDEX, LAST_BLOCK - 1);
+  SequenceAllocator allocator(tpm);
+  uint64_t last = 0;
+  for (uint64_t i = 0; i < SEQUENCE_BLOCK; i++)
+    last = allocator.next().value_or(0);
+  KYTIN_CHECK_EQ(last, (LAST_BLOCK + 1) * SEQUENCE_BLOCK - 1);
+
+  // The next block would wrap around to numbers already issued
+  KYTIN_CHECK(!allocator.next());
+  KYTIN_CHECK(!allocator.next());
+  KYTIN_CHECK_EQ(allocator.stats().failures, 2u);
+  KYTIN_CHECK_EQ(allocator.stats().issued, SEQUENCE_BLOCK);
+}
+
+int main() {
+  TPMInterface tpm;
+  if (!tpm.initialize() || !tpm.is_mock_mode())
+    return kytin::test::SKIPPED;
+
+  test_block_refill(tpm);
+  test_concurrent_refills(tpm);
+  test_overflow_guard(tpm);
+  return kytin::test::result();
+}
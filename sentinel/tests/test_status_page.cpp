@@ -0,0 +1,141 @@
+/*
+ * Kytin Protocol - Status Page Tests
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ */
+
+#include "kytin_status_page.hpp"
+#include "kytin_test.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <unistd.h>
+
+using namespace kytin;
+
+// Every numeric field set to `value`, so a torn copy shows up as a mix
+static StatusSnapshot uniform_snapshot(uint64_t value) {
+  StatusSnapshot s;
+  s.updated_unix_ms = s.pid = s.resin_balance = s.resin_lifetime_burned =
+      s.resin_daily_limit = s.resin_daily_consumed = s.policy_generation =
+          s.heartbeats = s.signs = s.last_event_id = value;
+  s.daily_spent_sol = s.daily_limit_sol = static_cast<double>(value);
+  s.flags = StatusSnapshot::STATUS_READY;
+  return s;
+}
+
+static bool is_uniform(const StatusSnapshot &s) {
+  const uint64_t v = s.updated_unix_ms;
+  return s.pid == v && s.resin_balance == v && s.resin_lifetime_burned == v &&
+         s.resin_daily_limit == v && s.resin_daily_consumed == v &&
+         s.policy_generation == v && s.heartbeats == v && s.signs == v &&
+         s.last_event_id == v && s.daily_spent_sol == static_cast<double>(v) &&
+         s.daily_limit_sol == static_cast<double>(v);
+}
+
+static void test_round_trip(const std::string &name) {
+  StatusReader reader(name);
+  std::string error;
+  KYTIN_CHECK(!reader.read(&error));
+  KYTIN_CHECK(!error.empty());
+
+  StatusPageWriter writer;
+  KYTIN_CHECK(writer.open(name));
+  StatusSnapshot published = uniform_snapshot(42);
+  published.flags |= StatusSnapshot::STATUS_TPM_MOCK;
+  std::strcpy(published.hardware_id, "KYTIN-MOCK-0123456789ABCDEF");
+  writer.publish(published);
+
+  auto read = reader.read();
+  if (!KYTIN_CHECK(read.has_value()))
+    return;
+  KYTIN_CHECK(is_uniform(*read));
+  KYTIN_CHECK_EQ(read->signs, 42u);
+  KYTIN_CHECK(read->has(StatusSnapshot::STATUS_READY));
+  KYTIN_CHECK(read->has(StatusSnapshot::STATUS_TPM_MOCK));
+  KYTIN_CHECK_EQ(std::string(read->hardware_id),
+                 "KYTIN-MOCK-0123456789ABCDEF");
+}
+
+static void test_no_torn_reads(const std::string &name) {
+  constexpr uint64_t UPDATES = 200000;
+
+  StatusPageWriter writer;
+  if (!KYTIN_CHECK(writer.open(name)))
+    return;
+  writer.publish(uniform_snapshot(0));
+
+  std::atomic<bool> done{false};
+  std::thread publisher([&] {
+    for (uint64_t i = 1; i <= UPDATES; i++)
+      writer.publish(uniform_snapshot(i));
+    done = true;
+  });
+
+  StatusReader reader(name);
+  uint64_t reads = 0, torn = 0, last = 0, backwards = 0;
+  while (!done.load()) {
+    auto snapshot = reader.read();
+    if (!snapshot)
+      continue;
+    reads++;
+    if (!is_uniform(*snapshot))
+      torn++;
+    if (snapshot->signs < last)
+      backwards++;
+    last = snapshot->signs;
+  }
+  publisher.join();
+
+  KYTIN_CHECK(reads > 0);
+  KYTIN_CHECK_EQ(torn, 0u);
+  KYTIN_CHECK_EQ(backwards, 0u);
+  KYTIN_CHECK_EQ(reader.read().value_or(StatusSnapshot{}).signs, UPDATES);
+}
+
+static void test_close_and_successor(const std::string &name) {
+  StatusReader reader(name);
+  {
+    StatusPageWriter writer;
+    KYTIN_CHECK(writer.open(name));
+    writer.publish(uniform_snapshot(1));
+    KYTIN_CHECK_EQ(reader.read().value_or(StatusSnapshot{}).signs, 1u);
+  } // Closed: marked, then unlinked
+
+  auto closed = reader.read();
+  if (KYTIN_CHECK(closed.has_value())) {
+    KYTIN_CHECK(closed->has(StatusSnapshot::STATUS_CLOSED));
+    KYTIN_CHECK(!closed->has(StatusSnapshot::STATUS_READY));
+    KYTIN_CHECK_EQ(closed->signs, 1u);
+  }
+
+  // A successor under the same name is picked up on the next read
+  StatusPageWriter successor;
+  KYTIN_CHECK(successor.open(name));
+  successor.publish(uniform_snapshot(2));
+  auto current = reader.read();
+  if (KYTIN_CHECK(current.has_value())) {
+    KYTIN_CHECK(!current->has(StatusSnapshot::STATUS_CLOSED));
+    KYTIN_CHECK_EQ(current->signs, 2u);
+  }
+}
+
+int main() {
+  const std::string name = "/kytin-test-status-" + std::to_string(getpid());
+  {
+    StatusPageWriter probe;
+    if (!probe.open(name))
+      return kytin::test::SKIPPED; // No POSIX shared memory here
+  }
+
+  test_round_trip(name);
+  test_no_torn_reads(name);
+  test_close_and_successor(name);
+  return kytin::test::result();
+}
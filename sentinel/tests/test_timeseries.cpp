@@ -0,0 +1,152 @@
+/*
+ * Kytin Protocol - Time Series Tests
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ */
+
+#include "kytin_test.hpp"
+#include "kytin_timeseries.hpp"
+
+#include <atomic>
+#include <numeric>
+#include <thread>
+
+using namespace kytin;
+
+// Start of an hour, so every ring's periods line up with it
+static constexpr uint64_t T0 = 1800000000 / 3600 * 3600;
+
+static uint64_t total(const std::vector<uint64_t> &values) {
+  return std::accumulate(values.begin(), values.end(), uint64_t{0});
+}
+
+static void test_rollups() {
+  Timeseries ts;
+  ts.record(T0, 10, 1000, 1, 0);
+  ts.record(T0, 5, 0, 1, 0);
+  ts.record(T0 + 1, 0, 2000, 0, 1);
+  ts.record(T0 + 61, 3, 0, 1, 0);
+
+  auto seconds = ts.series(Resolution::SECOND, 3, T0 + 1);
+  KYTIN_CHECK_EQ(seconds.start, T0 - 1);
+  KYTIN_CHECK_EQ(seconds.resin.size(), 3u);
+  KYTIN_CHECK_EQ(seconds.resin[1], 15u);
+  KYTIN_CHECK_EQ(seconds.heartbeats[1], 2u);
+  KYTIN_CHECK_EQ(seconds.lamports[2], 2000u);
+  KYTIN_CHECK_EQ(seconds.signs[2], 1u);
+
+  auto minutes = ts.series(Resolution::MINUTE, 2, T0 + 61);
+  KYTIN_CHECK_EQ(minutes.start, T0);
+  KYTIN_CHECK_EQ(minutes.width_s, 60u);
+  KYTIN_CHECK_EQ(minutes.resin[0], 15u);
+  KYTIN_CHECK_EQ(minutes.lamports[0], 3000u);
+  KYTIN_CHECK_EQ(minutes.resin[1], 3u);
+
+  auto hours = ts.series(Resolution::HOUR, 1, T0 + 61);
+  KYTIN_CHECK_EQ(hours.resin[0], 18u);
+  KYTIN_CHECK_EQ(hours.heartbeats[0], 3u);
+
+  // Asking for more than the ring holds is clamped to its depth
+  auto all = ts.series(Resolution::SECOND, 100000, T0 + 61);
+  KYTIN_CHECK_EQ(all.resin.size(), Timeseries::capacity(Resolution::SECOND));
+}
+
+static void test_bucket_recycling() {
+  Timeseries ts;
+  const uint64_t depth = Timeseries::capacity(Resolution::SECOND);
+  ts.record(T0, 5, 0, 1, 0);
+
+  // One lap later the same bucket holds the new second only
+  ts.record(T0 + depth, 7, 0, 1, 0);
+  auto now = ts.series(Resolution::SECOND, depth, T0 + depth);
+  KYTIN_CHECK_EQ(now.resin.back(), 7u);
+  KYTIN_CHECK_EQ(total(now.resin), 7u);
+
+  // The period it used to hold now reads as zero, not as the newer counts
+  auto before = ts.series(Resolution::SECOND, 1, T0);
+  KYTIN_CHECK_EQ(before.resin[0], 0u);
+
+  // Several laps with gaps: buckets left over from old periods are not
+  // counted in a window they do not belong to
+  ts.record(T0 + 5 * depth + 17, 11, 0, 1, 0);
+  auto later = ts.series(Resolution::SECOND, depth, T0 + 5 * depth + 17);
+  KYTIN_CHECK_EQ(total(later.resin), 11u);
+  KYTIN_CHECK_EQ(total(later.heartbeats), 1u);
+
+  // The minute ring keeps the older seconds
+  auto minutes = ts.series(Resolution::MINUTE, 60, T0 + 5 * depth + 17);
+  KYTIN_CHECK_EQ(total(minutes.resin), 23u);
+}
+
+static void test_clock_step_back() {
+  Timeseries ts;
+  ts.record(T0 + 10, 1, 0, 1, 0);
+  ts.record(T0 + 5, 2, 0, 1, 0); // Held at T0 + 10
+  auto s = ts.series(Resolution::SECOND, 6, T0 + 10);
+  KYTIN_CHECK_EQ(s.resin.front(), 0u);
+  KYTIN_CHECK_EQ(s.resin.back(), 3u);
+}
+
+static void test_rate() {
+  Timeseries ts;
+  for (uint64_t s = 0; s < 120; s++)
+    ts.record(T0 + s, 2, 500000000, 1, 0);
+
+  // Complete periods only: the second still filling is left out
+  Rate rate = ts.rate(Resolution::SECOND, 60, T0 + 119);
+  KYTIN_CHECK_EQ(rate.window_s, 60u);
+  KYTIN_CHECK_EQ(rate.resin_per_s, 2.0);
+  KYTIN_CHECK_EQ(rate.sol_per_s, 0.5);
+
+  Rate minute = ts.rate(Resolution::MINUTE, 1, T0 + 120);
+  KYTIN_CHECK_EQ(minute.window_s, 60u);
+  KYTIN_CHECK_EQ(minute.resin_per_s, 2.0);
+
+  // Everything so far falls in the hour still filling
+  Rate day = ts.rate(Resolution::HOUR, 24, T0 + 120);
+  KYTIN_CHECK_EQ(day.window_s, 86400u);
+  KYTIN_CHECK_EQ(day.resin_per_s, 0.0);
+}
+
+static void test_reader_during_recycling() {
+  constexpr uint64_t SECONDS = 20000;
+  Timeseries ts;
+  std::atomic<uint64_t> written{0};
+
+  // Every bucket holds resin = n and lamports = 3n for a single n, unless
+  // a reader mixes two periods
+  std::thread writer([&] {
+    for (uint64_t s = 1; s <= SECONDS; s++) {
+      ts.record(T0 + s, s, 3 * s, 0, 0);
+      written.store(s, std::memory_order_release);
+    }
+  });
+
+  uint64_t mixed = 0, misplaced = 0;
+  while (written.load(std::memory_order_acquire) < SECONDS) {
+    const uint64_t now = T0 + written.load(std::memory_order_acquire);
+    auto s = ts.series(Resolution::SECOND, 300, now);
+    for (size_t i = 0; i < s.resin.size(); i++) {
+      if (s.lamports[i] != 3 * s.resin[i])
+        mixed++;
+      if (s.resin[i] && s.resin[i] != s.start + i - T0)
+        misplaced++;
+    }
+  }
+  writer.join();
+
+  KYTIN_CHECK_EQ(mixed, 0u);
+  KYTIN_CHECK_EQ(misplaced, 0u);
+}
+
+int main() {
+  test_rollups();
+  test_bucket_recycling();
+  test_clock_step_back();
+  test_rate();
+  test_reader_during_recycling();
+  return kytin::test::result();
+}
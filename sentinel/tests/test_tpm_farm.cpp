@@ -0,0 +1,195 @@
+/*
+ * Kytin Protocol - TPM Signing Farm Tests
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ */
+
+#include "kytin_test.hpp"
+#include "kytin_tpm_farm.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace kytin;
+
+static const std::vector<uint8_t> PAYLOAD = {'k', 'y', 't', 'i', 'n'};
+
+// Default TCTIs: every device falls back to its own mock TPM
+static TPMFarmOptions mock_farm(size_t devices, uint32_t health_interval_ms,
+                                uint32_t down_after = 3) {
+  TPMFarmOptions options;
+  options.devices.assign(devices, "");
+  options.health_interval_ms = health_interval_ms;
+  options.down_after = down_after;
+  return options;
+}
+
+static TPMInterface::MockProfile failing(double error_rate) {
+  TPMInterface::MockProfile profile;
+  profile.error_rate = error_rate;
+  return profile;
+}
+
+static size_t up_count(const TPMFarm &farm) {
+  auto stats = farm.stats();
+  return std::count_if(stats.begin(), stats.end(),
+                       [](const auto &s) { return s.up; });
+}
+
+// Poll until `done` holds, for up to two seconds
+template <typename Pred> static bool wait_for(Pred done) {
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(2);
+  while (!done()) {
+    if (std::chrono::steady_clock::now() > deadline)
+      return false;
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  return true;
+}
+
+static void test_ties_rotate() {
+  TPMInterface primary;
+  TPMFarm farm(primary);
+  KYTIN_CHECK(farm.initialize(mock_farm(4, 60000)));
+  KYTIN_CHECK_EQ(farm.size(), 4u);
+
+  // One caller at a time: every device is idle, so they take turns
+  std::set<std::string> ids;
+  for (uint32_t i = 0; i < 8; i++) {
+    auto signature = farm.sign(PAYLOAD);
+    if (!KYTIN_CHECK(signature))
+      return;
+    KYTIN_CHECK_EQ(signature->device, i % 4);
+    ids.insert(farm.hardware_id(signature->device));
+  }
+  KYTIN_CHECK_EQ(ids.size(), 4u);
+  KYTIN_CHECK(farm.hardware_id(4).empty());
+
+  // Device 0 is the identity TPM
+  KYTIN_CHECK_EQ(farm.hardware_id(0), primary.get_hardware_id());
+  for (const auto &s : farm.stats()) {
+    KYTIN_CHECK_EQ(s.signs, 2u);
+    KYTIN_CHECK(!s.hardware_id.empty());
+    KYTIN_CHECK(!s.public_key.empty());
+  }
+}
+
+static void test_least_loaded() {
+  constexpr int THREADS = 4;
+  constexpr int PER_THREAD = 10;
+
+  TPMInterface primary;
+  TPMFarm farm(primary);
+  TPMInterface::MockProfile slow;
+  slow.latency = TPMInterface::MockProfile::Latency::FIXED;
+  slow.fixed_ms = 5.0;
+  farm.set_mock_profile(slow);
+  KYTIN_CHECK(farm.initialize(mock_farm(THREADS, 60000)));
+
+  // Serialized devices: a device already signing is never the least
+  // loaded while another sits idle, so the work spreads across all four
+  std::vector<std::thread> threads;
+  for (int t = 0; t < THREADS; t++) {
+    threads.emplace_back([&] {
+      for (int i = 0; i < PER_THREAD; i++)
+        KYTIN_CHECK(farm.sign(PAYLOAD));
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  uint64_t total = 0;
+  for (const auto &s : farm.stats()) {
+    KYTIN_CHECK(s.signs >= PER_THREAD / 2);
+    KYTIN_CHECK_EQ(s.in_flight, 0u);
+    KYTIN_CHECK(s.latency_ms >= 5.0);
+    total += s.signs;
+  }
+  KYTIN_CHECK_EQ(total, uint64_t{THREADS * PER_THREAD});
+}
+
+static void test_down_after_failures() {
+  TPMInterface primary;
+  TPMFarm farm(primary);
+  KYTIN_CHECK(farm.initialize(mock_farm(3, 60000, 2)));
+
+  // Every attempt fails on each device in turn; the second round of
+  // failures takes devices down, all but the last one up
+  farm.set_mock_profile(failing(1.0));
+  KYTIN_CHECK(!farm.sign(PAYLOAD));
+  KYTIN_CHECK_EQ(up_count(farm), 3u);
+  KYTIN_CHECK(!farm.sign(PAYLOAD));
+  KYTIN_CHECK_EQ(up_count(farm), 1u);
+  KYTIN_CHECK(!farm.sign(PAYLOAD));
+  KYTIN_CHECK_EQ(up_count(farm), 1u);
+  KYTIN_CHECK(farm.is_available());
+
+  uint64_t downs = 0;
+  uint32_t survivor = 0;
+  auto stats = farm.stats();
+  for (uint32_t i = 0; i < stats.size(); i++) {
+    downs += stats[i].downs;
+    if (stats[i].up)
+      survivor = i;
+  }
+  KYTIN_CHECK_EQ(downs, 2u);
+  KYTIN_CHECK_EQ(stats[survivor].failures, 3u);
+
+  // Down devices get no traffic: only the survivor signs
+  farm.set_mock_profile(failing(0.0));
+  for (int i = 0; i < 3; i++) {
+    auto signature = farm.sign(PAYLOAD);
+    if (KYTIN_CHECK(signature))
+      KYTIN_CHECK_EQ(signature->device, survivor);
+  }
+}
+
+static void test_health_recovery() {
+  TPMInterface primary;
+  TPMFarm farm(primary);
+  KYTIN_CHECK(farm.initialize(mock_farm(3, 10, 1)));
+
+  // Failing probes of idle devices count like failed signatures
+  farm.set_mock_profile(failing(1.0));
+  KYTIN_CHECK(wait_for([&] { return up_count(farm) == 1; }));
+  KYTIN_CHECK(farm.is_available());
+
+  // Once they answer again, the checker puts them back in rotation
+  const auto before = farm.stats();
+  farm.set_mock_profile(failing(0.0));
+  KYTIN_CHECK(wait_for([&] { return up_count(farm) == 3; }));
+
+  // Same identity after recovery
+  auto after = farm.stats();
+  for (size_t i = 0; i < after.size(); i++) {
+    KYTIN_CHECK_EQ(after[i].hardware_id, before[i].hardware_id);
+    KYTIN_CHECK(after[i].downs <= 1);
+  }
+  std::set<uint32_t> signers;
+  for (int i = 0; i < 3; i++)
+    if (auto signature = farm.sign(PAYLOAD))
+      signers.insert(signature->device);
+  KYTIN_CHECK_EQ(signers.size(), 3u);
+}
+
+int main() {
+  {
+    TPMInterface tpm;
+    if (!tpm.initialize() || !tpm.is_mock_mode())
+      return kytin::test::SKIPPED;
+    tpm.shutdown();
+  }
+
+  test_ties_rotate();
+  test_least_loaded();
+  test_down_after_failures();
+  test_health_recovery();
+  return kytin::test::result();
+}
@@ -0,0 +1,315 @@
+/*
+ * Kytin Protocol - Batch Signature Verification Tests
+ *
+ * Hardware Root of Trust for Autonomous AI Agents
+ * State-Locked Protocol™ (Patent Pending)
+ *
+ * Copyright (c) 2026 Kytin Protocol
+ */
+
+#include "kytin_core.hpp"
+#include "kytin_sha256.hpp"
+#include "kytin_test.hpp"
+#include "kytin_verify.hpp"
+
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <openssl/obj_mac.h>
+
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace kytin;
+
+/**
+ * Textbook P-256 ECDSA with a fixed key and caller-chosen nonces, so the
+ * known-good signatures are the same on every run
+ */
+class Signer {
+public:
+  explicit Signer(unsigned long secret) {
+    m_group = EC_GROUP_new_by_curve_name(NID_X9_62_prime256v1);
+    m_ctx = BN_CTX_new();
+    m_d = BN_new();
+    BN_set_word(m_d, secret);
+    EC_POINT *q = EC_POINT_new(m_group);
+    EC_POINT_mul(m_group, q, m_d, nullptr, nullptr, m_ctx);
+    m_public_key.resize(65);
+    EC_POINT_point2oct(m_group, q, POINT_CONVERSION_UNCOMPRESSED,
+                       m_public_key.data(), m_public_key.size(), m_ctx);
+    EC_POINT_free(q);
+  }
+
+  ~Signer() {
+    BN_free(m_d);
+    BN_CTX_free(m_ctx);
+    EC_GROUP_free(m_group);
+  }
+
+  Signer(const Signer &) = delete;
+  Signer &operator=(const Signer &) = delete;
+
+  const std::vector<uint8_t> &public_key() const { return m_public_key; }
+
+  // r || s over digest: r = x(kG) mod n, s = k^-1 (e + r d) mod n
+  std::vector<uint8_t> sign(const Sha256::Digest &digest,
+                            unsigned long nonce) {
+    const BIGNUM *order = EC_GROUP_get0_order(m_group);
+    BN_CTX_start(m_ctx);
+    BIGNUM *k = BN_CTX_get(m_ctx);
+    BIGNUM *r = BN_CTX_get(m_ctx);
+    BIGNUM *s = BN_CTX_get(m_ctx);
+    BIGNUM *e = BN_CTX_get(m_ctx);
+    BN_set_word(k, nonce);
+    EC_POINT *point = EC_POINT_new(m_group);
+    EC_POINT_mul(m_group, point, k, nullptr, nullptr, m_ctx);
+    EC_POINT_get_affine_coordinates(m_group, point, r, nullptr, m_ctx);
+    EC_POINT_free(point);
+    BN_nnmod(r, r, order, m_ctx);
+
+    BN_bin2bn(digest.data(), digest.size(), e);
+    BN_mod_mul(s, r, m_d, order, m_ctx);
+    BN_mod_add(s, s, e, order, m_ctx);
+    BN_mod_inverse(k, k, order, m_ctx);
+    BN_mod_mul(s, s, k, order, m_ctx);
+
+    std::vector<uint8_t> out(64);
+    BN_bn2binpad(r, out.data(), 32);
+    BN_bn2binpad(s, out.data() + 32, 32);
+    BN_CTX_end(m_ctx);
+    return out;
+  }
+
+private:
+  EC_GROUP *m_group = nullptr;
+  BN_CTX *m_ctx = nullptr;
+  BIGNUM *m_d = nullptr;
+  std::vector<uint8_t> m_public_key;
+};
+
+enum class Tamper {
+  NONE,      // VALID
+  PAYLOAD,   // INVALID: payload edited after signing
+  SEQUENCE,  // INVALID: replayed under another sequence number
+  SIGNATURE, // INVALID: a bit of s flipped
+  KEY,       // INVALID: checked against another signer's key
+  ZERO_S,    // MALFORMED: s outside [1, n-1]
+  BAD_KEY    // MALFORMED: public key not on the curve
+};
+
+static VerifyStatus expected(Tamper tamper) {
+  switch (tamper) {
+  case Tamper::NONE:
+    return VerifyStatus::VALID;
+  case Tamper::ZERO_S:
+  case Tamper::BAD_KEY:
+    return VerifyStatus::MALFORMED;
+  default:
+    return VerifyStatus::INVALID;
+  }
+}
+
+static std::string hex(const std::vector<uint8_t> &bytes) {
+  static const char digits[] = "0123456789abcdef";
+  std::string out;
+  for (uint8_t b : bytes) {
+    out += digits[b >> 4];
+    out += digits[b & 0xF];
+  }
+  return out;
+}
+
+// What the Sentinel signs: sequence (8 bytes, big-endian) || payload
+static Sha256::Digest message_digest(uint64_t sequence,
+                                     const std::string &payload) {
+  std::vector<uint8_t> message;
+  for (int i = 0; i < 8; i++)
+    message.push_back(static_cast<uint8_t>(sequence >> (56 - 8 * i)));
+  message.insert(message.end(), payload.begin(), payload.end());
+  return Sha256::hash(message.data(), message.size());
+}
+
+/**
+ * One JSONL audit record, as an archive of /heartbeat replies holds them
+ */
+static std::string record(Signer &signer, const Signer &other,
+                          uint64_t sequence, Tamper tamper) {
+  const std::string payload =
+      "{\"mode\":\"TURBO\",\"n\":" + std::to_string(sequence) + "}";
+  auto signature = signer.sign(message_digest(sequence, payload),
+                               1000 + static_cast<unsigned long>(sequence));
+  auto key = signer.public_key();
+
+  std::string signed_payload = payload;
+  uint64_t signed_sequence = sequence;
+  switch (tamper) {
+  case Tamper::NONE:
+    break;
+  case Tamper::PAYLOAD:
+    signed_payload[2] = 'M';
+    break;
+  case Tamper::SEQUENCE:
+    signed_sequence++;
+    break;
+  case Tamper::SIGNATURE:
+    signature[63] ^= 0x01;
+    break;
+  case Tamper::KEY:
+    key = other.public_key();
+    break;
+  case Tamper::ZERO_S:
+    std::fill(signature.begin() + 32, signature.end(), 0);
+    break;
+  case Tamper::BAD_KEY:
+    std::fill(key.begin() + 1, key.end(), 0x01);
+    break;
+  }
+
+  std::string escaped;
+  for (char c : signed_payload) {
+    if (c == '"')
+      escaped += '\\';
+    escaped += c;
+  }
+  return "{\"signature\":\"" + base64_encode(signature) +
+         "\",\"public_key\":\"" + hex(key) + "\",\"payload\":\"" + escaped +
+         "\",\"sequence\":\"" + std::to_string(signed_sequence) + "\"}";
+}
+
+static VerifyItem parse(const std::string &line) {
+  VerifyItem item;
+  std::string error;
+  KYTIN_CHECK(parse_verify_record(line, {}, item, error));
+  return item;
+}
+
+static const Tamper ALL_TAMPERS[] = {
+    Tamper::NONE,      Tamper::PAYLOAD, Tamper::SEQUENCE, Tamper::SIGNATURE,
+    Tamper::KEY,       Tamper::ZERO_S,  Tamper::BAD_KEY};
+
+static void test_signed_digest() {
+  // The record's digest is the one the TPM signs: SHA-256 over the whole
+  // sequenced message, not a truncation of it
+  Signer signer(7);
+  auto item = parse(record(signer, signer, 42, Tamper::NONE));
+  KYTIN_CHECK(item.digest ==
+              message_digest(42, "{\"mode\":\"TURBO\",\"n\":42}"));
+
+  // No sequence (/migrate): SHA-256 of the payload alone
+  VerifyItem migrate;
+  std::string error;
+  KYTIN_CHECK(parse_verify_record(
+      "{\"last_will_signature\":\"" +
+          base64_encode(std::vector<uint8_t>(64, 1)) +
+          "\",\"payload\":\"MIGRATE_AUTHORITY_TO:abc\"}",
+      signer.public_key(), migrate, error));
+  const std::string will = "MIGRATE_AUTHORITY_TO:abc";
+  KYTIN_CHECK(migrate.digest == Sha256::hash(will.data(), will.size()));
+
+  // Unsigned-integer sequences are accepted as well as decimal strings
+  VerifyItem numeric;
+  KYTIN_CHECK(parse_verify_record(
+      "{\"signature\":\"" + base64_encode(std::vector<uint8_t>(64, 1)) +
+          "\",\"payload\":\"x\",\"sequence\":5}",
+      signer.public_key(), numeric, error));
+  KYTIN_CHECK(numeric.digest == message_digest(5, "x"));
+  KYTIN_CHECK(!parse_verify_record(
+      "{\"signature\":\"" + base64_encode(std::vector<uint8_t>(64, 1)) +
+          "\",\"payload\":\"x\",\"sequence\":\"5x\"}",
+      signer.public_key(), numeric, error));
+}
+
+static void test_single() {
+  Signer signer(7);
+  Signer other(11);
+  BatchVerifier verifier;
+  uint64_t sequence = 1;
+  for (Tamper tamper : ALL_TAMPERS) {
+    auto results =
+        verifier.verify({parse(record(signer, other, sequence++, tamper))});
+    if (KYTIN_CHECK_EQ(results.size(), 1u))
+      KYTIN_CHECK(results[0] == expected(tamper));
+  }
+  KYTIN_CHECK(verifier.verify({}).empty());
+}
+
+static void test_batched() {
+  // Three keys in runs (the decoded-key cache switches between them) and
+  // every kind of tampering interleaved, so the live items that share the
+  // Montgomery inversion have gaps at the start, middle and end
+  Signer signers[] = {Signer(7), Signer(11), Signer(13)};
+  constexpr size_t COUNT = 100;
+
+  std::vector<VerifyItem> batch;
+  std::vector<Tamper> tampers;
+  for (size_t i = 0; i < COUNT; i++) {
+    Tamper tamper = i % 3 ? Tamper::NONE : ALL_TAMPERS[(i / 3) % 7];
+    if (i == 0 || i == COUNT - 1)
+      tamper = Tamper::ZERO_S;
+    Signer &signer = signers[(i / 5) % 3];
+    batch.push_back(parse(
+        record(signer, signers[(i / 5 + 1) % 3], 1000 + i, tamper)));
+    tampers.push_back(tamper);
+  }
+
+  BatchVerifier verifier;
+  auto results = verifier.verify(batch);
+  if (!KYTIN_CHECK_EQ(results.size(), COUNT))
+    return;
+  size_t valid = 0;
+  for (size_t i = 0; i < COUNT; i++) {
+    KYTIN_CHECK(results[i] == expected(tampers[i]));
+    // Same verdict as verifying the item on its own
+    KYTIN_CHECK(verifier.verify({batch[i]})[0] == results[i]);
+    valid += results[i] == VerifyStatus::VALID;
+  }
+  KYTIN_CHECK(valid > COUNT / 2);
+
+  // A batch of known-good signatures under one key
+  std::vector<VerifyItem> good;
+  for (uint64_t i = 0; i < 64; i++)
+    good.push_back(parse(record(signers[0], signers[1], i, Tamper::NONE)));
+  for (auto status : verifier.verify(good))
+    KYTIN_CHECK(status == VerifyStatus::VALID);
+}
+
+static void test_stream() {
+  Signer signer(7);
+  Signer other(11);
+
+  // Lines 1-21 cycle through the tampers; then a blank and a garbage line
+  std::ostringstream archive;
+  for (uint64_t i = 0; i < 21; i++)
+    archive << record(signer, other, i, ALL_TAMPERS[i % 7]) << "\n";
+  archive << "\n"
+          << "not json\n";
+
+  VerifyStreamOptions options;
+  options.threads = 3;
+  options.batch_size = 5;
+  std::set<uint64_t> failed_lines;
+  std::istringstream in(archive.str());
+  auto report = verify_stream(
+      in, options, [&](uint64_t line_no, VerifyStatus, const std::string &) {
+        failed_lines.insert(line_no);
+      });
+
+  KYTIN_CHECK_EQ(report.total, 22u);
+  KYTIN_CHECK_EQ(report.valid, 3u);
+  KYTIN_CHECK_EQ(report.invalid, 12u);
+  KYTIN_CHECK_EQ(report.malformed, 7u);
+  KYTIN_CHECK_EQ(failed_lines.size(), 19u);
+  KYTIN_CHECK(!failed_lines.count(1) && !failed_lines.count(8) &&
+              !failed_lines.count(15));
+  KYTIN_CHECK(failed_lines.count(23));
+}
+
+int main() {
+  test_signed_digest();
+  test_single();
+  test_batched();
+  test_stream();
+  return kytin::test::result();
+}
@@ -0,0 +1,302 @@
+/*
+ * Kytin Protocol - kytin_alloc_bench (Heap Allocations per Request)
+ *
+ * Counts global operator new calls made while serving POST /heartbeat and
+ * POST /sign, by driving the Sentinel's own signing pipeline in-process
+ * against a mock TPM: the same arena scope, body buffer and handler as a
+ * request arriving over HTTP, minus the socket. Only the calling thread is
+ * counted, so background threads (health checks, the logger) do not skew
+ * the figures.
+ *
+ * Usage:
+ *   kytin_alloc_bench [--requests N] [--tx-bytes N]
+ *                     [--max-heartbeat N] [--max-sign N]
+ *
+ * Reference figures (mock TPM, 1200-byte tx): before per-request arenas,
+ * 133 allocations per heartbeat and 123 per sign; with them, 21 and 26.
+ * CI can pin the current figures with --max-heartbeat / --max-sign.
+ *
+ * Exit code: 0 on success, 1 if a request failed or a --max-* limit was
+ * exceeded, 2 on usage error.
+ *
+ * State-Locked Protocol™ (Patent Pending)
+ * Copyright (c) 2026 Kytin Protocol
+ */
+
+#include "kytin_pipeline.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <string>
+
+#include <unistd.h>
+
+// ============================================================================
+// ALLOCATION COUNTING
+// ============================================================================
+
+/*
+ * Every replaceable global operator new and delete is replaced, so no form
+ * the library picks (array, nothrow, over-aligned, sized) escapes the count
+ * or pairs a malloc() with the default operator delete.
+ */
+
+namespace {
+
+thread_local bool t_counting = false;
+thread_local uint64_t t_allocations = 0;
+thread_local uint64_t t_bytes = 0;
+
+void *counted_alloc(std::size_t size, std::size_t alignment) noexcept {
+  if (t_counting) {
+    t_allocations++;
+    t_bytes += size;
+  }
+  if (size == 0)
+    size = 1;
+  if (alignment <= alignof(std::max_align_t))
+    return std::malloc(size);
+  // aligned_alloc() wants a multiple of the alignment
+  return std::aligned_alloc(alignment,
+                            (size + alignment - 1) / alignment * alignment);
+}
+
+void *counted_alloc_or_throw(std::size_t size, std::size_t alignment) {
+  if (void *p = counted_alloc(size, alignment))
+    return p;
+  throw std::bad_alloc();
+}
+
+} // namespace
+
+void *operator new(std::size_t size) {
+  return counted_alloc_or_throw(size, alignof(std::max_align_t));
+}
+void *operator new[](std::size_t size) {
+  return counted_alloc_or_throw(size, alignof(std::max_align_t));
+}
+void *operator new(std::size_t size, std::align_val_t al) {
+  return counted_alloc_or_throw(size, static_cast<std::size_t>(al));
+}
+void *operator new[](std::size_t size, std::align_val_t al) {
+  return counted_alloc_or_throw(size, static_cast<std::size_t>(al));
+}
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+  return counted_alloc(size, alignof(std::max_align_t));
+}
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+  return counted_alloc(size, alignof(std::max_align_t));
+}
+void *operator new(std::size_t size, std::align_val_t al,
+                   const std::nothrow_t &) noexcept {
+  return counted_alloc(size, static_cast<std::size_t>(al));
+}
+void *operator new[](std::size_t size, std::align_val_t al,
+                     const std::nothrow_t &) noexcept {
+  return counted_alloc(size, static_cast<std::size_t>(al));
+}
+
+// malloc() and aligned_alloc() memory alike goes back through free()
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept {
+  std::free(p);
+}
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept {
+  std::free(p);
+}
+void operator delete(void *p, const std::nothrow_t &) noexcept {
+  std::free(p);
+}
+void operator delete[](void *p, const std::nothrow_t &) noexcept {
+  std::free(p);
+}
+void operator delete(void *p, std::align_val_t,
+                     const std::nothrow_t &) noexcept {
+  std::free(p);
+}
+void operator delete[](void *p, std::align_val_t,
+                       const std::nothrow_t &) noexcept {
+  std::free(p);
+}
+
+// ============================================================================
+// BENCH
+// ============================================================================
+
+namespace {
+
+constexpr double SIGN_AMOUNT_SOL = 0.0001;
+
+struct Options {
+  uint64_t requests = 1000;
+  size_t tx_bytes = 1200;
+  int64_t max_heartbeat = -1; // -1 = no limit
+  int64_t max_sign = -1;
+};
+
+struct Figures {
+  double allocations = 0.0;   // Per request
+  double bytes = 0.0;
+  uint64_t failures = 0;
+};
+
+void print_usage(const char *argv0) {
+  std::cerr << "Usage: " << argv0
+            << " [--requests N] [--tx-bytes N] [--max-heartbeat N]"
+               " [--max-sign N]\n";
+}
+
+bool parse_args(int argc, char *argv[], Options &options) {
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    if (i + 1 >= argc)
+      return false;
+    const char *value = argv[++i];
+    if (arg == "--requests")
+      options.requests = std::strtoull(value, nullptr, 10);
+    else if (arg == "--tx-bytes")
+      options.tx_bytes = std::strtoull(value, nullptr, 10);
+    else if (arg == "--max-heartbeat")
+      options.max_heartbeat = std::strtoll(value, nullptr, 10);
+    else if (arg == "--max-sign")
+      options.max_sign = std::strtoll(value, nullptr, 10);
+    else
+      return false;
+  }
+  return options.requests > 0;
+}
+
+/**
+ * Serve `payload` to handler `requests` times, as streamed() would: one
+ * arena scope per request, the body buffered and hashed inside it
+ */
+Figures measure(kytin::BodyHandler handler, const std::string &payload,
+                uint64_t requests) {
+  httplib::Request req;
+  req.method = "POST";
+  req.headers.emplace("Content-Type", "application/json");
+  const auto digest = kytin::Sha256::hash(
+      reinterpret_cast<const uint8_t *>(payload.data()), payload.size());
+
+  Figures figures;
+  uint64_t allocations = 0;
+  uint64_t bytes = 0;
+  for (uint64_t i = 0; i < requests; i++) {
+    httplib::Response res;
+    t_allocations = 0;
+    t_bytes = 0;
+    t_counting = true;
+    {
+      kytin::RequestArena::Scope arena;
+      kytin::RequestBody body;
+      body.data.assign(payload.data(), payload.size());
+      body.sha256 = digest;
+      handler(req, res, body);
+    }
+    t_counting = false;
+    allocations += t_allocations;
+    bytes += t_bytes;
+    if (res.status != 200)
+      figures.failures++;
+  }
+  figures.allocations = static_cast<double>(allocations) / requests;
+  figures.bytes = static_cast<double>(bytes) / requests;
+  return figures;
+}
+
+/**
+ * Load a policy whose daily allowances cover the whole run (warm-up
+ * included): the bench counts allocations, it does not exercise the limits
+ */
+bool load_bench_policy(uint64_t requests) {
+  namespace fs = std::filesystem;
+  const fs::path path =
+      fs::temp_directory_path() /
+      ("kytin-alloc-bench-" + std::to_string(getpid()) + ".json");
+  const uint64_t per_endpoint = requests + 1;
+  {
+    std::ofstream out(path);
+    out << nlohmann::json{
+        {"resin",
+         {{"daily_limit",
+           per_endpoint * kytin::get_resin_cost(kytin::HeartbeatMode::TURBO)}}},
+        {"policy", {{"daily_limit_sol", 2 * per_endpoint * SIGN_AMOUNT_SOL}}}};
+  }
+  std::string error;
+  const bool ok = kytin::g_core.load_policy(path.string(), &error);
+  fs::remove(path);
+  if (!ok)
+    std::cerr << "kytin_alloc_bench: " << error << "\n";
+  return ok;
+}
+
+bool report(const char *name, const Figures &figures, int64_t max) {
+  std::printf("%-10s %8.1f allocations/request %10.0f bytes/request\n", name,
+              figures.allocations, figures.bytes);
+  bool ok = true;
+  if (figures.failures) {
+    std::fprintf(stderr, "%s: %llu request(s) failed\n", name,
+                 static_cast<unsigned long long>(figures.failures));
+    ok = false;
+  }
+  if (max >= 0 && figures.allocations > static_cast<double>(max)) {
+    std::fprintf(stderr, "%s: %.1f allocations/request exceeds %lld\n", name,
+                 figures.allocations, static_cast<long long>(max));
+    ok = false;
+  }
+  return ok;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  Options options;
+  if (!parse_args(argc, argv, options)) {
+    print_usage(argv[0]);
+    return 2;
+  }
+
+  // Per-request log records would be counted as request allocations
+  kytin::set_log_level(kytin::LogLevel::WARN);
+  if (!load_bench_policy(options.requests))
+    return 1;
+  if (!kytin::g_core.initialize(false) ||
+      !kytin::g_core.tpm().is_mock_mode()) {
+    std::cerr << "kytin_alloc_bench needs the mock TPM\n";
+    return 1;
+  }
+  kytin::g_core.credit_resin(
+      (options.requests + 1) *
+      kytin::get_resin_cost(kytin::HeartbeatMode::TURBO));
+
+  // One warm-up request each, so one-time setup (thread arenas, lazily
+  // built replies) is not counted
+  const std::string heartbeat = R"({"mode":"TURBO"})";
+  const std::string sign =
+      nlohmann::json{{"tx", std::string(options.tx_bytes, 'A')},
+                     {"amount", SIGN_AMOUNT_SOL}}
+          .dump();
+  measure(kytin::handle_heartbeat, heartbeat, 1);
+  measure(kytin::handle_sign, sign, 1);
+
+  bool ok = report("heartbeat",
+                   measure(kytin::handle_heartbeat, heartbeat,
+                           options.requests),
+                   options.max_heartbeat);
+  ok &= report("sign", measure(kytin::handle_sign, sign, options.requests),
+               options.max_sign);
+
+  kytin::g_core.shutdown();
+  return ok ? 0 : 1;
+}
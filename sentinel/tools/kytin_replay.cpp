@@ -0,0 +1,350 @@
+/*
+ * Kytin Protocol - kytin_replay (Captured Traffic Replay)
+ *
+ * Replays a trace recorded with `kytin_sentinel --capture FILE` against a
+ * (mock-mode) Sentinel and reports per-endpoint latency against the
+ * latencies recorded in the trace and, optionally, a previous report.
+ *
+ * Usage:
+ *   kytin_replay [--host HOST] [--port PORT] [--speed N | --max]
+ *                [--connections N] [--include-migrate]
+ *                [--report OUT.json] [--baseline OLD.json]
+ *                [--fail-over PCT] TRACE
+ *
+ * Typical regression check between two builds:
+ *   kytin_replay --max --report old.json trace.kyt    # against build A
+ *   kytin_replay --max --baseline old.json trace.kyt  # against build B
+ *
+ * Captured latencies were measured inside the capturing Sentinel, replayed
+ * ones at the client, so on loopback the replay column reads slightly higher
+ * even for identical builds; compare builds with --baseline.
+ *
+ * Exit code: 0 on success, 1 if --fail-over is exceeded or requests failed,
+ * 2 on usage error.
+ *
+ * State-Locked Protocol™ (Patent Pending)
+ * Copyright (c) 2026 Kytin Protocol
+ */
+
+#include "kytin_capture.hpp"
+
+#include <httplib.h>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+using json = nlohmann::json;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct Options {
+  std::string host = "127.0.0.1";
+  int port = 18789;
+  double speed = 1.0; // 0 = as fast as possible
+  unsigned connections = 4;
+  bool include_migrate = false;
+  std::string report_path;
+  std::string baseline_path;
+  double fail_over_pct = -1.0;
+};
+
+struct Outcome {
+  bool sent = false;
+  uint32_t status = 0;   // 0 = no response
+  uint64_t latency_us = 0;
+  uint64_t lag_us = 0;   // How late the request left vs its schedule
+};
+
+struct EndpointStats {
+  std::vector<uint64_t> replay_us;
+  std::vector<uint64_t> captured_us;
+  uint64_t failures = 0;
+  uint64_t status_mismatches = 0;
+};
+
+void print_usage(const char *argv0) {
+  std::cerr
+      << "Usage: " << argv0
+      << " [--host HOST] [--port PORT] [--speed N | --max] [--connections N]\n"
+      << "       [--include-migrate] [--report OUT.json] [--baseline OLD.json]\n"
+      << "       [--fail-over PCT] TRACE\n"
+      << "  --speed N          Replay N times faster than captured (default 1)\n"
+      << "  --max              Ignore captured timing; send as fast as possible\n"
+      << "  --connections N    Parallel keep-alive connections (default 4)\n"
+      << "  --include-migrate  Also replay POST /migrate (kills the Sentinel)\n"
+      << "  --report FILE      Write the per-endpoint report as JSON\n"
+      << "  --baseline FILE    Compare against a previous --report\n"
+      << "  --fail-over PCT    Exit 1 if any p99 regresses more than PCT "
+         "percent vs the baseline\n";
+}
+
+/**
+ * Endpoint key used for grouping: method + path without the query string
+ */
+std::string endpoint_of(const kytin::TraceRecord &rec) {
+  return std::string(kytin::trace_method_name(rec.method)) + " " +
+         rec.target.substr(0, rec.target.find('?'));
+}
+
+double percentile_ms(std::vector<uint64_t> &samples, double p) {
+  if (samples.empty())
+    return 0.0;
+  std::sort(samples.begin(), samples.end());
+  size_t rank = static_cast<size_t>(p / 100.0 * (samples.size() - 1) + 0.5);
+  return samples[std::min(rank, samples.size() - 1)] / 1000.0;
+}
+
+bool skip_record(const kytin::TraceRecord &rec, const Options &options) {
+  if (rec.target.rfind("/admin/", 0) == 0)
+    return true; // Reloads would change the policy under the replay
+  if (!options.include_migrate && rec.target.rfind("/migrate", 0) == 0)
+    return true;
+  return rec.method == kytin::TraceMethod::OTHER;
+}
+
+/**
+ * Send every record at offset / speed after start, spread over N workers
+ */
+std::vector<Outcome> replay(const std::vector<kytin::TraceRecord> &records,
+                            const Options &options) {
+  std::vector<Outcome> outcomes(records.size());
+  std::atomic<size_t> next{0};
+  const auto start = Clock::now();
+
+  auto worker = [&]() {
+    httplib::Client client(options.host, options.port);
+    client.set_keep_alive(true);
+    client.set_connection_timeout(5);
+    client.set_read_timeout(30);
+
+    for (size_t i; (i = next.fetch_add(1)) < records.size();) {
+      const auto &rec = records[i];
+      auto due = start;
+      if (options.speed > 0.0) {
+        due += std::chrono::microseconds(
+            static_cast<uint64_t>(rec.offset_us / options.speed));
+        std::this_thread::sleep_until(due);
+      }
+
+      auto sent = Clock::now();
+      httplib::Result result =
+          rec.method == kytin::TraceMethod::POST
+              ? client.Post(rec.target, rec.body, "application/json")
+              : client.Get(rec.target);
+      auto done = Clock::now();
+
+      auto &out = outcomes[i];
+      out.sent = true;
+      out.status = result ? static_cast<uint32_t>(result->status) : 0;
+      out.latency_us =
+          std::chrono::duration_cast<std::chrono::microseconds>(done - sent)
+              .count();
+      if (options.speed > 0.0 && sent > due) {
+        out.lag_us =
+            std::chrono::duration_cast<std::chrono::microseconds>(sent - due)
+                .count();
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (unsigned t = 0; t < std::max(1u, options.connections); t++)
+    threads.emplace_back(worker);
+  for (auto &t : threads)
+    t.join();
+  return outcomes;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  Options options;
+  std::string trace_path;
+
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    bool has_value = i + 1 < argc;
+
+    if (std::strcmp(arg, "--host") == 0 && has_value) {
+      options.host = argv[++i];
+    } else if (std::strcmp(arg, "--port") == 0 && has_value) {
+      options.port = std::atoi(argv[++i]);
+    } else if (std::strcmp(arg, "--speed") == 0 && has_value) {
+      options.speed = std::atof(argv[++i]);
+      if (options.speed <= 0.0) {
+        std::cerr << "[KYTIN-REPLAY] --speed must be > 0 (use --max)"
+                  << std::endl;
+        return 2;
+      }
+    } else if (std::strcmp(arg, "--max") == 0) {
+      options.speed = 0.0;
+    } else if (std::strcmp(arg, "--connections") == 0 && has_value) {
+      options.connections = static_cast<unsigned>(std::atoi(argv[++i]));
+    } else if (std::strcmp(arg, "--include-migrate") == 0) {
+      options.include_migrate = true;
+    } else if (std::strcmp(arg, "--report") == 0 && has_value) {
+      options.report_path = argv[++i];
+    } else if (std::strcmp(arg, "--baseline") == 0 && has_value) {
+      options.baseline_path = argv[++i];
+    } else if (std::strcmp(arg, "--fail-over") == 0 && has_value) {
+      options.fail_over_pct = std::atof(argv[++i]);
+    } else if (std::strcmp(arg, "--help") == 0 || arg[0] == '-') {
+      print_usage(argv[0]);
+      return 2;
+    } else {
+      trace_path = arg;
+    }
+  }
+  if (trace_path.empty()) {
+    print_usage(argv[0]);
+    return 2;
+  }
+
+  // Load the trace
+  kytin::TraceReader reader;
+  std::string error;
+  if (!reader.open(trace_path, &error)) {
+    std::cerr << "[KYTIN-REPLAY] " << error << std::endl;
+    return 2;
+  }
+  std::vector<kytin::TraceRecord> records;
+  uint64_t skipped = 0;
+  for (kytin::TraceRecord rec; reader.next(rec);) {
+    if (skip_record(rec, options))
+      skipped++;
+    else
+      records.push_back(std::move(rec));
+  }
+  if (!reader.error().empty()) {
+    std::cerr << "[KYTIN-REPLAY] WARNING: " << trace_path << ": "
+              << reader.error() << "; replaying the " << records.size()
+              << " complete records" << std::endl;
+  }
+  std::stable_sort(records.begin(), records.end(),
+                   [](const auto &a, const auto &b) {
+                     return a.offset_us < b.offset_us;
+                   });
+
+  json baseline;
+  if (!options.baseline_path.empty()) {
+    std::ifstream in(options.baseline_path);
+    try {
+      baseline = json::parse(in);
+    } catch (const json::exception &e) {
+      std::cerr << "[KYTIN-REPLAY] " << options.baseline_path << ": "
+                << e.what() << std::endl;
+      return 2;
+    }
+  }
+
+  std::cerr << "[KYTIN-REPLAY] Replaying " << records.size() << " requests ("
+            << skipped << " skipped) against " << options.host << ":"
+            << options.port << " at "
+            << (options.speed > 0.0 ? std::to_string(options.speed) + "x"
+                                    : std::string("max speed"))
+            << " over " << options.connections << " connections" << std::endl;
+
+  auto started = Clock::now();
+  auto outcomes = replay(records, options);
+  double wall_s =
+      std::chrono::duration<double>(Clock::now() - started).count();
+
+  // Aggregate per endpoint
+  std::map<std::string, EndpointStats> stats;
+  uint64_t failures = 0, max_lag_us = 0;
+  for (size_t i = 0; i < records.size(); i++) {
+    auto &s = stats[endpoint_of(records[i])];
+    const auto &out = outcomes[i];
+    max_lag_us = std::max(max_lag_us, out.lag_us);
+    if (out.status == 0) {
+      s.failures++;
+      failures++;
+      continue;
+    }
+    s.replay_us.push_back(out.latency_us);
+    s.captured_us.push_back(records[i].latency_us);
+    if (out.status != records[i].status)
+      s.status_mismatches++;
+  }
+
+  json report = {{"trace", trace_path},
+                 {"requests", records.size()},
+                 {"failures", failures},
+                 {"wall_seconds", wall_s},
+                 {"throughput_rps", wall_s > 0 ? records.size() / wall_s : 0.0},
+                 {"max_schedule_lag_ms", max_lag_us / 1000.0},
+                 {"endpoints", json::object()}};
+
+  std::printf("%-18s %7s %6s %9s %9s %9s %9s %10s\n", "endpoint", "count",
+              "errors", "p50 ms", "p99 ms", "cap p50", "cap p99", "p99 delta");
+
+  bool regressed = false;
+  for (auto &[name, s] : stats) {
+    double p50 = percentile_ms(s.replay_us, 50);
+    double p99 = percentile_ms(s.replay_us, 99);
+    double max = percentile_ms(s.replay_us, 100);
+    double cap_p50 = percentile_ms(s.captured_us, 50);
+    double cap_p99 = percentile_ms(s.captured_us, 99);
+
+    // Compare against the previous build's report if given, else the trace
+    double ref_p99 = cap_p99;
+    const char *ref = "";
+    if (baseline.contains("endpoints") && baseline["endpoints"].contains(name)) {
+      ref_p99 = baseline["endpoints"][name].value("p99_ms", cap_p99);
+      ref = " (vs baseline)";
+    }
+    double delta_pct = ref_p99 > 0 ? (p99 - ref_p99) / ref_p99 * 100.0 : 0.0;
+    if (options.fail_over_pct >= 0 && *ref && delta_pct > options.fail_over_pct)
+      regressed = true;
+
+    std::printf("%-18s %7zu %6llu %9.3f %9.3f %9.3f %9.3f %+9.1f%%%s\n",
+                name.c_str(), s.replay_us.size() + s.failures,
+                static_cast<unsigned long long>(s.failures), p50, p99, cap_p50,
+                cap_p99, delta_pct, ref);
+
+    report["endpoints"][name] = {{"count", s.replay_us.size() + s.failures},
+                                 {"failures", s.failures},
+                                 {"status_mismatches", s.status_mismatches},
+                                 {"p50_ms", p50},
+                                 {"p99_ms", p99},
+                                 {"max_ms", max},
+                                 {"captured_p50_ms", cap_p50},
+                                 {"captured_p99_ms", cap_p99},
+                                 {"p99_delta_pct", delta_pct}};
+  }
+
+  std::printf("\n%zu requests in %.2f s (%.0f req/s), max schedule lag %.1f "
+              "ms, %llu failed\n",
+              records.size(), wall_s,
+              wall_s > 0 ? records.size() / wall_s : 0.0, max_lag_us / 1000.0,
+              static_cast<unsigned long long>(failures));
+
+  if (!options.report_path.empty()) {
+    std::ofstream out(options.report_path);
+    out << report.dump(2) << "\n";
+    if (!out) {
+      std::cerr << "[KYTIN-REPLAY] Cannot write " << options.report_path
+                << std::endl;
+      return 2;
+    }
+  }
+
+  if (regressed) {
+    std::cerr << "[KYTIN-REPLAY] p99 regression above " << options.fail_over_pct
+              << "% vs baseline" << std::endl;
+    return 1;
+  }
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,159 @@
+/*
+ * Kytin Protocol - kytin_status (Shared-Memory Status Reader)
+ *
+ * Prints the Sentinel's status page without touching its HTTP port.
+ *
+ * Usage:
+ *   kytin_status [--name /kytin-status] [--json] [--watch MS]
+ *
+ * Exit code: 0 if a running Sentinel published the page, 1 if the page is
+ * missing or its writer has exited, 2 on usage error.
+ *
+ * State-Locked Protocol™ (Patent Pending)
+ * Copyright (c) 2026 Kytin Protocol
+ */
+
+#include "kytin_status_page.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+
+using kytin::StatusSnapshot;
+
+static void print_usage(const char *argv0) {
+  std::cerr << "Usage: " << argv0 << " [--name NAME] [--json] [--watch MS]\n"
+            << "  --name NAME   Status page (default: /kytin-status)\n"
+            << "  --json        One JSON object per snapshot\n"
+            << "  --watch MS    Print again every MS milliseconds\n";
+}
+
+/**
+ * Escape the fixed-size text fields (hardware strings) for JSON output
+ */
+static std::string json_string(const char *text, size_t size) {
+  std::string out = "\"";
+  for (size_t i = 0; i < size && text[i]; i++) {
+    char c = text[i];
+    if (c == '"' || c == '\\') {
+      out += '\\';
+      out += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char escaped[8];
+      std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+      out += escaped;
+    } else {
+      out += c;
+    }
+  }
+  return out + "\"";
+}
+
+static void print_json(const StatusSnapshot &s) {
+  const std::string hardware_id =
+      json_string(s.hardware_id, sizeof(s.hardware_id));
+  const std::string manufacturer =
+      json_string(s.manufacturer, sizeof(s.manufacturer));
+  const std::string firmware =
+      json_string(s.firmware_version, sizeof(s.firmware_version));
+  std::printf(
+      "{\"pid\":%llu,\"updated_unix_ms\":%llu,\"ready\":%s,\"dead\":%s,"
+      "\"closed\":%s,\"tpm\":{\"available\":%s,\"mock_mode\":%s,"
+      "\"hardware_id\":%s,\"manufacturer\":%s,\"firmware\":%s},"
+      "\"resin\":{\"balance\":%llu,\"lifetime_burned\":%llu,"
+      "\"daily_limit\":%llu,\"daily_consumed\":%llu},"
+      "\"policy\":{\"daily_limit_sol\":%.9g,\"daily_spent_sol\":%.9g,"
+      "\"generation\":%llu},\"heartbeats\":%llu,\"signs\":%llu,"
+      "\"last_event_id\":%llu}\n",
+      (unsigned long long)s.pid, (unsigned long long)s.updated_unix_ms,
+      s.has(StatusSnapshot::STATUS_READY) ? "true" : "false",
+      s.has(StatusSnapshot::STATUS_DEAD) ? "true" : "false",
+      s.has(StatusSnapshot::STATUS_CLOSED) ? "true" : "false",
+      s.has(StatusSnapshot::STATUS_TPM_AVAILABLE) ? "true" : "false",
+      s.has(StatusSnapshot::STATUS_TPM_MOCK) ? "true" : "false",
+      hardware_id.c_str(), manufacturer.c_str(), firmware.c_str(),
+      (unsigned long long)s.resin_balance,
+      (unsigned long long)s.resin_lifetime_burned,
+      (unsigned long long)s.resin_daily_limit,
+      (unsigned long long)s.resin_daily_consumed, s.daily_limit_sol,
+      s.daily_spent_sol, (unsigned long long)s.policy_generation,
+      (unsigned long long)s.heartbeats, (unsigned long long)s.signs,
+      (unsigned long long)s.last_event_id);
+}
+
+static void print_text(const StatusSnapshot &s) {
+  const char *state = "initializing";
+  if (s.has(StatusSnapshot::STATUS_CLOSED))
+    state = "exited";
+  else if (s.has(StatusSnapshot::STATUS_DEAD))
+    state = "dead (soul transferred)";
+  else if (s.has(StatusSnapshot::STATUS_READY))
+    state = "ready";
+  std::printf("Sentinel pid %llu: %s\n", (unsigned long long)s.pid, state);
+  std::printf("  TPM       %s%s, %s\n",
+              s.has(StatusSnapshot::STATUS_TPM_AVAILABLE) ? "available"
+                                                          : "unavailable",
+              s.has(StatusSnapshot::STATUS_TPM_MOCK) ? " (MOCK)" : "",
+              s.hardware_id);
+  std::printf("  Resin     %llu (daily %llu / %llu, burned %llu)\n",
+              (unsigned long long)s.resin_balance,
+              (unsigned long long)s.resin_daily_consumed,
+              (unsigned long long)s.resin_daily_limit,
+              (unsigned long long)s.resin_lifetime_burned);
+  std::printf("  Spend     %.4f / %.4f SOL today (policy generation %llu)\n",
+              s.daily_spent_sol, s.daily_limit_sol,
+              (unsigned long long)s.policy_generation);
+  std::printf("  Signed    %llu heartbeats, %llu transactions (event %llu)\n",
+              (unsigned long long)s.heartbeats, (unsigned long long)s.signs,
+              (unsigned long long)s.last_event_id);
+}
+
+int main(int argc, char *argv[]) {
+  std::string name = kytin::StatusPageOptions{}.name;
+  bool as_json = false;
+  long watch_ms = 0;
+
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    bool has_value = i + 1 < argc;
+
+    if (std::strcmp(arg, "--name") == 0 && has_value) {
+      name = argv[++i];
+    } else if (std::strcmp(arg, "--json") == 0) {
+      as_json = true;
+    } else if (std::strcmp(arg, "--watch") == 0 && has_value) {
+      watch_ms = std::atol(argv[++i]);
+      if (watch_ms <= 0) {
+        print_usage(argv[0]);
+        return 2;
+      }
+    } else {
+      print_usage(argv[0]);
+      return 2;
+    }
+  }
+
+  kytin::StatusReader reader(name);
+  for (;;) {
+    std::string error;
+    auto snapshot = reader.read(&error);
+    if (!snapshot) {
+      std::cerr << "[KYTIN-STATUS] " << error << std::endl;
+      if (!watch_ms)
+        return 1;
+    } else if (as_json) {
+      print_json(*snapshot);
+    } else {
+      print_text(*snapshot);
+    }
+    std::fflush(stdout);
+
+    if (!watch_ms)
+      return snapshot->has(StatusSnapshot::STATUS_CLOSED) ? 1 : 0;
+    std::this_thread::sleep_for(std::chrono::milliseconds(watch_ms));
+  }
+}
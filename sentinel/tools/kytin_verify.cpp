@@ -0,0 +1,96 @@
+/*
+ * Kytin Protocol - kytin_verify (Offline Signature Audit CLI)
+ *
+ * Verifies archived Sentinel signatures from a JSONL file (or stdin).
+ *
+ * Usage:
+ *   kytin_verify [--pubkey HEX] [--threads N] [--batch N] [--quiet] [FILE|-]
+ *
+ * Each failing record is printed as "<line>\t<STATUS>\t<reason>".
+ * Exit code: 0 if every record is valid, 1 if any is not, 2 on usage error.
+ *
+ * State-Locked Protocol™ (Patent Pending)
+ * Copyright (c) 2026 Kytin Protocol
+ */
+
+#include "kytin_verify.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+static void print_usage(const char *argv0) {
+  std::cerr << "Usage: " << argv0
+            << " [--pubkey HEX] [--threads N] [--batch N] [--quiet] [FILE|-]\n"
+            << "  --pubkey HEX  Public key for records without \"public_key\"\n"
+            << "  --threads N   Worker threads (default: all cores)\n"
+            << "  --batch N     Records per batch (default: 1024)\n"
+            << "  --quiet       Only print the summary\n";
+}
+
+int main(int argc, char *argv[]) {
+  kytin::VerifyStreamOptions options;
+  std::string input = "-";
+  bool quiet = false;
+
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    bool has_value = i + 1 < argc;
+
+    if (std::strcmp(arg, "--pubkey") == 0 && has_value) {
+      options.default_public_key = kytin::hex_decode(argv[++i]);
+      if (options.default_public_key.empty()) {
+        std::cerr << "[KYTIN-VERIFY] --pubkey is not valid hex" << std::endl;
+        return 2;
+      }
+    } else if (std::strcmp(arg, "--threads") == 0 && has_value) {
+      options.threads = static_cast<unsigned>(std::atoi(argv[++i]));
+    } else if (std::strcmp(arg, "--batch") == 0 && has_value) {
+      options.batch_size = static_cast<size_t>(std::atol(argv[++i]));
+    } else if (std::strcmp(arg, "--quiet") == 0) {
+      quiet = true;
+    } else if (std::strcmp(arg, "--help") == 0 ||
+               (arg[0] == '-' && arg[1])) {
+      print_usage(argv[0]);
+      return 2;
+    } else {
+      input = arg;
+    }
+  }
+
+  std::ifstream file;
+  if (input != "-") {
+    file.open(input);
+    if (!file) {
+      std::cerr << "[KYTIN-VERIFY] Cannot open " << input << std::endl;
+      return 2;
+    }
+  }
+  std::istream &in = input == "-" ? std::cin : file;
+
+  auto report = kytin::verify_stream(
+      in, options,
+      [quiet](uint64_t line_no, kytin::VerifyStatus status,
+              const std::string &reason) {
+        if (!quiet) {
+          std::cout << line_no << '\t' << kytin::verify_status_name(status)
+                    << '\t' << reason << '\n';
+        }
+      });
+  std::cout.flush();
+
+  double rate = report.elapsed_seconds > 0.0
+                    ? report.total / report.elapsed_seconds
+                    : 0.0;
+
+  std::cerr << "[KYTIN-VERIFY] " << report.total << " records: "
+            << report.valid << " valid, " << report.invalid << " invalid, "
+            << report.malformed << " malformed" << std::endl;
+  std::cerr << "[KYTIN-VERIFY] " << report.elapsed_seconds << " s ("
+            << static_cast<uint64_t>(rate * 60.0) << " records/min)"
+            << std::endl;
+
+  return report.valid == report.total ? 0 : 1;
+}